@@ -0,0 +1,25 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QString>
+#include <QTextStream>
+#include <atomic>
+#include <functional>
+
+// Minimal harness for the opt-in modular_dashboard_bench tool (-DMODULAR_DASHBOARD_BENCH=ON).
+// Global operator new is counted (calls and requested bytes) so benches can report allocations per operation.
+namespace Bench {
+    std::atomic<quint64>& allocations();
+    std::atomic<quint64>& allocatedBytes();
+    QTextStream& out();
+    struct Result { qint64 ns = 0; quint64 allocs = 0, bytes = 0; };
+    inline Result measure(const std::function<void()>& fn) {
+        const quint64 a0 = allocations().load(), b0 = allocatedBytes().load(); QElapsedTimer t; t.start(); fn();
+        return { t.nsecsElapsed(), allocations().load() - a0, allocatedBytes().load() - b0 };
+    }
+    // Correctness checks inside a bench: prints "MISMATCH: what" when !ok and makes the process exit non-zero
+    bool check(bool ok, const QString& what);
+    using Entry = void(*)();
+    bool registerBench(const char* name, Entry fn);
+}
+
+#define BENCH_REGISTER(name, fn) static const bool bench_registered_##fn = Bench::registerBench(name, fn)
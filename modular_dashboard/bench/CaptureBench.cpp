@@ -0,0 +1,44 @@
+#include "Bench.h"
+#include "FrameCapture.h"
+#include "MarketDataParser.h"
+#include <QTemporaryDir>
+#include <QVector>
+
+namespace {
+
+// Capture write/read round trip, then the replay-side parse cost per frame.
+// Uses the capture named by $MD_CAPTURE when set (a recorded session), otherwise a synthetic Binance trade capture.
+void runCapture() {
+    QTemporaryDir tmp; QString path = qEnvironmentVariable("MD_CAPTURE");
+    const bool synthetic = path.isEmpty();
+    if (synthetic) {
+        QVector<CapturedFrame> pool;
+        for (int s=0; s<64; ++s) {
+            CapturedFrame f; f.provider = DataProvider::Binance; f.mode = StreamMode::Trade;
+            f.payload = QString(R"({"stream":"sym%1usdt@trade","data":{"e":"trade","E":1728000000123,"s":"SYM%1USDT","t":%2,"p":"%3","q":"0.0150","T":1728000000120,"m":true,"M":true}})")
+                            .arg(s).arg(1000 + s).arg(100.0 + s * 1.25, 0, 'f', 4).toUtf8();
+            pool << f;
+        }
+        path = tmp.filePath("synthetic.mdcap");
+        const int n = 400000; FrameRecorder rec(path);
+        const Bench::Result w = Bench::measure([&]{ for (int i=0; i<n; ++i) { CapturedFrame& f = pool[i & 63]; f.recvMs = 1728000000000 + i / 10; f.recvNs = qint64(i) * 100000; rec.append(f); } rec.flush(); });
+        Bench::out() << QString("write  %1 frames/s  %2 allocs/frame").arg(n * 1e9 / double(qMax<qint64>(1, w.ns)), 12, 'f', 0).arg(double(w.allocs) / n, 6, 'f', 2) << Qt::endl;
+    }
+    QVector<CapturedFrame> frames; qint64 bytes = 0;
+    const Bench::Result r = Bench::measure([&]{ FrameReader rd(path); CapturedFrame f; while (rd.next(f)) { bytes += f.payload.size(); frames << f; } });
+    if (frames.isEmpty()) { Bench::out() << "no frames in " << path << Qt::endl; return; }
+    Bench::out() << QString("read   %1 frames/s  %2 MB/s  (%3 frames)").arg(frames.size() * 1e9 / double(qMax<qint64>(1, r.ns)), 12, 'f', 0)
+                    .arg(bytes * 1e3 / double(qMax<qint64>(1, r.ns)), 8, 'f', 1).arg(frames.size()) << Qt::endl;
+    bool monotonic = true; for (int i=1; i<frames.size(); ++i) monotonic &= frames[i].recvNs >= frames[i-1].recvNs;
+    if (!monotonic) Bench::out() << "WARNING: receive timestamps go backwards" << Qt::endl;
+    const double spanS = (frames.last().recvNs - frames.first().recvNs) / 1e9;
+    int ticks = 0; volatile double sink = 0.0;
+    const Bench::Result p = Bench::measure([&]{ MarketTick t; for (const CapturedFrame& f : frames) { const QString text = QString::fromUtf8(f.payload); if (MarketDataParser::scan(QStringView(text), f.provider, f.mode, t) == MarketDataParser::Result::Tick) { ++ticks; sink = sink + t.price; } } });
+    Bench::out() << QString("replay %1 frames/s  %2 ns/frame  %3 ticks  (recorded span %4 s => max speed %5x)")
+                    .arg(frames.size() * 1e9 / double(qMax<qint64>(1, p.ns)), 12, 'f', 0).arg(double(p.ns) / frames.size(), 8, 'f', 1).arg(ticks)
+                    .arg(spanS, 0, 'f', 1).arg(spanS > 0 ? spanS * 1e9 / double(qMax<qint64>(1, p.ns)) : 0.0, 0, 'f', 0) << Qt::endl;
+}
+
+} // namespace
+
+BENCH_REGISTER("capture", runCapture);
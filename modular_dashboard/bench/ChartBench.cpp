@@ -0,0 +1,133 @@
+#include "Bench.h"
+#include "Decimator.h"
+#include "IndicatorEngine.h"
+#include "LinePlot.h"
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+#include <QString>
+#include <QtCharts/QChartView>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Chart view of one widget: the previous QtCharts path (QChartView + 7 QLineSeries + 4 QValueAxis, every update rebuilding
+// QVector<QPointF> for price/RSI/MACD/signal/BB, replace(), axis ranges, grid pens and visibility) against LinePlot.
+// Series = 800 processed samples (the default maxPoints) scrolling by one sample per tick, indicators from IndicatorEngine.
+// "build" = allocations to construct the view plus its first full update; "held" for LinePlot = its buffers after paint
+// (QtCharts keeps its scene items, series point lists and axis labels, not counted separately here).
+// Frames are rendered into a 480x320 ARGB32 image, one tick applied between frames (not timed).
+constexpr int kPoints = 800, kTicks = 5000, kFrames = 300, kW = 480, kH = 320;
+
+struct QtChartsView {
+    QChart* chart = new QChart(); QChartView view{chart};
+    QLineSeries *price = new QLineSeries(chart), *rsi = new QLineSeries(chart), *macd = new QLineSeries(chart), *signal = new QLineSeries(chart);
+    QLineSeries *bbUp = new QLineSeries(chart), *bbLo = new QLineSeries(chart), *ratio = new QLineSeries(chart);
+    QValueAxis *ax = new QValueAxis(chart), *ay = new QValueAxis(chart), *arsi = new QValueAxis(chart), *amacd = new QValueAxis(chart);
+    QtChartsView() {
+        chart->legend()->hide();
+        for (QLineSeries* s : {price, ratio, rsi, macd, signal, bbUp, bbLo}) chart->addSeries(s);
+        chart->addAxis(ax, Qt::AlignBottom); chart->addAxis(ay, Qt::AlignLeft); chart->addAxis(arsi, Qt::AlignRight); chart->addAxis(amacd, Qt::AlignRight);
+        for (QLineSeries* s : {price, ratio, bbUp, bbLo}) { s->attachAxis(ax); s->attachAxis(ay); }
+        rsi->attachAxis(ax); rsi->attachAxis(arsi); macd->attachAxis(ax); macd->attachAxis(amacd); signal->attachAxis(ax); signal->attachAxis(amacd);
+        ratio->setVisible(false); view.setRenderHint(QPainter::Antialiasing); view.resize(kW, kH);
+    }
+    static void fill(QLineSeries* s, const std::vector<double>& v) {
+        QVector<QPointF> pts; pts.reserve(int(v.size())); for (int i=0; i<int(v.size()); ++i) pts.append(QPointF(i, v[size_t(i)])); s->replace(pts);
+    }
+    void update(const std::vector<double>& v, const IndicatorEngine& ind) {
+        fill(price, v);
+        const auto mm = std::minmax_element(v.begin(), v.end()); ax->setRange(0, int(v.size()) - 1); ay->setRange(*mm.first, *mm.second);
+        chart->setTitle("BTC | 5m"); QPen grid(QColor(60,60,60)); grid.setStyle(Qt::DotLine);
+        for (QValueAxis* a : {ax, ay, arsi, amacd}) { a->setGridLineVisible(true); a->setGridLinePen(grid); }
+        fill(rsi, ind.rsi()); arsi->setRange(0, 100);
+        fill(macd, ind.macd()); fill(signal, ind.signal());
+        const auto m1 = std::minmax_element(ind.macd().begin(), ind.macd().end()), m2 = std::minmax_element(ind.signal().begin(), ind.signal().end());
+        amacd->setRange(std::min(*m1.first, *m2.first), std::max(*m1.second, *m2.second));
+        fill(bbUp, ind.bbUpper()); fill(bbLo, ind.bbLower());
+    }
+};
+
+void updatePlot(LinePlot& plot, const std::vector<double>& v, const IndicatorEngine& ind) {
+    plot.setTrace(LinePlot::Price, v); plot.setTitle("BTC | 5m");
+    plot.setStyle({QColor(40,44,52), QColor(60,60,60), Qt::white, QColor(32,159,223), true, false});
+    plot.setTrace(LinePlot::Rsi, ind.rsi()); plot.setTrace(LinePlot::Macd, ind.macd()); plot.setTrace(LinePlot::Signal, ind.signal());
+    plot.setTrace(LinePlot::BbUpper, ind.bbUpper()); plot.setTrace(LinePlot::BbLower, ind.bbLower());
+}
+
+void runChart() {
+    std::mt19937_64 rng(24); std::normal_distribution<double> step(0.0, 0.02);
+    std::vector<double> ts, all; double p = 100.0;
+    for (int i=0; i<kPoints + kTicks + kFrames; ++i) { p += step(rng); ts.push_back(1728000000.0 + i); all.push_back(p); }
+    auto windowAt = [&](int tick, std::vector<double>& wts, std::vector<double>& wv) {
+        wts.assign(ts.begin() + tick, ts.begin() + tick + kPoints); wv.assign(all.begin() + tick, all.begin() + tick + kPoints);
+    };
+    std::vector<double> wts, wv; IndicatorEngine ind; windowAt(0, wts, wv); ind.sync(wts, wv);
+
+    std::unique_ptr<QtChartsView> qc; LinePlot plot;
+    const Bench::Result bq = Bench::measure([&]{ qc = std::make_unique<QtChartsView>(); qc->update(wv, ind); });
+    const Bench::Result bp = Bench::measure([&]{ updatePlot(plot, wv, ind); });
+    QImage img(kW, kH, QImage::Format_ARGB32_Premultiplied);
+    { QPainter pt(&img); pt.setRenderHint(QPainter::Antialiasing); plot.paint(pt, img.rect()); }
+    Bench::out() << QString("qtcharts build  %1 allocs  %2 KiB").arg(bq.allocs).arg(bq.bytes / 1024.0, 0, 'f', 1) << Qt::endl;
+    Bench::out() << QString("lineplot build  %1 allocs  %2 KiB  held %3 KiB").arg(bp.allocs).arg(bp.bytes / 1024.0, 0, 'f', 1)
+                    .arg(plot.memoryBytes() / 1024.0, 0, 'f', 1) << Qt::endl;
+
+    // Per-tick update cost (window scrolls by one sample, indicators stepped outside the timing)
+    qint64 nsQ = 0, nsP = 0; quint64 alQ = 0, alP = 0;
+    for (int t=1; t<=kTicks; ++t) {
+        windowAt(t, wts, wv); ind.sync(wts, wv);
+        const Bench::Result a = Bench::measure([&]{ qc->update(wv, ind); }); nsQ += a.ns; alQ += a.allocs;
+        const Bench::Result b = Bench::measure([&]{ updatePlot(plot, wv, ind); }); nsP += b.ns; alP += b.allocs;
+    }
+    Bench::out() << QString("qtcharts update %1 us/tick  %2 allocs/tick").arg(nsQ / 1e3 / kTicks, 8, 'f', 2).arg(double(alQ) / kTicks, 7, 'f', 1) << Qt::endl;
+    Bench::out() << QString("lineplot update %1 us/tick  %2 allocs/tick").arg(nsP / 1e3 / kTicks, 8, 'f', 2).arg(double(alP) / kTicks, 7, 'f', 1) << Qt::endl;
+
+    // Frame cost: a tick, then render each path into the image
+    qc->view.show(); QApplication::processEvents();
+    qint64 fq = 0, fp = 0;
+    for (int f=0; f<kFrames; ++f) {
+        windowAt(kTicks + 1 + f, wts, wv); ind.sync(wts, wv); qc->update(wv, ind); updatePlot(plot, wv, ind);
+        QApplication::processEvents();
+        fq += Bench::measure([&]{ QPainter pt(&img); pt.setRenderHint(QPainter::Antialiasing); qc->view.render(&pt); }).ns;
+        fp += Bench::measure([&]{ QPainter pt(&img); pt.setRenderHint(QPainter::Antialiasing); plot.paint(pt, img.rect()); }).ns;
+    }
+    Bench::out() << QString("qtcharts frame  %1 us").arg(fq / 1e3 / kFrames, 8, 'f', 1) << Qt::endl;
+    Bench::out() << QString("lineplot frame  %1 us").arg(fp / 1e3 / kFrames, 8, 'f', 1) << Qt::endl;
+}
+
+// LinePlot on a decimated price trace, the usual case for real history: 20k raw points (one per 0.1 s, 2000 s window)
+// through Decimator at the plot width (LTTB, then min/max), one new raw point per tick. "kept" keeps the LinePlot across
+// ticks (setTrace reuses the anchored buckets, only restated/new samples are copied and mapped); "fresh" rebuilds it each
+// tick, i.e. a full copy and remap of the trace. Decimation itself is outside the timing.
+void runChartDecimated() {
+    constexpr int kRaw = 20000, kDecTicks = 20000; constexpr double kStep = 0.1, kWindow = kRaw * kStep;
+    QImage img(kW, kH, QImage::Format_ARGB32_Premultiplied); LinePlot probe; probe.setTitle("BTC | 30m");
+    const int columns = probe.plotArea(img.rect()).width();
+    for (const bool minMax : {false, true}) {
+        std::mt19937_64 rng(240); std::normal_distribution<double> step(0.0, 0.02);
+        Decimator dec; dec.configure(minMax ? Decimator::Mode::MinMax : Decimator::Mode::Lttb, kWindow / (minMax ? columns / 2 : columns));
+        double t = 1728000000.0, p = 100.0; std::vector<double> ts, v;
+        for (int i=0; i<kRaw; ++i) { t += kStep; p += step(rng); dec.append(t, p); }
+        LinePlot kept; kept.setTitle("BTC | 30m");
+        qint64 nsK = 0, nsF = 0; quint64 alK = 0, alF = 0; size_t samples = 0;
+        for (int i=0; i<kDecTicks; ++i) {
+            t += kStep; p += step(rng); dec.append(t, p); dec.dropBefore(t - kWindow); dec.output(ts, v); samples += v.size();
+            const Bench::Result a = Bench::measure([&]{ kept.setTrace(LinePlot::Price, v); QPainter pt(&img); kept.paint(pt, img.rect()); }); nsK += a.ns; alK += a.allocs;
+            const Bench::Result b = Bench::measure([&]{ LinePlot fresh; fresh.setTitle("BTC | 30m"); fresh.setTrace(LinePlot::Price, v); QPainter pt(&img); fresh.paint(pt, img.rect()); }); nsF += b.ns; alF += b.allocs;
+        }
+        Bench::out() << QString("%1 %2 raw -> %3 samples (%4 columns)").arg(minMax ? "minmax" : "lttb  ").arg(kRaw).arg(double(samples) / kDecTicks, 0, 'f', 0).arg(columns) << Qt::endl;
+        Bench::out() << QString("  kept  %1 us/tick  %2 allocs/tick").arg(nsK / 1e3 / kDecTicks, 8, 'f', 2).arg(double(alK) / kDecTicks, 7, 'f', 1) << Qt::endl;
+        Bench::out() << QString("  fresh %1 us/tick  %2 allocs/tick").arg(nsF / 1e3 / kDecTicks, 8, 'f', 2).arg(double(alF) / kDecTicks, 7, 'f', 1) << Qt::endl;
+    }
+}
+
+}
+
+BENCH_REGISTER("chart", runChart);
+BENCH_REGISTER("chart_decimated", runChartDecimated);
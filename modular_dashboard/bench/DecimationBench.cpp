@@ -0,0 +1,74 @@
+#include "Bench.h"
+#include "Decimator.h"
+#include <QString>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Chart decimation of 1M points into 800 columns: the previous fixed-step last/mean/max sampling of processHistory vs
+// Decimator (LTTB, min/max per pixel) built in one pass, then the per-tick cost of keeping it current (append + output)
+// against re-decimating from scratch. Series = seeded random walk with single-point spikes; "spikes kept" counts spikes
+// whose exact value survives in the output.
+constexpr int kPoints = 1000000, kColumns = 800, kSpikeEvery = 4999, kTicks = 20000;
+constexpr double kStep = 0.05; // seconds between points
+
+std::vector<double> stepSample(const std::vector<double>& v, int method) {
+    std::vector<double> out; out.reserve(kColumns + 1); const size_t step = std::max<size_t>(1, v.size() / kColumns);
+    for (size_t i=0; i<v.size(); i+=step) {
+        const size_t end = std::min(i + step, v.size());
+        if (method==0) out.push_back(v[end-1]);
+        else if (method==1) { double s=0.0; for (size_t k=i; k<end; ++k) s+=v[k]; out.push_back(s / double(end-i)); }
+        else { double m=v[i]; for (size_t k=i; k<end; ++k) m=std::max(m, v[k]); out.push_back(m); }
+    }
+    return out;
+}
+
+int spikesKept(const std::vector<double>& out, const std::vector<double>& spikes) {
+    std::vector<double> sorted(out); std::sort(sorted.begin(), sorted.end());
+    int n = 0; for (double s : spikes) if (std::binary_search(sorted.begin(), sorted.end(), s)) ++n;
+    return n;
+}
+
+void runDecimation() {
+    std::mt19937_64 rng(17); std::normal_distribution<double> step(0.0, 0.02);
+    std::vector<double> ts(kPoints + kTicks), v(kPoints + kTicks), spikes; double p = 100.0;
+    for (int i=0; i<kPoints + kTicks; ++i) {
+        p += step(rng); ts[size_t(i)] = 1728000000.0 + i * kStep; v[size_t(i)] = p;
+        if (i % kSpikeEvery == kSpikeEvery - 1 && i < kPoints) { v[size_t(i)] = p * ((i / kSpikeEvery) % 2 ? 1.03 : 0.97); spikes.push_back(v[size_t(i)]); }
+    }
+    const std::vector<double> base(v.begin(), v.begin() + kPoints);
+    const double bucketSec = kPoints * kStep / kColumns;
+    Bench::out() << QString("%1 points -> %2 columns, %3 spikes").arg(kPoints).arg(kColumns).arg(spikes.size()) << Qt::endl;
+
+    static const char* stepNames[] = {"step last", "step mean", "step max "};
+    for (int m=0; m<3; ++m) {
+        std::vector<double> out; const Bench::Result r = Bench::measure([&]{ out = stepSample(base, m); });
+        Bench::out() << QString("%1  %2 ms  %3 points  spikes kept %4").arg(stepNames[m]).arg(r.ns / 1e6, 8, 'f', 2)
+                        .arg(out.size(), 5).arg(spikesKept(out, spikes)) << Qt::endl;
+    }
+    const struct { const char* name; Decimator::Mode mode; double width; } modes[] = {
+        {"lttb     ", Decimator::Mode::Lttb, bucketSec}, {"minmax   ", Decimator::Mode::MinMax, bucketSec * 2} };
+    for (const auto& md : modes) {
+        Decimator d; std::vector<double> ots, out;
+        const Bench::Result full = Bench::measure([&]{
+            d.configure(md.mode, md.width); d.clear();
+            for (int i=0; i<kPoints; ++i) d.append(ts[size_t(i)], v[size_t(i)]);
+            d.output(ots, out);
+        });
+        Bench::out() << QString("%1  %2 ms  %3 points  spikes kept %4").arg(md.name).arg(full.ns / 1e6, 8, 'f', 2)
+                        .arg(out.size(), 5).arg(spikesKept(out, spikes)) << Qt::endl;
+        // Steady state: one new point per tick, window slides by the same amount
+        const Bench::Result inc = Bench::measure([&]{
+            for (int i=kPoints; i<kPoints + kTicks; ++i) { d.append(ts[size_t(i)], v[size_t(i)]); d.dropBefore(ts[size_t(i)] - kPoints * kStep); d.output(ots, out); }
+        });
+        Bench::out() << QString("%1  per tick %2 us (append + output, %3 allocs/tick) vs %4 us rebuild")
+                        .arg(md.name).arg(inc.ns / 1e3 / kTicks, 8, 'f', 2).arg(double(inc.allocs) / kTicks, 5, 'f', 3)
+                        .arg(full.ns / 1e3, 10, 'f', 0) << Qt::endl;
+    }
+}
+
+}
+
+BENCH_REGISTER("decimation", runDecimation);
@@ -0,0 +1,184 @@
+#include "Bench.h"
+#include "HistoryRing.h"
+#include "RatioSeries.h"
+#include "TimePyramid.h"
+#include <QFile>
+#include <QString>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Widget price history before/after the struct-of-arrays ring: 50 widgets, each trimmed at 20k points.
+// "deque" mirrors the previous DynamicSpeedometerCharts::updateData (one point struct with three label strings per tick).
+struct LegacyPoint { double ts=0.0; double value=0.0; QString source; QString provider; QString market; quint64 seq=0; };
+
+constexpr int kWidgets = 50, kPoints = 20000, kTicks = 2000000;
+
+void runHistory() {
+    const QString source("live"), provider("Binance"), market("Spot");
+    std::vector<std::deque<LegacyPoint>> legacy(kWidgets);
+    std::vector<HistoryRing> rings(kWidgets, HistoryRing(kPoints));
+    const HistoryRing::Tag tag = HistoryRing::makeTag(source, provider, market);
+    quint64 seq = 0; volatile double sink = 0.0;
+    auto legacyTick = [&](int i){
+        auto& h = legacy[size_t(i % kWidgets)];
+        LegacyPoint p; p.ts = 1728000000.0 + i * 1e-3; p.value = 100.0 + (i & 1023) * 0.01; p.source = source; p.provider = provider; p.market = market; p.seq = ++seq;
+        h.push_back(p); if (h.size() > size_t(kPoints)) h.pop_front();
+        sink = sink + h.back().value;
+    };
+    auto ringTick = [&](int i){
+        HistoryRing& h = rings[size_t(i % kWidgets)];
+        h.push(1728000000.0 + i * 1e-3, 100.0 + (i & 1023) * 0.01, ++seq, tag);
+        sink = sink + h.backValue();
+    };
+    // Fill every widget to capacity first so the timed part is the steady state (push + evict)
+    const int fill = kWidgets * kPoints;
+    const Bench::Result lf = Bench::measure([&]{ for (int i=0; i<fill; ++i) legacyTick(i); });
+    const Bench::Result rf = Bench::measure([&]{ for (int i=0; i<fill; ++i) ringTick(i); });
+    const Bench::Result l = Bench::measure([&]{ for (int i=0; i<kTicks; ++i) legacyTick(fill + i); });
+    const Bench::Result r = Bench::measure([&]{ for (int i=0; i<kTicks; ++i) ringTick(fill + i); });
+
+    // deque: the point struct itself plus the per-block map pointer (label strings share one QString buffer each)
+    const double legacyBytes = double(sizeof(LegacyPoint)) + double(sizeof(void*)) * sizeof(LegacyPoint) / 512.0;
+    size_t ringBytes = 0, ringPoints = 0; for (const HistoryRing& h : rings) { ringBytes += h.memoryBytes(); ringPoints += h.size(); }
+    Bench::out() << QString("%1 widgets x %2 points").arg(kWidgets).arg(kPoints) << Qt::endl;
+    Bench::out() << QString("deque  %1 bytes/point  fill %2 allocs/tick  steady %3 ticks/s  %4 allocs/tick")
+                    .arg(legacyBytes, 6, 'f', 1).arg(double(lf.allocs) / fill, 5, 'f', 3)
+                    .arg(kTicks * 1e9 / double(qMax<qint64>(1, l.ns)), 12, 'f', 0).arg(double(l.allocs) / kTicks, 5, 'f', 3) << Qt::endl;
+    Bench::out() << QString("ring   %1 bytes/point  fill %2 allocs/tick  steady %3 ticks/s  %4 allocs/tick")
+                    .arg(double(ringBytes) / double(qMax<size_t>(1, ringPoints)), 6, 'f', 1).arg(double(rf.allocs) / fill, 5, 'f', 3)
+                    .arg(kTicks * 1e9 / double(qMax<qint64>(1, r.ns)), 12, 'f', 0).arg(double(r.allocs) / kTicks, 5, 'f', 3) << Qt::endl;
+}
+
+// updateBounds windows: WindowExtremes vs the previous full rescan over the same series, checked tick by tick.
+// Series = $MD_SERIES (one price per line, e.g. exported history) or a seeded random walk; the ring is also trimmed,
+// cleared and resized along the way the way retention / replaceHistory / setRawCacheSize do.
+void runBounds() {
+    std::vector<double> series;
+    QFile f(qEnvironmentVariable("MD_SERIES"));
+    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) { while (!f.atEnd()) { bool ok = false; const double v = f.readLine().trimmed().toDouble(&ok); if (ok) series.push_back(v); } }
+    std::mt19937_64 rng(12345);
+    if (series.empty()) { double p = 100.0; std::normal_distribution<double> step(0.0, 0.05); for (int i=0; i<300000; ++i) { p += step(rng); series.push_back(p); } }
+    const int windows[] = { 0, 50, 200, 800 }; // Adaptive/PythonLike default (whole history) + KiloCoderLike short/medium/long
+    HistoryRing h(kPoints); WindowExtremes ext[4]; const HistoryRing::Tag tag;
+    quint64 mismatches = 0; qint64 scanNs = 0, incNs = 0; volatile double sink = 0.0;
+    for (size_t t=0; t<series.size(); ++t) {
+        h.push(double(t), series[t], t, tag);
+        const quint64 r = rng() % 20000;
+        if (r == 0) h.popFront(size_t(rng() % 5000)); else if (r == 1) h.setCapacity(1000 + int(rng() % 30000)); else if (r == 2) h.clear();
+        if (h.empty()) continue;
+        for (int k=0; k<4; ++k) {
+            const int n = windows[k] == 0 ? int(h.size()) : std::min<int>(windows[k], int(h.size()));
+            double mn = std::numeric_limits<double>::max(), mx = std::numeric_limits<double>::lowest();
+            scanNs += Bench::measure([&]{ for (int i=int(h.size())-n; i<int(h.size()); ++i) { const double v = h.value(size_t(i)); mn = std::min(mn, v); mx = std::max(mx, v); } }).ns;
+            incNs += Bench::measure([&]{ ext[k].sync(h, n); sink = sink + ext[k].min(); }).ns;
+            if (ext[k].min() != mn || ext[k].max() != mx) ++mismatches;
+        }
+    }
+    const double ticks = double(qMax<size_t>(1, series.size()));
+    Bench::out() << QString("%1 ticks, history %2, windows all/50/200/800").arg(series.size()).arg(kPoints) << Qt::endl;
+    Bench::out() << QString("rescan       %1 ns/tick").arg(scanNs / ticks, 10, 'f', 1) << Qt::endl;
+    Bench::out() << QString("incremental  %1 ns/tick").arg(incNs / ticks, 10, 'f', 1) << Qt::endl;
+    if (Bench::check(mismatches == 0, QString("%1 window results differ from the rescan").arg(mismatches))) Bench::out() << "bounds identical" << Qt::endl;
+}
+
+// processHistory windowing on a full 20k ring (1 point/s, wrapped): the previous linear scan + filtered pair copy vs
+// HistoryRing::window (binary search) read in place, both summing the window. Windows = the widget's 1m..6h scales.
+void runWindow() {
+    HistoryRing h(kPoints); const HistoryRing::Tag tag;
+    for (int i=0; i<kPoints + kPoints / 3; ++i) h.push(double(i), 100.0 + (i & 255) * 0.01, quint64(i), tag);
+    const double now = h.backTs(); const int windows[] = { 60, 300, 900, 3600, 21600 }; constexpr int kReps = 2000;
+    for (int w : windows) {
+        double a = 0.0, b = 0.0;
+        const Bench::Result copy = Bench::measure([&]{ for (int r=0; r<kReps; ++r) {
+            std::vector<std::pair<double,double>> filtered; filtered.reserve(h.size());
+            h.forEach(0, [&](double ts, double v){ if (ts >= now - w) filtered.push_back({ts, v}); });
+            for (const auto& kv : filtered) a += kv.second;
+        } });
+        const Bench::Result view = Bench::measure([&]{ for (int r=0; r<kReps; ++r) h.window(now - w).forEach([&](double, double v){ b += v; }); });
+        Bench::out() << QString("window %1 s  scan+copy %2 us  view %3 us  allocs/call %4 -> %5")
+                        .arg(w, 6).arg(copy.ns / 1e3 / kReps, 8, 'f', 2).arg(view.ns / 1e3 / kReps, 8, 'f', 2)
+                        .arg(double(copy.allocs) / kReps, 0, 'f', 1).arg(double(view.allocs) / kReps, 0, 'f', 1) << Qt::endl;
+        Bench::check(a == b, QString("window %1 s: view sum differs from the copy").arg(w));
+    }
+}
+
+// BTC ratio for a 50-widget grid (20k points each, BTC widget ticking twice as often): the previous second ring per
+// widget vs RatioSeries materialized only for the widgets showing btc_ratio, plus the cost of keeping one current.
+void runRatio() {
+    const HistoryRing::Tag tag; std::vector<HistoryRing> price(kWidgets, HistoryRing(kPoints)), legacyRatio(kWidgets, HistoryRing(kPoints));
+    HistoryRing btc(kPoints); TimePyramid btcPyramid;
+    double t = 1728000000.0;
+    for (int i=0; i<kPoints; ++i) {
+        t += 0.5; btc.push(t, 60000.0 + (i & 511), quint64(i), tag); btcPyramid.add(t, 60000.0 + (i & 511));
+        if (i & 1) continue;
+        for (int w=0; w<kWidgets; ++w) for (int k=0; k<2; ++k) { // each widget: two points per BTC pair, same span
+            const double v = 1.0 + w + (i & 255) * 1e-3; price[size_t(w)].push(t + k * 0.5, v, quint64(i), tag);
+            legacyRatio[size_t(w)].push(t + k * 0.5, v / btc.backValue(), quint64(i), tag);
+        }
+    }
+    size_t priceBytes = 0, legacyBytes = 0; for (int w=0; w<kWidgets; ++w) { priceBytes += price[size_t(w)].memoryBytes(); legacyBytes += legacyRatio[size_t(w)].memoryBytes(); }
+    RatioSeries ratio; const RatioSeries::Reference ref{&btc, &btcPyramid};
+    const Bench::Result build = Bench::measure([&]{ ratio.sync(price[0], ref, false); });
+    const size_t oneView = ratio.memoryBytes();
+    constexpr int kTicks = 100000; double tt = t + 1.0;
+    const Bench::Result inc = Bench::measure([&]{ for (int i=0; i<kTicks; ++i) {
+        tt += 0.25; btc.push(tt, 60000.0 + (i & 511), quint64(i), tag); price[0].push(tt + 0.1, 1.0 + (i & 255) * 1e-3, quint64(i), tag);
+        if (i % 8 == 7) ratio.sync(price[0], ref, false); // ~one cache refresh per 8 ticks
+    } });
+    auto mb = [](size_t b){ return double(b) / (1024.0 * 1024.0); };
+    Bench::out() << QString("%1 widgets x %2 points").arg(kWidgets).arg(kPoints) << Qt::endl;
+    Bench::out() << QString("before  price %1 MB + ratio rings %2 MB = %3 MB").arg(mb(priceBytes), 0, 'f', 1).arg(mb(legacyBytes), 0, 'f', 1).arg(mb(priceBytes + legacyBytes), 0, 'f', 1) << Qt::endl;
+    Bench::out() << QString("after   price %1 MB + ratio %2 MB (0 views) / %3 MB (1 view open)").arg(mb(priceBytes), 0, 'f', 1).arg(0.0, 0, 'f', 1).arg(mb(oneView), 0, 'f', 2) << Qt::endl;
+    Bench::out() << QString("join    full %1 us (%2 points), incremental %3 ns/tick").arg(build.ns / 1e3, 0, 'f', 0).arg(price[0].size()).arg(double(inc.ns) / kTicks, 0, 'f', 1) << Qt::endl;
+}
+
+// Pyramid buckets from folded ticks: trades (~50/s, random walk) are folded 8 per GUI frame into one TimePyramid::Ohlc the
+// way TickConflator / a Bybit batch does. Each level's bucket high/low/trades must equal the extremes and count of the
+// trades in it (a frame lands whole in the bucket of its last trade); the close-only add is shown for comparison.
+void runPyramid() {
+    constexpr int kTrades = 2000000, kFold = 8;
+    std::mt19937_64 rng(16); std::normal_distribution<double> step(0.0, 0.02); std::uniform_real_distribution<double> gap(0.0, 0.04);
+    TimePyramid ohlc, closes; struct Ref { double hi, lo; quint64 trades; };
+    std::vector<std::map<double, Ref>> ref(TimePyramid::kLevels);
+    double t = 1728000000.0, p = 100.0; TimePyramid::Ohlc f;
+    for (int i=0; i<kTrades; ++i) {
+        t += gap(rng); p += step(rng);
+        if (i % kFold == 0) f = TimePyramid::Ohlc{p, p, p, p, 0};
+        f.high = std::max(f.high, p); f.low = std::min(f.low, p); f.close = p; ++f.trades;
+        if (f.trades < quint32(kFold)) continue;
+        ohlc.add(t, f); closes.add(t, f.close);
+        for (int l=0; l<TimePyramid::kLevels; ++l) {
+            const double s = TimePyramid::levelSeconds(l), t0 = std::floor(t / s) * s;
+            auto it = ref[size_t(l)].find(t0);
+            if (it == ref[size_t(l)].end()) ref[size_t(l)][t0] = Ref{f.high, f.low, f.trades};
+            else { it->second.hi = std::max(it->second.hi, f.high); it->second.lo = std::min(it->second.lo, f.low); it->second.trades += f.trades; }
+        }
+    }
+    for (int l=0; l<TimePyramid::kLevels; ++l) {
+        quint64 mismatches = 0; double rangeOhlc = 0.0, rangeCloses = 0.0; const auto& a = ohlc.level(l); const auto& b = closes.level(l);
+        for (size_t i=0; i<a.size(); ++i) {
+            const Ref& r = ref[size_t(l)].at(a[i].t0);
+            if (a[i].high != r.hi || a[i].low != r.lo || a[i].trades != r.trades) ++mismatches;
+            rangeOhlc += a[i].high - a[i].low; rangeCloses += b[i].high - b[i].low;
+        }
+        Bench::out() << QString("level %1 s  %2 buckets  mean range ohlc %3  close-only %4 (%5%)  mismatches %6")
+                        .arg(TimePyramid::levelSeconds(l), 4).arg(a.size(), 5).arg(rangeOhlc / double(a.size()), 0, 'f', 4)
+                        .arg(rangeCloses / double(b.size()), 0, 'f', 4).arg(100.0 * rangeCloses / std::max(1e-12, rangeOhlc), 0, 'f', 1)
+                        .arg(mismatches) << Qt::endl;
+        Bench::check(mismatches == 0, QString("level %1 s: %2 buckets differ from the trades").arg(TimePyramid::levelSeconds(l)).arg(mismatches));
+    }
+}
+
+} // namespace
+
+BENCH_REGISTER("history", runHistory);
+BENCH_REGISTER("bounds", runBounds);
+BENCH_REGISTER("window", runWindow);
+BENCH_REGISTER("ratio", runRatio);
+BENCH_REGISTER("pyramid", runPyramid);
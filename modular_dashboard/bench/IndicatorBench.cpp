@@ -0,0 +1,96 @@
+#include "Bench.h"
+#include "IndicatorEngine.h"
+#include <QString>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// IndicatorEngine against the batch formulas it replaced in the widget (the former DynamicSpeedometerCharts::computeRSI /
+// computeMACD / computeBollinger, kept here as the reference). A 800-sample window scrolls over a seeded random walk; every
+// sample first shows as a still-open bucket (same timestamp, provisional value) and is restated on the next refresh.
+//  - extend: the engine only drops/steps/restates, so its outputs must equal the batch formulas over every sample fed
+//    since its reset (state carries over the dropped front), compared on the window
+//  - replay: a fresh engine synced to the window must equal the batch formulas over the window alone
+constexpr int kPoints = 800, kSamples = 20000, kCheckEvery = 97;
+constexpr double kTol = 1e-6; // Bollinger: rolling sums vs prefix sums round differently
+
+std::vector<double> refRSI(const std::vector<double>& v, int period) {
+    if (period <= 0 || (int)v.size() < period+1) return {};
+    std::vector<double> rsi(v.size(), 50.0);
+    double gain=0.0, loss=0.0;
+    for (int i=1; i<=period; ++i) { double diff = v[size_t(i)] - v[size_t(i-1)]; if (diff >= 0) gain += diff; else loss -= diff; }
+    gain /= period; loss /= period;
+    for (size_t i=size_t(period)+1; i<v.size(); ++i) {
+        double diff = v[i] - v[i-1]; double g = diff > 0 ? diff : 0.0, l = diff < 0 ? -diff : 0.0;
+        gain = (gain*(period-1) + g) / period; loss = (loss*(period-1) + l) / period;
+        double rs = (loss == 0.0) ? 0.0 : (gain / loss);
+        rsi[i] = (loss==0.0 && gain==0.0) ? 50.0 : (100.0 - (100.0/(1.0+rs)));
+    }
+    return rsi;
+}
+
+void refMACD(const std::vector<double>& v, int fast, int slow, int signal, std::vector<double>& macd, std::vector<double>& sig) {
+    macd.clear(); sig.clear(); if ((int)v.size() < slow+signal+2) return;
+    const double aF = 2.0/(fast+1), aS = 2.0/(slow+1), aSig = 2.0/(signal+1); double ef = v[0], es = v[0];
+    macd.resize(v.size()); sig.resize(v.size()); macd[0] = sig[0] = 0.0;
+    for (size_t i=1;i<v.size();++i) { ef += aF*(v[i]-ef); es += aS*(v[i]-es); macd[i] = ef - es; sig[i] = sig[i-1] + aSig*(macd[i]-sig[i-1]); }
+}
+
+void refBollinger(const std::vector<double>& v, int period, double k, std::vector<double>& up, std::vector<double>& lo) {
+    up.clear(); lo.clear(); if (period<=0 || (int)v.size() < period) return; const size_t n = v.size();
+    up.resize(n); lo.resize(n); std::vector<double> sum(n,0.0), sumsq(n,0.0);
+    for (size_t i=0;i<n;++i) {
+        sum[i] = v[i] + (i? sum[i-1] : 0.0); sumsq[i] = v[i]*v[i] + (i? sumsq[i-1] : 0.0);
+        if (i+1 >= size_t(period)) {
+            const size_t j = i+1 - size_t(period); const double s = sum[i] - (j? sum[j-1] : 0.0), s2 = sumsq[i] - (j? sumsq[j-1] : 0.0);
+            const double m = s / period, sd = std::sqrt(std::max(0.0, s2/period - m*m));
+            up[i] = m + k*sd; lo[i] = m - k*sd;
+        } else { up[i] = v[i]; lo[i] = v[i]; }
+    }
+}
+
+// Largest |engine - reference| over the engine's samples, reference taken at the same positions of its tail
+double maxDiff(const IndicatorEngine& e, const std::vector<double>& v) {
+    using I = IndicatorEngine; double d = 0.0; const size_t n = e.size(), off = v.size() - n;
+    auto cmp = [&](const std::vector<double>& a, const std::vector<double>& ref) { if (ref.empty()) return; for (size_t i=0; i<n; ++i) d = std::max(d, std::abs(a[i] - ref[off + i])); };
+    std::vector<double> m, s, up, lo; refMACD(v, I::kMacdFast, I::kMacdSlow, I::kMacdSignal, m, s); refBollinger(v, I::kBbPeriod, I::kBbK, up, lo);
+    cmp(e.rsi(), refRSI(v, I::kRsiPeriod)); cmp(e.macd(), m); cmp(e.signal(), s); cmp(e.bbUpper(), up); cmp(e.bbLower(), lo);
+    return d;
+}
+
+void runIndicators() {
+    std::mt19937_64 rng(15); std::normal_distribution<double> step(0.0, 0.05);
+    std::vector<double> ts, all, open; double p = 100.0;
+    for (int i=0; i<kSamples; ++i) { ts.push_back(1728000000.0 + i); open.push_back(p + step(rng)); p += step(rng); all.push_back(p); }
+    // Refresh q: newest sample j, provisional (open bucket) on even q, final on odd q
+    auto windowAt = [&](int q, std::vector<double>& wts, std::vector<double>& wv) {
+        const int j = kPoints - 1 + q / 2, from = j - kPoints + 1;
+        wts.assign(ts.begin() + from, ts.begin() + j + 1); wv.assign(all.begin() + from, all.begin() + j + 1);
+        if (q % 2 == 0) wv.back() = open[size_t(j)];
+    };
+    IndicatorEngine inc; std::vector<double> wts, wv, fed;
+    int replays = 0, checks = 0; double dExtend = 0.0, dReplay = 0.0; qint64 nsInc = 0, nsReplay = 0; int refreshes = 0;
+    for (int q=0; kPoints - 1 + q / 2 < kSamples; ++q, ++refreshes) {
+        windowAt(q, wts, wv);
+        nsInc += Bench::measure([&]{ replays += inc.sync(wts, wv) ? 1 : 0; }).ns;
+        IndicatorEngine fresh; nsReplay += Bench::measure([&]{ fresh.sync(wts, wv); }).ns;
+        if (q % kCheckEvery) continue;
+        ++checks; const int j = kPoints - 1 + q / 2;
+        fed.assign(all.begin(), all.begin() + j + 1); if (q % 2 == 0) fed.back() = open[size_t(j)];
+        dExtend = std::max(dExtend, maxDiff(inc, fed)); dReplay = std::max(dReplay, maxDiff(fresh, wv));
+    }
+    Bench::out() << QString("%1 refreshes (window %2, last sample restated every other refresh), %3 checks").arg(refreshes).arg(kPoints).arg(checks) << Qt::endl;
+    Bench::out() << QString("extend  %1 us/refresh  %2 replays  max diff %3").arg(nsInc / 1e3 / refreshes, 8, 'f', 2).arg(replays)
+                    .arg(dExtend, 0, 'g', 3) << Qt::endl;
+    Bench::out() << QString("replay  %1 us/refresh  max diff %2").arg(nsReplay / 1e3 / refreshes, 8, 'f', 2)
+                    .arg(dReplay, 0, 'g', 3) << Qt::endl;
+    Bench::check(dExtend <= kTol && replays == 1, "incremental engine differs from the batch formulas (or replayed)");
+    Bench::check(dReplay <= kTol, "replayed engine differs from the batch formulas");
+}
+
+} // namespace
+
+BENCH_REGISTER("indicators", runIndicators);
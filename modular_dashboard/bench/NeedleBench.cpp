@@ -0,0 +1,58 @@
+#include "Bench.h"
+#include "NeedleModel.h"
+#include <QString>
+#include <QVariantAnimation>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Needle retarget cost per tick and motion under a burst. "restart" = the previous updateData path (stop, setStartValue,
+// setEndValue, start on a 400 ms linear QVariantAnimation, the QPropertyAnimation base) against NeedleModel::setTarget.
+// Motion: 2 s burst of ticks every 2 ms (random-walk target on the 0..100 scale) then 1 s quiet, sampled at 16 ms frames;
+// the restart curve is evaluated analytically (linear from the displayed value at each tick). Jerk = mean |second
+// difference| of the frame positions (how often the needle visibly changes speed), lag = mean |position - target|.
+// Under dense ticks the restart path behaves like a first-order lag with a 400 ms time constant, so a spring with the
+// same settle time is much more responsive; "spring 700" is roughly matched on lag for a like-for-like jerk figure.
+constexpr int kTicks = 200000, kSettleMs = 400;
+constexpr qint64 kTickNs = 2000000, kFrameNs = 16000000, kBurstNs = 2000000000LL, kEndNs = 3000000000LL;
+
+void runNeedle() {
+    std::mt19937_64 rng(22); std::normal_distribution<double> step(0.0, 1.5);
+    std::vector<double> targets(kTicks); double v = 50.0;
+    for (double& t : targets) { v = std::clamp(v + step(rng), 0.0, 100.0); t = v; }
+
+    QVariantAnimation anim; anim.setDuration(kSettleMs); double shown = 50.0;
+    const Bench::Result a = Bench::measure([&]{ for (double t : targets) { anim.stop(); anim.setStartValue(shown); anim.setEndValue(t); anim.start(); } });
+    anim.stop();
+    NeedleModel needle; needle.setSettleMs(kSettleMs); needle.snap(50.0);
+    const Bench::Result b = Bench::measure([&]{ for (int i=0; i<kTicks; ++i) needle.setTarget(targets[size_t(i)], qint64(i) * kTickNs); });
+    Bench::out() << QString("restart    %1 ns/tick  %2 allocs/tick").arg(double(a.ns) / kTicks, 8, 'f', 1).arg(double(a.allocs) / kTicks, 5, 'f', 2) << Qt::endl;
+    Bench::out() << QString("spring     %1 ns/tick  %2 allocs/tick").arg(double(b.ns) / kTicks, 8, 'f', 1).arg(double(b.allocs) / kTicks, 5, 'f', 2) << Qt::endl;
+
+    // Motion over the burst: both driven by the same tick stream, read at frame times
+    struct Linear { double from = 50.0, to = 50.0; qint64 t0 = 0;
+        double at(qint64 t) const { const double u = std::min(1.0, double(t - t0) / (kSettleMs * 1e6)); return from + (to - from) * u; } } lin;
+    NeedleModel spring, slow; spring.setSettleMs(kSettleMs); spring.snap(50.0); slow.setSettleMs(700); slow.snap(50.0);
+    std::vector<double> pl, ps, pw, tg; double target = 50.0; size_t next = 0;
+    for (qint64 f=0; f<=kEndNs; f+=kFrameNs) {
+        for (; next < targets.size() && qint64(next) * kTickNs < std::min(f, kBurstNs); ++next) {
+            const qint64 t = qint64(next) * kTickNs; target = targets[next];
+            lin = Linear{lin.at(t), target, t}; spring.setTarget(target, t); slow.setTarget(target, t);
+        }
+        spring.advance(f); slow.advance(f); pl.push_back(lin.at(f)); ps.push_back(spring.value(f)); pw.push_back(slow.value(f)); tg.push_back(target);
+    }
+    auto report = [&](const char* name, const std::vector<double>& p) {
+        double jerk = 0.0, lag = 0.0; for (size_t i=2; i<p.size(); ++i) jerk += std::abs(p[i] - 2*p[i-1] + p[i-2]);
+        for (size_t i=0; i<p.size(); ++i) lag += std::abs(p[i] - tg[i]);
+        Bench::out() << QString("%1 jerk %2  lag %3  (per frame, %4 frames)").arg(name).arg(jerk / double(p.size() - 2), 7, 'f', 4)
+                        .arg(lag / double(p.size()), 7, 'f', 3).arg(p.size()) << Qt::endl;
+    };
+    report("restart   ", pl); report("spring    ", ps); report("spring 700", pw);
+}
+
+}
+
+BENCH_REGISTER("needle", runNeedle);
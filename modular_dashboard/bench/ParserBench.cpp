@@ -0,0 +1,52 @@
+#include "Bench.h"
+#include "MarketDataParser.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QVector>
+
+namespace {
+
+struct Frame { DataProvider provider; StreamMode mode; QString text; QByteArray utf8; };
+
+QVector<Frame> sampleFrames() {
+    const char* raw[][3] = {
+        { "B", "T", R"({"stream":"btcusdt@trade","data":{"e":"trade","E":1728000000123,"s":"BTCUSDT","t":3912345678,"p":"62345.12000000","q":"0.00150000","T":1728000000120,"m":true,"M":true}})" },
+        { "B", "K", R"({"stream":"ethusdt@ticker","data":{"e":"24hrTicker","E":1728000000456,"s":"ETHUSDT","p":"-12.34000000","P":"-0.512","w":"2410.55","x":"2420.01","c":"2407.67000000","Q":"0.12340000","b":"2407.66","B":"10.5","a":"2407.67","A":"3.2","o":"2420.01","h":"2450.00","l":"2380.10","v":"301234.55000000","q":"726123456.12345678","O":1727913600000,"C":1728000000000,"F":1,"L":2,"n":3}})" },
+        { "Y", "T", R"({"topic":"publicTrade.SOLUSDT","type":"snapshot","ts":1728000000789,"data":[{"T":1728000000780,"s":"SOLUSDT","S":"Buy","v":"1.2","p":"145.230","L":"PlusTick","i":"a1","BT":false},{"T":1728000000781,"s":"SOLUSDT","S":"Sell","v":"0.4","p":"145.220","L":"MinusTick","i":"a2","BT":false},{"T":1728000000785,"s":"SOLUSDT","S":"Buy","v":"3.0","p":"145.250","q":"3.0","L":"PlusTick","i":"a3","BT":false}]})" },
+        { "Y", "K", R"({"topic":"tickers.XRPUSDT","type":"snapshot","data":{"symbol":"XRPUSDT","tickDirection":"PlusTick","price24hPcnt":"0.0123","lastPrice":"0.5321","prevPrice24h":"0.5256","highPrice24h":"0.5400","lowPrice24h":"0.5200","prevPrice1h":"0.5300","markPrice":"0.5320","indexPrice":"0.5319","openInterest":"123456789","turnover24h":"98765432.1","volume24h":"185000000","fundingRate":"0.0001"},"cs":123456789,"ts":1728000000999})" },
+    };
+    QVector<Frame> v;
+    for (const auto& r : raw) {
+        Frame f; f.provider = (r[0][0]=='B') ? DataProvider::Binance : DataProvider::Bybit; f.mode = (r[1][0]=='T') ? StreamMode::Trade : StreamMode::Ticker;
+        f.utf8 = QByteArray(r[2]); f.text = QString::fromUtf8(f.utf8); v << f;
+    }
+    return v;
+}
+
+bool same(const MarketTick& a, const MarketTick& b) {
+    return a.price==b.price && a.timestamp==b.timestamp && a.volBase==b.volBase && a.volQuote==b.volQuote && a.volIncr==b.volIncr && a.currency()==b.currency()
+        && a.open==b.open && a.high==b.high && a.low==b.low && a.trades==b.trades;
+}
+
+void runParser() {
+    const QVector<Frame> frames = sampleFrames();
+    for (const Frame& f : frames) {
+        MarketTick a, b; MarketDataParser::scan(QStringView(f.text), f.provider, f.mode, a);
+        MarketDataParser::fromJson(QJsonDocument::fromJson(f.utf8).object(), f.provider, f.mode, b);
+        Bench::check(same(a, b), "scan vs QJsonDocument on " + f.text.left(60));
+    }
+    const int iters = 250000; const qint64 msgs = qint64(iters) * frames.size(); volatile double sink = 0.0;
+    auto report = [&](const char* label, const Bench::Result& r) {
+        Bench::out() << QString("%1  %2 msgs/s  %3 allocs/msg  %4 ns/msg").arg(QString::fromLatin1(label), -28)
+                        .arg(msgs * 1e9 / double(qMax<qint64>(1, r.ns)), 12, 'f', 0)
+                        .arg(double(r.allocs) / double(msgs), 7, 'f', 2)
+                        .arg(double(r.ns) / double(msgs), 8, 'f', 1) << Qt::endl;
+    };
+    report("scan(QStringView)", Bench::measure([&]{ MarketTick t; for (int i=0; i<iters; ++i) for (const Frame& f : frames) { MarketDataParser::scan(QStringView(f.text), f.provider, f.mode, t); sink = sink + t.price; } }));
+    report("scan(QByteArrayView utf8)", Bench::measure([&]{ MarketTick t; for (int i=0; i<iters; ++i) for (const Frame& f : frames) { MarketDataParser::scan(QByteArrayView(f.utf8), f.provider, f.mode, t); sink = sink + t.price; } }));
+    report("QJsonDocument (old path)", Bench::measure([&]{ MarketTick t; for (int i=0; i<iters; ++i) for (const Frame& f : frames) { QJsonDocument doc = QJsonDocument::fromJson(f.text.toUtf8()); MarketDataParser::fromJson(doc.object(), f.provider, f.mode, t); sink = sink + t.price; } }));
+}
+
+} // namespace
+
+BENCH_REGISTER("parser", runParser);
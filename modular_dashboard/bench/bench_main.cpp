@@ -0,0 +1,36 @@
+#include "Bench.h"
+#include <QApplication>
+#include <QMap>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<quint64> g_allocs{0}, g_bytes{0};
+std::atomic<quint64>& Bench::allocations() { return g_allocs; }
+std::atomic<quint64>& Bench::allocatedBytes() { return g_bytes; }
+QTextStream& Bench::out() { static QTextStream s(stdout); return s; }
+
+void* operator new(std::size_t n) { g_allocs.fetch_add(1, std::memory_order_relaxed); g_bytes.fetch_add(n, std::memory_order_relaxed); if (void* p = std::malloc(n ? n : 1)) return p; throw std::bad_alloc(); }
+void* operator new[](std::size_t n) { g_allocs.fetch_add(1, std::memory_order_relaxed); g_bytes.fetch_add(n, std::memory_order_relaxed); if (void* p = std::malloc(n ? n : 1)) return p; throw std::bad_alloc(); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static QMap<QString, Bench::Entry>& registry() { static QMap<QString, Bench::Entry> r; return r; }
+bool Bench::registerBench(const char* name, Entry fn) { registry().insert(QString::fromLatin1(name), fn); return true; }
+static int g_failures = 0;
+bool Bench::check(bool ok, const QString& what) { if (!ok) { ++g_failures; out() << "MISMATCH: " << what << Qt::endl; } return ok; }
+
+// Usage: modular_dashboard_bench [name ...]   (no names = run all; headless: QT_QPA_PLATFORM=offscreen)
+// Exit code 1 when any Bench::check failed (the check benches are registered with ctest)
+int main(int argc, char** argv) {
+    QApplication app(argc, argv); // the chart bench builds a QChartView
+    QStringList wanted = app.arguments().mid(1);
+    for (auto it = registry().cbegin(); it != registry().cend(); ++it) {
+        if (!wanted.isEmpty() && !wanted.contains(it.key())) continue;
+        Bench::out() << "== " << it.key() << " ==" << Qt::endl;
+        it.value()();
+    }
+    if (g_failures) Bench::out() << g_failures << " check(s) failed" << Qt::endl;
+    return g_failures ? 1 : 0;
+}
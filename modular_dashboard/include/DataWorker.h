@@ -5,22 +5,69 @@
 #include <QMap>
 #include <QStringList>
 #include <QSet>
+#include <QVector>
+#include <QElapsedTimer>
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include "TickRing.h"
+#include "SymbolRegistry.h"
 
 enum class StreamMode { Trade, Ticker };
 enum class DataProvider { Binance, Bybit };
 enum class BybitMarket { Spot, Linear };
 enum class BybitPreference { LinearFirst, SpotFirst };
+struct MarketTick;
+struct CapturedFrame; class FrameRecorder; class FrameReader;
+
+// Compact tick record for batched delivery to the GUI (POD, no heap members)
+enum class TickMarket : quint8 { None, Linear, Spot };
+struct TickRecord {
+    SymbolId symbol = InvalidSymbol;
+    DataProvider provider = DataProvider::Binance; TickMarket market = TickMarket::None;
+    double price = 0.0, timestamp = 0.0; // timestamp in seconds (exchange time)
+    double volBase = 0.0, volQuote = 0.0, volIncr = 0.0;
+    // Folded ticks (conflation): price is the close, open/high/low span every tick merged into this record
+    double open = 0.0, high = 0.0, low = 0.0; quint32 ticks = 1;
+    qint64 recvNs = 0;     // Profiler::nowNs() when its frame came off the socket
+    qint64 bufferedNs = 0; // Profiler::nowNs() when the worker buffered it
+    QString currencyName() const { return SymbolRegistry::instance().name(symbol); }
+    // Folds a later tick of the same symbol into this one: latest price/24h volumes/stamps, OHLC extremes, summed trade volume
+    void merge(const TickRecord& newer) {
+        high = std::max(high, newer.high); low = std::min(low, newer.low); volIncr += newer.volIncr; ticks += newer.ticks;
+        price = newer.price; timestamp = newer.timestamp; volBase = newer.volBase; volQuote = newer.volQuote;
+        provider = newer.provider; market = newer.market; recvNs = newer.recvNs; bufferedNs = newer.bufferedNs;
+    }
+};
+struct TickBatch { QVector<TickRecord> ticks; qint64 publishedNs = 0; };
+Q_DECLARE_METATYPE(TickBatch)
+using TickRing = TickRingT<TickRecord>;
 
 class DataWorker : public QObject {
     Q_OBJECT
 public:
     explicit DataWorker(QObject* parent=nullptr);
+    ~DataWorker() override;
     // These change internal socket state; ensure they run in the worker thread
     Q_INVOKABLE void setMode(StreamMode m);
     Q_INVOKABLE void setProvider(DataProvider p);
     Q_INVOKABLE void setBybitPreference(BybitPreference pref) { bybitPreference = pref; }
     Q_INVOKABLE void setAllowBybitFallback(bool allow) { allowBybitFallback = allow; }
+    // Batched delivery: >0 buffers ticks and emits ticksReady at most every ms; 0 keeps per-message signals
+    Q_INVOKABLE void setBatchInterval(int ms);
+    // Ring handoff: when set, ticks go into the ring (drained by the GUI frame tick) instead of any signal; nullptr disables
+    void setTickRing(TickRing* ring) { tickRing = ring; }
+    // Raw frame capture: every received text frame is appended to the recorder (shared between pool shards); nullptr stops
+    void setRecorder(std::shared_ptr<FrameRecorder> rec) { recorder = std::move(rec); }
+    // Offline replay: when set, start() feeds the capture file through processMessage instead of opening a socket.
+    // speed: 1 = recorded pace, N = N times faster, 0 = as fast as possible. Empty path = live.
+    Q_INVOKABLE void setReplaySource(const QString& path, double speed);
+    // Endpoint override for load tests (tools/synthetic_exchange): base "ws://host:port", paths are appended as on the real
+    // exchanges (/stream?streams=..., /v5/public/linear|spot). Empty = official endpoints. Applies on the next connect.
+    Q_INVOKABLE void setBaseUrls(const QString& binance, const QString& bybit);
+    // Connection counters, safe to read from any thread (pool stats)
+    quint64 messageCount() const { return framesIn.load(std::memory_order_relaxed); }
+    quint64 reconnectCount() const { return reconnects.load(std::memory_order_relaxed); }
 public slots:
     void start();
     void stop();
@@ -33,6 +80,9 @@ signals:
     // New: volume information; volBase/volQuote are typically 24h volumes for ticker mode; volIncrement is per-trade size for trade mode
     void volumeTick(const QString& currency, double volBase, double volQuote, double volIncrement, double timestamp);
     void unsupportedSymbol(const QString& currency, const QString& reason);
+    // Batched alternative to dataUpdated/volumeTick/dataTick (see setBatchInterval)
+    void ticksReady(const TickBatch& batch);
+    void replayFinished(quint64 frames, double seconds);
 private slots:
     void onConnected();
     void onDisconnected();
@@ -40,20 +90,35 @@ private slots:
     void processMessage(const QString& message);
 private:
     void connectWebSocket();
+    void startReplay();
+    void replayStep();
+    void emitTick(const MarketTick& tick);
+    void flushBatch();
+    TickRecord makeRecord(SymbolId id, const MarketTick& tick) const;
     void scheduleReconnect();
     void startPingWatchdog(bool enable);
     static qint64 nowMs();
     QStringList buildBybitArgs() const; // helper for Bybit subscriptions
-    void sendBybitSubscriptions(QWebSocket* target, const QStringList& args, BybitMarket market);
+    QStringList buildBinanceStreams() const; // btcusdt@trade / btcusdt@ticker
+    void sendBybitSubscriptions(QWebSocket* target, const QStringList& args, BybitMarket market, const char* op = "subscribe");
+    bool syncSubscriptions();
+    void noteResubscribeGap(SymbolId id, qint64 now);
     void handleBybitSubscribeAck(const QJsonObject& root);
 private:
     // Primary socket (Binance or Bybit primary market)
     QWebSocket* webSocket=nullptr;
     // Bybit alternate market socket (created only for Bybit provider)
     QWebSocket* bybitAlt=nullptr;
-    QMap<QString,int> msg_counter;
+    QVector<int> msgCountById; // per-symbol message counter for the periodic msg/s report
+    QVector<SymbolId> subscribedIds; SymbolIndex symbolIndex; // raw exchange symbol (BTCUSDT) -> id, rebuilt in setCurrencies
+    QHash<SymbolId,int> bybitDbgCount;
+    // Incremental (re)subscription: topics the live primary connection carries, and the tick gap of symbols kept across a change
+    QSet<QString> liveTopics; int binanceReqId = 0;
+    QVector<qint64> lastTickMsById; QSet<SymbolId> gapPending; qint64 gapSinceMs = 0, gapMaxMs = 0; bool gapReconnect = false;
     double last_report_time=0.0;
     std::atomic<bool> running=false;
+    std::atomic<quint64> framesIn{0}, reconnects{0};
+    qint64 frameRecvNs = 0; // receive stamp of the frame being processed (TickRecord::recvNs)
     StreamMode mode=StreamMode::Trade;
     DataProvider provider=DataProvider::Binance;
     QStringList subscribedCurrencies;
@@ -70,5 +135,17 @@ private:
     BybitPreference bybitPreference = BybitPreference::LinearFirst;
     bool allowBybitFallback = true; // when false, do not fall back to alternate Bybit market
     // Track where we last attempted a subscription for a symbol
-    QHash<QString, BybitMarket> lastSubMarket;
+    QHash<SymbolId, BybitMarket> lastSubMarket;
+    // Batched delivery state
+    int batchIntervalMs = 0; QTimer* batchTimer = nullptr; TickBatch pendingBatch;
+    // Ring handoff (owned by MainWindow); ringFlushTimer retries conflated records when the ring was full
+    TickRing* tickRing = nullptr; QTimer* ringFlushTimer = nullptr;
+    // Capture / replay
+    std::shared_ptr<FrameRecorder> recorder;
+    QString replayPath; double replaySpeed = 1.0; std::unique_ptr<FrameReader> replayReader; std::unique_ptr<CapturedFrame> replayNext;
+    QTimer* replayTimer = nullptr; QElapsedTimer replayClock; qint64 replayBaseNs = -1; quint64 replayFrames = 0;
+    // Endpoint override (empty = official)
+    QString binanceBase, bybitBase;
+    QString binanceUrl(const QStringList& streams) const;
+    QString bybitUrl(BybitMarket market) const;
 };
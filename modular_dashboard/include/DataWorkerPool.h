@@ -0,0 +1,76 @@
+#pragma once
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+#include <vector>
+#include "DataWorker.h"
+#include "FrameCapture.h"
+
+// Connection pool for the main feed: shards the watchlist over several DataWorker connections (optionally spread over
+// several threads) and presents them as one tick stream (same signals as DataWorker plus a merged ring drain).
+// Lives in the GUI thread; setters are forwarded to every shard as queued calls, so call order is preserved.
+class DataWorkerPool : public QObject {
+    Q_OBJECT
+public:
+    struct ShardStats { int shard = 0; int thread = 0; int symbols = 0; double msgPerSec = 0.0; quint64 messages = 0, reconnects = 0; };
+    static constexpr int AutoStreamsPerShard = 100; // auto mode: one connection per this many streams
+    static constexpr int MaxShards = 16;
+    explicit DataWorkerPool(QObject* parent=nullptr);
+    ~DataWorkerPool() override;
+    // shards: connections (0 = auto by stream count); threads: worker threads the shards are spread over (<= shards)
+    void configure(int shards, int threads);
+    void setMode(StreamMode m);
+    void setProvider(DataProvider p);
+    void setBybitPreference(BybitPreference pref);
+    void setBatchInterval(int ms);
+    // Endpoint override for every shard (see DataWorker::setBaseUrls); reconnects running shards
+    void setBaseUrls(const QString& binance, const QString& bybit);
+    void setCurrencies(const QStringList& list);
+    void start();
+    void stop();
+    void restart() { stop(); start(); }
+    // Capture every raw frame of every shard into one file; empty path stops. False if the file cannot be opened.
+    bool setRecording(const QString& path);
+    bool isRecording() const { return bool(recorder); }
+    // Replace the live feed with a capture file (single shard, see DataWorker::setReplaySource); empty path = back to live
+    void setReplay(const QString& path, double speed);
+    bool isReplaying() const { return !replayPath.isEmpty(); }
+    // Stops every shard and joins the threads (app shutdown)
+    void shutdown();
+    // Ring handoff: one SPSC ring per shard since each shard is its own producer
+    void setTickRing(bool enabled, TickRing::Policy policy);
+    int drain(QVector<TickRecord>& out);
+    void closeRings();
+    void sampleRingStats() const;
+    int shardCount() const { return int(shards.size()); }
+    QVector<ShardStats> shardStats() const { return lastStats; }
+signals:
+    void dataUpdated(const QString& currency, double price, double timestamp);
+    void dataTick(const QString& currency, double price, double timestamp, const QString& providerName, const QString& marketName);
+    void volumeTick(const QString& currency, double volBase, double volQuote, double volIncrement, double timestamp);
+    void unsupportedSymbol(const QString& currency, const QString& reason);
+    void ticksReady(const TickBatch& batch);
+    void replayFinished(quint64 frames, double seconds);
+private:
+    struct Shard { DataWorker* worker = nullptr; int thread = 0; QStringList symbols; std::unique_ptr<TickRing> ring; quint64 lastMessages = 0; };
+    int targetShardCount(int symbolCount) const;
+    void rebuild(int count);
+    void teardown();
+    void distribute(bool pushAll);
+    void reportStats();
+    template<typename F> void invokeAll(F f) { for (auto& s : shards) { DataWorker* w = s.worker; QMetaObject::invokeMethod(w, [w,f](){ f(w); }, Qt::QueuedConnection); } }
+    std::vector<Shard> shards; QVector<QThread*> threads;
+    QHash<QString,int> shardOf; // symbol -> shard; sticky so a list edit only touches the shards it changes
+    QStringList currencies;
+    int requestedShards = 1, requestedThreads = 1;
+    StreamMode mode = StreamMode::Trade; DataProvider provider = DataProvider::Binance; BybitPreference bybitPreference = BybitPreference::LinearFirst;
+    QString binanceBase, bybitBase;
+    int batchMs = 0; bool running = false; bool ringEnabled = false; TickRing::Policy ringPolicy = TickRing::Policy::DropOldest;
+    std::shared_ptr<FrameRecorder> recorder; QString replayPath; double replaySpeed = 1.0;
+    QTimer* statsTimer = nullptr; QElapsedTimer statsClock; QVector<ShardStats> lastStats;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Streaming chart decimation into time-aligned buckets (bucketSec ~ one pixel column / one output point):
+//  - Lttb: Largest-Triangle-Three-Buckets, one point per bucket; keeps spikes and troughs that last/mean/max steps lose
+//  - MinMax: per-pixel envelope, the bucket's min and max in time order (up to 2 points per bucket)
+// Points are appended as they arrive; closed buckets keep their result, so an append only re-decimates the tail:
+// the LTTB pick of the last closed bucket depends on the open bucket's average and is redone on output(), the open
+// bucket itself shows its latest point. Buckets older than the window are dropped without touching the rest.
+class Decimator {
+public:
+    enum class Mode { Lttb, MinMax };
+    // Returns true (and clears) when the mode or bucket width changed
+    bool configure(Mode m, double bucketSec);
+    void clear();
+    // ts must not go backwards; older points are ignored
+    void append(double ts, double v);
+    void dropBefore(double from);
+    void output(std::vector<double>& ts, std::vector<double>& out);
+    size_t bucketCount() const { return buckets.size(); }
+    // Caller bookkeeping: source index up to which points were appended (reset by clear())
+    uint64_t fedUntil() const { return fed; }
+    void setFedUntil(uint64_t i) { fed = i; }
+private:
+    struct Pt { double ts, v; };
+    struct Bucket { double t0 = 0.0, sumTs = 0.0, sum = 0.0; uint32_t n = 0; Pt first{0,0}, last{0,0}, mn{0,0}, mx{0,0}, pick{0,0}; };
+    // Point of pts forming the largest triangle with a (previous pick) and the average point of the next bucket c
+    static Pt lttbPick(const std::vector<Pt>& pts, const Pt& a, const Bucket& c);
+    void pickLastClosed();
+    Mode mode = Mode::Lttb; double width = 0.0;
+    std::vector<Bucket> buckets; size_t head = 0; // buckets[head..] are live (front compacted lazily)
+    std::vector<Pt> prevPts, tailPts; // raw points of the last closed and the open bucket (LTTB re-pick)
+    uint64_t fed = 0;
+};
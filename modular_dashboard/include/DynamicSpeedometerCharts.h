@@ -1,16 +1,24 @@
 #pragma once
 #include <QWidget>
-#include <QPropertyAnimation>
 #include <QTimer>
-#include <QtCharts/QChartView>
-#include <QtCharts/QLineSeries>
-#include <QtCharts/QValueAxis>
 #include <deque>
 #include <optional>
 #include <vector>
 #include <QMap>
 #include <QString>
 #include "TransitionOverlay.h"
+#include "SymbolRegistry.h"
+#include "HistoryRing.h"
+#include "RollingVolatility.h"
+#include "IndicatorEngine.h"
+#include "TimePyramid.h"
+#include "Decimator.h"
+#include "LinePlot.h"
+#include "NeedleModel.h"
+#include "RatioSeries.h"
+#include "TimeSeriesStore.h"
+#include <QImage>
+#include <QPixmap>
 #include <QPointer>
 #include <QVector>
 
@@ -23,6 +31,7 @@ struct SpeedometerColors {
     QColor zoneDanger;     // red/danger zone
     QColor text;           // text color
     QColor glow;           // glow/highlight effect
+    bool operator==(const SpeedometerColors& o) const { return background==o.background && arcBase==o.arcBase && needleNormal==o.needleNormal && zoneGood==o.zoneGood && zoneWarn==o.zoneWarn && zoneDanger==o.zoneDanger && text==o.text && glow==o.glow; }
 };
 
 class DynamicSpeedometerCharts : public QWidget {
@@ -34,17 +43,28 @@ public:
     enum class ScalingMode { Fixed, Adaptive, Manual, PythonLike, OldSchoolAdaptive, OldSchoolPythonLike, KiloCoderLike };
     struct ScalingSettings { ScalingMode mode = ScalingMode::Adaptive; double fixedMin = 0.0; double fixedMax = 100.0; int windowSize = 0; double paddingPct = 0.01; };
     explicit DynamicSpeedometerCharts(const QString& currency, QWidget* parent=nullptr);
-    void applyPerformance(int animMs, int renderMs, int cacheMs, int volWindowSize, int maxPts, int rawCacheSize);
+    ~DynamicSpeedometerCharts() override;
+    // Per-widget part of the perf settings; frame / chart-cache intervals are global (FrameScheduler::configure)
+    void applyPerformance(int animMs, int volWindowSize, int maxPts, int rawCacheSize);
     void setRawCacheSize(int sz);
-    void updateData(double price, double timestamp, double btcPrice = 0);
+    // Reacts to a point ingest has just appended to TimeSeriesStore for this symbol (the widget does not own history)
+    void updateData(double price, double timestamp) { updateData(price, timestamp, price, price); }
+    // high/low: trade range folded into that point (conflated / batched trades), fed to the Parkinson volatility
+    void updateData(double price, double timestamp, double high, double low);
+    // Normalized 0..100 value of the latest point (where the needle is heading); pseudo tickers and the analyzer use it
+    double targetValue() const { return needle.target(); }
+    // Labels for points appended on this widget's behalf (source kind / provider / market badges)
+    const HistoryRing::Tag& historyTag() const { return currentTag; }
     void setCurrencyName(const QString& name);
+    SymbolId symbolId() const { return symId; }
+    const QString& currencyName() const { return currency; }
     // Source kind for new history points (e.g., "TRADE" or "TICKER")
-    void setSourceKind(const QString& kind) { currentSourceKind = kind; setProperty("sourceKind", currentSourceKind); }
+    void setSourceKind(const QString& kind) { currentSourceKind = kind; currentTag.source = HistoryRing::intern(kind); setProperty("sourceKind", currentSourceKind); }
     // Retention for raw history buffer in seconds (older points trimmed periodically)
-    void setHistoryRetentionSeconds(double sec) { historyRetentionSec = std::clamp(sec, 60.0, 7*24*3600.0); }
+    void setHistoryRetentionSeconds(double sec) { historyRetentionSec = std::clamp(sec, 60.0, 7*24*3600.0); TimeSeriesStore::instance().setRetention(symId, historyRetentionSec); }
     void setSpeedometerStyle(SpeedometerStyle s) { style = s; if (modeView=="speedometer") update(); }
     SpeedometerStyle speedometerStyle() const { return style; }
-    struct Thresholds { bool enabled=false; int warn=70; int danger=90; };
+    struct Thresholds { bool enabled=false; int warn=70; int danger=90; bool operator==(const Thresholds& o) const { return enabled==o.enabled && warn==o.warn && danger==o.danger; } };
     void applyThresholds(const Thresholds& t) { thresholds = t; if (modeView=="speedometer") update(); }
     void applyThemeColors(const SpeedometerColors& colors) { themeColors = colors; if (modeView=="speedometer") update(); }
     void applyScaling(const ScalingSettings& s) {
@@ -53,7 +73,7 @@ public:
         auto oldPadding = scalingSettings.paddingPct;
         scalingSettings = s;
         if (s.mode != oldMode || s.windowSize != oldWindow || s.paddingPct != oldPadding) { cachedMinVal.reset(); cachedMaxVal.reset(); }
-        if (!history.empty()) { updateBounds(history.back().value); }
+        { const auto rd = series(); if (!rd.history().empty()) updateBounds(rd.history().backValue()); }
         if (modeView=="speedometer") update();
     }
     ScalingSettings scaling() const { return scalingSettings; }
@@ -86,6 +106,10 @@ public:
     // key in {off,rsi,macd,bb,zscore,vol,comp,rsi_div,macd_hist,clustered_z,vol_regime}
     void setAnomalyModeByKey(const QString& key);
     void setOverlayVolatility(bool enabled);
+    // key in {mean,ewma,parkinson}
+    void setVolatilityKindByKey(const QString& key);
+    // Chart decimation, key in {last,mean,max,lttb,minmax}
+    void setDecimationByKey(const QString& key);
     void setOverlayChange(bool enabled);
     void updateVolume(double volBase24h, double volQuote24h, double volIncrement, double ts) {
         // Compute increment: prefer per-trade increment (TRADE mode); fallback to 24h deltas per second (TICKER mode)
@@ -107,11 +131,14 @@ public:
         volEmaMax = std::max(volEmaMax * 0.995, volEma);
         volNorm = (volEmaMax > 1e-12) ? std::clamp(volEma / volEmaMax, 0.0, 1.0) : 0.0;
         // Update last observed fields after using previous values for delta calc
+        // Traded amount for the time pyramid: trade size, else the 24h base-volume delta
+        TimeSeriesStore::instance().addVolume(symId, ts, volIncrement > 0.0 ? volIncrement : (prevTs > 0.0 ? volBase24h - prevBase : 0.0));
         lastVolBase = volBase24h; lastVolQuote = volQuote24h; lastVolIncr = volIncrement; lastVolTs = ts;
-        dataNeedsRedraw = true; if (modeView=="speedometer") update(); }
+        dataNeedsRedraw = true; framePending = true; }
     // Market badge API
     void setMarketBadge(const QString& provider, const QString& market) {
-        providerName = provider; marketName = market;
+        if (provider == providerName && market == marketName) return;
+        providerName = provider; marketName = market; currentTag.provider = HistoryRing::intern(provider); currentTag.market = HistoryRing::intern(market);
         setProperty("providerName", providerName);
         setProperty("marketName", marketName);
         if (modeView=="speedometer") update();
@@ -119,25 +146,21 @@ public:
     void setUnsupportedReason(const QString& reason) { unsupportedMsg = reason; if (modeView=="speedometer") update(); }
     // History snapshot (timestamp, price) in seconds
     QVector<QPair<double,double>> historySnapshot() const;
+    // Read access to this widget's symbol in TimeSeriesStore (holds its read lock; keep scoped)
+    TimeSeriesStore::Reader series() const { return TimeSeriesStore::instance().read(symId); }
     // Extended history snapshot with metadata
     struct HistoryPoint { double ts=0.0; double value=0.0; QString source; QString provider; QString market; quint64 seq=0; };
     QVector<HistoryPoint> historySnapshotEx() const {
+        const auto rd = series(); const HistoryRing& history = rd.history();
         QVector<HistoryPoint> out; out.reserve(int(history.size()));
-        for (const auto& p : history) out.push_back(p);
-        return out;
-    }
-    // Replace raw history with provided points (assumed sorted by ts)
-    void replaceHistory(const QVector<HistoryPoint>& pts) {
-        history.clear();
-        for (const auto& p : pts) history.push_back(p);
-        // Recompute cached metrics and redraw
-        if (!history.empty()) {
-            updateBounds(history.back().value);
-            updateVolatility();
+        for (size_t i=0; i<history.size(); ++i) {
+            const HistoryRing::Tag t = history.tag(i);
+            out.push_back(HistoryPoint{history.ts(i), history.value(i), HistoryRing::label(t.source), HistoryRing::label(t.provider), HistoryRing::label(t.market), history.seq(i)});
         }
-        dataNeedsRedraw = true;
-        if (modeView=="speedometer") update(); else updateChartSeries();
+        return out;
     }
+    // Replace the symbol's history in TimeSeriesStore with provided points (assumed sorted by ts)
+    void replaceHistory(const QVector<HistoryPoint>& pts);
 signals:
     void valueChanged(double newValue);
     void volatilityChanged(double newVolatility);
@@ -145,31 +168,36 @@ signals:
     void requestChangeTicker(const QString& oldName, const QString& newName);
     void styleSelected(const QString& currency, const QString& styleName);
 protected:
-    void paintEvent(QPaintEvent*) override;
-    void resizeEvent(QResizeEvent*) override;
+    void paintEvent(QPaintEvent* e) override;
     void mousePressEvent(QMouseEvent* e) override;
     void contextMenuEvent(QContextMenuEvent* e) override;
 private slots:
-    void onRenderTimeout();
     void setTimeScale(const QString& scale);
 private:
+    friend class FrameScheduler; // drives cacheChartData (round-robin, budgeted) and presentFrame / the offscreen tile path once per frame
     void setModeView(const QString& mv);
     void cacheChartData();
-    std::vector<double> processHistory(bool useBtcRatio);
+    void presentFrame(); // pushes chart series / repaints the dial if anything changed since the last frame
+    QRegion invalidateChanged(); // update()s only the regions whose content differs from the last invalidated state; returns them
+    QRect sectorRect(double from, double to) const; // bounds of the dial sector between two 0..100 values (needle / arcs)
+    QRect sidebarRect() const; // VolumeVis::Sidebar bar
+    // Offscreen tiles (FrameScheduler raster threads > 0): the frame is drawn into tileBack on a worker, then swapped and blitted
+    bool prepareOffscreen(); // GUI thread: advances the needle; true if this tile needs a new image this frame
+    void renderOffscreen();  // worker thread, while the GUI thread waits in the frame join: whole tile into tileBack
+    void finishOffscreen();  // GUI thread: swaps the buffers and update()s the changed regions
+    // Time-window filter + downsample to maxPoints; tsOut (optional) receives each sample's timestamp
+    std::vector<double> processHistory(bool useBtcRatio, std::vector<double>* tsOut = nullptr);
+    const HistoryRing& syncBtcRatio(); // brings btcRatio up to date with history and the BTC reference
+    void evaluateAnomaly(const std::vector<double>& values, const IndicatorEngine& ind);
     void updateVolatility();
     void updateBounds(double price);
     void drawSpeedometer(QPainter& p);
+    void drawDial(QPainter& p, int w, int h) const; // static layer of the current style (baked into dialCache)
     void updateChartSeries();
-    double getValue() const { return _value; }
-    void setValue(double v) { if (qFuzzyCompare(_value, v)) return; _value=v; emit valueChanged(v); }
+    double getValue() const; // needle position at the current frame time (also while a chart view is shown)
+    void setValue(double v) { needle.snap(v); if (qFuzzyCompare(_value, v)) return; _value=v; emit valueChanged(v); }
     double getVolatility() const { return volatility; }
     QString buildComputedTooltip(const QString& token) const;
-    // Indicator calculators (return same-length vectors or empty if insufficient)
-    static std::vector<double> computeRSI(const std::vector<double>& values, int period = 14);
-    struct MACDOut { std::vector<double> macd; std::vector<double> signal; };
-    static MACDOut computeMACD(const std::vector<double>& values, int fast=12, int slow=26, int signal=9);
-    struct BBOut { std::vector<double> upper; std::vector<double> lower; };
-    static BBOut computeBollinger(const std::vector<double>& values, int period=20, double k=2.0);
     // Anomaly detection
     enum class AnomalyMode { Off, RSIOverboughtOversold, MACDCross, BollingerBreakout, ZScore, VolSpike, Composite,
                              RSIDivergence, MACDHistSurge, ClusteredZ, VolRegimeShift };
@@ -210,22 +238,39 @@ private:
     bool transitionActive = false; // true while overlay animation runs
     QPointer<TransitionOverlay> activeOverlay; // currently running overlay
     void animateViewSwitch(const QString& nextMode);
-    QString currency; double _value=0; QString modeView="speedometer"; QPropertyAnimation* animation=nullptr;
-    QTimer* renderTimer=nullptr; QTimer* cacheUpdateTimer=nullptr; int volatilityWindow=800, maxPoints=800, sampleMethod=0, cacheSize=20000; QMap<QString,int> timeScales; QString currentScale="5m";
+    QString currency; SymbolId symId = InvalidSymbol; double _value=0; QString modeView="speedometer";
+    NeedleModel needle; // _value = needle position at the frame being painted
+    int volatilityWindow=800, maxPoints=800, sampleMethod=0, cacheSize=20000; QMap<QString,int> timeScales; QString currentScale="5m";
     bool showAxisLabels=false, showTooltips=false, smoothLines=false, trendColors=false, logScale=false, highlightLast=true, showGrid=true; 
     bool showVolOverlay=false, showChangeOverlay=false;
     // Indicator toggles
     bool showRSI=false, showMACD=false, showBB=false;
     // Anomaly state
     bool showAnomalyBadge=false; AnomalyMode anomalyMode = AnomalyMode::Off; bool anomalyActive=false; QString anomalyLabel;
-    double volatility=0.0; double btcPrice=0.0; std::optional<double> cachedMinVal, cachedMaxVal; bool dataNeedsRedraw=false;
-    std::deque<HistoryPoint> history, btcRatioHistory; std::vector<double> cachedProcessedHistory, cachedProcessedBtcRatio;
-    QChart* chart=nullptr; QChartView* chartView=nullptr; QLineSeries* seriesNormal=nullptr; QLineSeries* seriesRatio=nullptr; 
-    // Indicators series
-    QLineSeries* rsiSeries=nullptr; QLineSeries* macdSeries=nullptr; QLineSeries* macdSignalSeries=nullptr; QLineSeries* bbUpperSeries=nullptr; QLineSeries* bbLowerSeries=nullptr;
-    // Axes
-    QValueAxis* axisX=nullptr; QValueAxis* axisY=nullptr; QValueAxis* axisRSI=nullptr; QValueAxis* axisMACD=nullptr;
+    RollingVolatility volEstimator; // incremental estimator behind updateVolatility (kind per widget: ui/volatility/kind/<ticker>)
+    double volatility=0.0; std::optional<double> cachedMinVal, cachedMaxVal; bool dataNeedsRedraw=false;
+    // Price history lives in TimeSeriesStore (series()); currentTag = labels for points appended for this widget
+    HistoryRing::Tag currentTag; std::vector<double> cachedProcessedHistory, cachedProcessedBtcRatio;
+    // BTC ratio: joined from this symbol's and BTC's store series only while the btc_ratio view is shown
+    RatioSeries btcRatio; quint64 ratioEpoch = 0;
+    void resetSeriesState(); // drops state derived incrementally from the bound series (rebind / replace)
+    // sampleMethod: 0 last, 1 mean, 2 max (fixed steps), 3 LTTB, 4 min/max per pixel (incremental Decimator, one bucket per column)
+    Decimator priceDecimator, ratioDecimator;
+    size_t priceStep = 0, ratioStep = 0; // step-sampling bucket size (points) for sampleMethod 0-2, see processHistory
+    std::vector<double> cachedProcessedTs, cachedProcessedBtcRatioTs; IndicatorEngine priceIndicators, ratioIndicators; // indicator state over the processed series
+    LinePlot plot; // line_chart / btc_ratio views, painted by paintEvent; its buffers are released while the speedometer is shown
     SpeedometerStyle style = SpeedometerStyle::Classic; Thresholds thresholds{}; SpeedometerColors themeColors{}; ScalingSettings scalingSettings{};
+    // Static dial layer (background, arcs, zones, ticks, numerals, frame) at device resolution; rebuilt when the key changes
+    struct DialKey {
+        SpeedometerStyle style; QSize size; qreal dpr; Thresholds thresholds; SpeedometerColors colors; FrameStyle frame;
+        bool operator==(const DialKey& o) const { return style==o.style && size==o.size && qFuzzyCompare(dpr, o.dpr) && thresholds==o.thresholds && colors==o.colors && frame==o.frame; }
+    };
+    std::optional<DialKey> dialKey; QImage dialCache; // QImage so offscreen tile workers can draw it too
+    QImage tileFront, tileBack; QRegion tileRegion; bool tileBlitPending=false; // offscreen tile buffers; front = last finished frame, tileRegion = what it was invalidated for
+    // Dirty-region repaint: dynamic state as of the last invalidation; presentFrame repaints only the elements that differ
+    struct PaintedState { bool valid=false; QSize size; int zone=0; double value=0, volNorm=0, volatility=0, price=0; size_t trades=0; bool anomaly=false; QString anomalyLabel; } painted;
+    bool framePending=false; // a tick / volume update arrived since the last frame
+    static bool showRepaintRegions; // debug overlay tinting each repainted rect (ui/debug/repaint_regions)
     // Adaptive (EWMA-like) params
     double minInit=0.9995, maxInit=1.0005, minFactor=1.00001, maxFactor=0.99999;
     // Python-like scaling params (compressing window each tick)
@@ -235,6 +280,7 @@ private:
     double pyMinWidthPct=0.0001;       // at least price*0.01%
     // KiloCoder Like scaling params (hierarchical window analysis)
     int shortWindowSize=50, mediumWindowSize=200, longWindowSize=800;
+    WindowExtremes boundsExtremes, shortExtremes, mediumExtremes, longExtremes; // sliding min/max over history for updateBounds
     double shortAlpha=0.1, mediumAlpha=0.05, longAlpha=0.02;
     std::optional<double> globalMin, globalMax;
     std::optional<double> shortMin, shortMax, mediumMin, mediumMax, longMin, longMax;
@@ -253,5 +299,4 @@ private:
     // History retention and metadata
     double historyRetentionSec = 48*3600.0; // keep ~48h of raw points by default
     QString currentSourceKind = ""; // "TRADE" or "TICKER" for new points
-    quint64 seqCounter = 0;
 };
@@ -0,0 +1,44 @@
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include "DataWorker.h"
+
+// Raw WebSocket frame capture for offline replay (DataWorker::setReplaySource).
+// File layout: 8-byte magic "MDCAP001", then one record per text frame, little-endian, unpadded:
+//   qint64 recvMs (wall clock) | qint64 recvNs (monotonic, Profiler::nowNs) | quint8 provider | quint8 mode | quint32 len | len bytes UTF-8
+// The file is append-only; a record cut short by a crash is ignored on read.
+struct CapturedFrame {
+    qint64 recvMs = 0, recvNs = 0;
+    DataProvider provider = DataProvider::Binance; StreamMode mode = StreamMode::Trade;
+    QByteArray payload;
+};
+
+class FrameRecorder {
+public:
+    explicit FrameRecorder(const QString& path);
+    ~FrameRecorder();
+    bool isOpen() const { return file.isOpen(); }
+    QString errorString() const { return file.errorString(); }
+    QString path() const { return file.fileName(); }
+    // Thread-safe: pool shards on different threads share one recorder. Buffered; flushed every 64 KB and on close.
+    void append(DataProvider provider, StreamMode mode, const QString& text);
+    void append(const CapturedFrame& frame);
+    void flush();
+    quint64 frameCount() const { return frames; }
+private:
+    void writeLocked(qint64 recvMs, qint64 recvNs, DataProvider provider, StreamMode mode, const QByteArray& payload);
+    QFile file; QMutex mutex; QByteArray buf; quint64 frames = 0;
+};
+
+class FrameReader {
+public:
+    explicit FrameReader(const QString& path);
+    bool isOpen() const { return ok; }
+    QString errorString() const { return error; }
+    // Next frame in file order; false at end of file (or at a truncated record)
+    bool next(CapturedFrame& out);
+private:
+    QFile file; bool ok = false; QString error;
+};
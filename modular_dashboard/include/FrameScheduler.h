@@ -0,0 +1,42 @@
+#pragma once
+#include <QObject>
+#include <QThreadPool>
+#include <QTimer>
+#include <vector>
+
+class DynamicSpeedometerCharts;
+
+// One GUI-thread frame clock for every speedometer widget, replacing a render and a chart-cache timer per widget.
+// Each frame (frameInterval ms, precise timer):
+//   1. frameStarted() - ingest drains its tick rings here, so fresh ticks are painted in the same frame
+//   2. chart caches  - round-robin from where the last frame stopped: widgets whose cache is older than cacheInterval
+//                      are refreshed until cacheBudget (a quarter of the frame) is spent; at least one per frame
+//   3. present       - each widget pushes its chart series, or repaints its dial while the needle is moving.
+//                      With raster threads > 0, speedometer tiles that need a frame are drawn into per-tile images by a
+//                      worker pool plus the GUI thread, which waits for all of them (fork-join: widget state cannot
+//                      change while workers read it); the finished images are swapped in and only blitted by paintEvent
+// Widgets register in their constructor and unregister in their destructor.
+class FrameScheduler : public QObject {
+    Q_OBJECT
+public:
+    static FrameScheduler& instance();
+    void add(DynamicSpeedometerCharts* w);
+    void remove(DynamicSpeedometerCharts* w);
+    // Global budgets (PerformanceConfigDialog renderMs / cacheMs / rasterThreads, 0 = paint on the GUI thread)
+    void configure(int frameMs, int cacheMs, int rasterThreads = 0);
+    int rasterThreads() const { return rasterN; }
+    int frameInterval() const { return timer.interval(); }
+    int cacheInterval() const { return int(cacheNs / 1000000); }
+    // Start of the current frame (Profiler::nowNs clock): the time needles are retargeted and evaluated at
+    qint64 frameTimeNs() const { return frameNs; }
+signals:
+    void frameStarted();
+private:
+    FrameScheduler();
+    void onFrame();
+    void presentOffscreen();
+    struct Entry { DynamicSpeedometerCharts* w; qint64 cachedAtNs; };
+    QTimer timer; std::vector<Entry> entries; size_t cursor = 0;
+    qint64 cacheNs = 300 * 1000000LL, budgetNs = 4 * 1000000LL, frameNs = 0;
+    QThreadPool pool; int rasterN = 0; std::vector<DynamicSpeedometerCharts*> jobs;
+};
@@ -0,0 +1,112 @@
+#pragma once
+#include <QString>
+#include <QtGlobal>
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <vector>
+
+// Struct-of-arrays ring for widget price history: ts / value / seq live in three contiguous arrays (24 bytes per point),
+// and the source/provider/market labels are interned to small ids stored once per run of points that share them.
+// Storage grows on demand up to the capacity, then the oldest point is overwritten. Index 0 is the oldest point.
+// Points are expected in non-decreasing ts order (as pushed by updateData / replaceHistory): time lookups binary-search.
+class HistoryRing {
+public:
+    class View;
+    struct Tag {
+        quint8 source = 0, provider = 0, market = 0; // HistoryRing::label() ids; 0 = ""
+        bool operator==(const Tag& o) const { return source==o.source && provider==o.provider && market==o.market; }
+        bool operator!=(const Tag& o) const { return !(*this == o); }
+    };
+    // Process-wide label table (GUI thread); at most 255 distinct labels, later ones map to ""
+    static quint8 intern(const QString& label);
+    static QString label(quint8 id);
+    static Tag makeTag(const QString& source, const QString& provider, const QString& market) { return Tag{intern(source), intern(provider), intern(market)}; }
+
+    explicit HistoryRing(int capacity = 20000) : cap(size_t(std::max(1, capacity))) {}
+    // Keeps the newest points when shrinking
+    void setCapacity(int capacity);
+    int capacity() const { return int(cap); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { tsv.clear(); val.clear(); seqv.clear(); runs.clear(); head = 0; count = 0; first = next; }
+    void push(double ts, double value, quint64 seq, const Tag& tag);
+    void popFront(size_t n = 1);
+    double ts(size_t i) const { return tsv[phys(i)]; }
+    double value(size_t i) const { return val[phys(i)]; }
+    quint64 seq(size_t i) const { return seqv[phys(i)]; }
+    Tag tag(size_t i) const;
+    double backValue() const { return val[phys(count - 1)]; }
+    double backTs() const { return tsv[phys(count - 1)]; }
+    double frontTs() const { return tsv[head]; }
+    // Absolute indexes (never reused): oldest live point and one past the newest; index i <-> firstIndex() + i
+    quint64 firstIndex() const { return first; }
+    quint64 endIndex() const { return next; }
+    // Calls f(ts, value) for points [from, to) in order, walking each contiguous segment directly
+    template<typename F> void forEach(size_t from, size_t to, F&& f) const {
+        to = std::min(to, count);
+        for (size_t i=from; i<to; ) {
+            const size_t p = phys(i), n = std::min(to - i, tsv.size() - p);
+            for (size_t k=0; k<n; ++k) f(tsv[p + k], val[p + k]);
+            i += n;
+        }
+    }
+    template<typename F> void forEach(size_t from, F&& f) const { forEach(from, count, std::forward<F>(f)); }
+    // Index of the first point with ts >= t (size() if none): binary search over the (at most two) timestamp segments
+    size_t lowerBound(double t) const;
+    // Points with from <= ts < to, without copying
+    View window(double from, double to = std::numeric_limits<double>::infinity()) const;
+    View view() const;
+    // Heap bytes held (arrays at their current allocation plus tag runs)
+    size_t memoryBytes() const { return tsv.capacity() * sizeof(double) + val.capacity() * sizeof(double) + seqv.capacity() * sizeof(quint64) + runs.size() * sizeof(Run); }
+private:
+    struct Run { quint64 start; Tag tag; }; // absolute index of the first point carrying tag
+    size_t phys(size_t i) const { const size_t p = head + i; return p < tsv.size() ? p : p - tsv.size(); }
+    void linearize();
+    std::vector<double> tsv, val; std::vector<quint64> seqv;
+    std::deque<Run> runs;
+    size_t cap, head = 0, count = 0;
+    quint64 first = 0, next = 0; // absolute indexes of the oldest point and of the next push
+};
+
+// Read-only slice [b, e) of a HistoryRing (logical indexes, 0 = first point of the slice). Holds a pointer into the ring:
+// valid until the ring is next modified, so take it, read it and drop it within one GUI-thread pass.
+class HistoryRing::View {
+public:
+    View() = default;
+    size_t size() const { return e - b; }
+    bool empty() const { return e == b; }
+    double ts(size_t i) const { return ring->ts(b + i); }
+    double value(size_t i) const { return ring->value(b + i); }
+    double frontTs() const { return ts(0); }
+    double backTs() const { return ts(size() - 1); }
+    double backValue() const { return value(size() - 1); }
+    size_t lowerBound(double t) const { return std::clamp(ring->lowerBound(t), b, e) - b; }
+    View window(double from, double to = std::numeric_limits<double>::infinity()) const { return View(ring, b + lowerBound(from), b + lowerBound(to)); }
+    View mid(size_t from, size_t to) const { return View(ring, b + std::min(from, size()), b + std::min(to, size())); }
+    template<typename F> void forEach(size_t from, size_t to, F&& f) const { if (ring) ring->forEach(b + from, b + std::min(to, size()), std::forward<F>(f)); }
+    template<typename F> void forEach(F&& f) const { forEach(0, size(), std::forward<F>(f)); }
+private:
+    friend class HistoryRing;
+    View(const HistoryRing* r, size_t from, size_t to) : ring(r), b(from), e(std::max(from, to)) {}
+    const HistoryRing* ring = nullptr; size_t b = 0, e = 0;
+};
+
+inline HistoryRing::View HistoryRing::view() const { return View(this, 0, count); }
+inline HistoryRing::View HistoryRing::window(double from, double to) const { return View(this, lowerBound(from), lowerBound(to)); }
+
+// Min/max of the newest points of a HistoryRing, kept with two monotonic deques so each tick costs O(1) amortized
+// instead of a window rescan. Entries are keyed by absolute index, so points evicted from the ring (capacity,
+// retention, clear) simply fall out of the window; a query for an older start than the deques cover rebuilds once.
+class WindowExtremes {
+public:
+    // Brings the window up to the ring's newest point; window = last n points (0 = whole history)
+    void sync(const HistoryRing& h, int n);
+    double min() const { return mins.empty() ? 0.0 : mins.front().v; }
+    double max() const { return maxs.empty() ? 0.0 : maxs.front().v; }
+    void reset() { mins.clear(); maxs.clear(); validFrom = end = 0; }
+private:
+    struct E { quint64 i; double v; };
+    std::deque<E> mins, maxs; // values increasing / decreasing from front to back
+    quint64 validFrom = 0, end = 0; // every point in [validFrom, end) has been fed
+};
@@ -36,8 +36,8 @@ public:
     void setBackend(Backend b) { backend_ = b; }
     Backend backend() const { return backend_; }
 
-    // Collect current history from widgets into bundles
-    static QVector<HistoryBundle> collect(const QMap<QString, DynamicSpeedometerCharts*>& widgets);
+    // Collect every symbol's history from TimeSeriesStore into bundles (labels of each bundle = its latest point's)
+    static QVector<HistoryBundle> collect();
 
     // Save/load API
     // path: file path for JSONL or SQLite db path
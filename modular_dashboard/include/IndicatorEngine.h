@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Stateful indicators over a widget's processed sample series (RSI 14 Wilder, MACD 12/26/9, Bollinger 20/2).
+// Each new sample is one O(1) step (Wilder gain/loss, EMA states, rolling sum/sum of squares); the per-sample outputs are
+// kept so the chart series and the anomaly detector read the same cached state.
+// sync() recognises a refreshed series that only dropped samples from the front and/or appended new ones (matched by
+// timestamp+value) and steps just the new samples; indicator state then carries over the dropped part, as on a scrolling
+// chart. The last sample may also be restated with the same timestamp (a still-open aggregation bucket): its step is undone
+// and redone. Any other change (re-bucketed downsampling, scale switch) replays the series in one pass. Bench "indicators"
+// checks both paths against the batch RSI/MACD/Bollinger formulas.
+class IndicatorEngine {
+public:
+    static constexpr int kRsiPeriod = 14, kMacdFast = 12, kMacdSlow = 26, kMacdSignal = 9, kBbPeriod = 20, kZWindow = 50;
+    static constexpr double kBbK = 2.0;
+    // Returns true when the series was replayed from scratch rather than extended
+    bool sync(const std::vector<double>& ts, const std::vector<double>& values);
+    void reset();
+    size_t size() const { return val.size(); }
+    const std::vector<double>& values() const { return val; }
+    // Empty when the current series is shorter than the indicator needs (same thresholds as the batch formulas)
+    bool hasRSI() const { return val.size() >= size_t(kRsiPeriod + 1); }
+    bool hasMACD() const { return val.size() >= size_t(kMacdSlow + kMacdSignal + 2); }
+    bool hasBollinger() const { return val.size() >= size_t(kBbPeriod); }
+    const std::vector<double>& rsi() const { return rsiOut; }
+    const std::vector<double>& macd() const { return macdOut; }
+    const std::vector<double>& signal() const { return signalOut; }
+    const std::vector<double>& bbUpper() const { return upperOut; }
+    const std::vector<double>& bbLower() const { return lowerOut; }
+private:
+    void step(double t, double v);
+    void dropFront(size_t k);
+    std::vector<double> tsv, val, rsiOut, macdOut, signalOut, upperOut, lowerOut;
+    struct State {
+        size_t fed = 0; // samples stepped since reset (drives warm-up)
+        double gain = 0.0, loss = 0.0, prevV = 0.0;
+        double emaFast = 0.0, emaSlow = 0.0, emaSignal = 0.0;
+        size_t bbPos = 0; double bbSum = 0.0, bbSumSq = 0.0;
+    };
+    State st, beforeLast; double bbReplaced = 0.0; bool canRestate = false; // one-step undo for a restated last sample
+    std::vector<double> bbWin = std::vector<double>(size_t(kBbPeriod), 0.0);
+};
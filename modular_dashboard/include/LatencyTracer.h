@@ -0,0 +1,54 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QVector>
+#include <array>
+#include "SymbolRegistry.h"
+
+struct TickRecord;
+
+// Log-bucketed latency histogram (~8% resolution from 1 us to ~5 min), fixed size, no allocation on add
+class LatencyHistogram {
+public:
+    static constexpr int Buckets = 256;
+    void add(double ms);
+    void merge(const LatencyHistogram& o);
+    void reset() { *this = LatencyHistogram(); }
+    quint64 count() const { return n; }
+    double max() const { return maxMs; }
+    // Upper edge of the bucket holding the q-quantile (clamped to the observed max)
+    double quantile(double q) const;
+private:
+    std::array<quint32, Buckets> counts{}; quint64 n = 0; double maxMs = 0.0;
+};
+
+// End-to-end tick latency, GUI thread only. Stages per tick (TickRecord path: batch or ring delivery):
+//   Network  = receive wall time - exchange timestamp (T/E/ts; includes exchange/local clock skew)
+//   Parse    = socket receive -> worker buffered the record (parse + symbol lookup + handoff push)
+//   Dispatch = worker buffered -> DynamicSpeedometerCharts::updateData (batch timer / ring drain / queued signal)
+//   Paint    = oldest unpainted updateData -> next paintEvent of that widget
+//   EndToEnd = paint wall time - exchange timestamp of the value on screen
+// Histograms are kept per symbol and over all symbols; summaries feed the Profiler dump and the latency panel.
+class LatencyTracer {
+public:
+    enum Stage { Network, Parse, Dispatch, Paint, EndToEnd, StageCount };
+    struct Summary { quint64 count = 0; double p50 = 0.0, p99 = 0.0, max = 0.0; };
+    static LatencyTracer& instance();
+    static const char* stageName(int stage);
+    void setEnabled(bool on);
+    bool isEnabled() const { return enabled; }
+    // Stamp: the record was just applied to its widget
+    void onTickApplied(const TickRecord& t);
+    // Stamp: the widget for id painted
+    void onPaint(SymbolId id);
+    Summary summary(int stage, SymbolId id = InvalidSymbol) const; // InvalidSymbol = all symbols
+    QVector<SymbolId> symbols() const;
+    void reset();
+    // Pushes per-stage p50/p99/max (and per-symbol end-to-end p99) into Profiler samples; throttled to once per 5 s
+    void sampleToProfiler();
+private:
+    LatencyTracer() = default;
+    struct PerSymbol { std::array<LatencyHistogram, StageCount> h; qint64 pendingNs = 0; double shownExchangeMs = 0.0; };
+    static Summary summarize(const LatencyHistogram& h);
+    SymbolVector<PerSymbol> perSymbol; std::array<LatencyHistogram, StageCount> total;
+    bool enabled = false; QElapsedTimer sampleClock;
+};
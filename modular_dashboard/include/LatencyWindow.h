@@ -0,0 +1,18 @@
+#pragma once
+#include <QMainWindow>
+
+class QTableWidget; class QCheckBox; class QTimer;
+
+// Live view of LatencyTracer: p50 / p99 / max per stage, all symbols first, then one row per traced symbol
+class LatencyWindow : public QMainWindow {
+    Q_OBJECT
+public:
+    explicit LatencyWindow(QWidget* parent=nullptr);
+protected:
+    void showEvent(QShowEvent* e) override;
+    void hideEvent(QHideEvent* e) override;
+private slots:
+    void refresh();
+private:
+    QTableWidget* table; QCheckBox* chkEnabled; QTimer* refreshTimer;
+};
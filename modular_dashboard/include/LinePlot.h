@@ -0,0 +1,45 @@
+#pragma once
+#include <QColor>
+#include <QPolygonF>
+#include <QRect>
+#include <QString>
+#include <vector>
+
+class QPainter;
+
+// QPainter line chart for the widget's line_chart / btc_ratio views (replaces a QChartView with 7 QLineSeries and 4 axes).
+// Traces keep plain y values (x = sample index) copied from the widget's cached buffers. setTrace() matches the new series
+// against the previous one: samples dropped from the front are erased, the overlap is kept and only restated samples
+// (up to kTail at the end, e.g. LTTB's re-picked last closed bucket and the open bucket, plus a restated first sample)
+// and the new tail are copied. That holds for decimated series too, as long as their buckets are anchored (Decimator
+// buckets are time-aligned, step sampling is anchored to the ring index); a re-bucketing (plot width, scale or method
+// change) is a full copy. The pixel polyline follows the same way (x stays in sample units and is scaled by the
+// painter), so it is remapped in full only when the plot area or the trace's axis range changes.
+// Price and Bollinger share the left axis (range of the price trace), RSI has a fixed 0..100 axis and MACD/signal share
+// their own range; all are overlaid on one plot area like the QtCharts layout was.
+class LinePlot {
+public:
+    enum Trace { Price, BbUpper, BbLower, Rsi, Macd, Signal, TraceCount };
+    static constexpr size_t kTail = 2; // trailing samples of the overlap setTrace() accepts as restated
+    struct Style { QColor background, grid, text, line; bool gridLines = true, axisLabels = false; };
+    void setTrace(Trace t, const std::vector<double>& v);
+    void hide(Trace t); // releases the trace's buffers
+    void clear();       // all traces (chart views left)
+    void setTitle(const QString& t) { title = t; }
+    void setStyle(const Style& s) { style = s; }
+    // Plot area inside the widget rect (room for title and axis labels); its width is the decimation target
+    QRect plotArea(const QRect& widgetRect) const;
+    void paint(QPainter& p, const QRect& widgetRect);
+    size_t memoryBytes() const; // sample + polyline buffers
+private:
+    enum Axis { AxisPrice, AxisRsi, AxisMacd, AxisCount };
+    struct Range { double lo = 0.0, hi = 1.0; bool operator==(const Range& o) const { return lo==o.lo && hi==o.hi; } };
+    struct TraceData {
+        std::vector<double> y; QPolygonF px; // px: (base + i, pixel y) for y[0..px.size())
+        double base = 0.0;                    // running index of y[0], so a front drop leaves the kept points in place
+        Range range; QRect area; bool visible = false; int pxStale = 0; // px[0..pxStale) to remap (restated first sample)
+    };
+    static Axis axisOf(Trace t) { return t==Rsi ? AxisRsi : (t==Macd || t==Signal) ? AxisMacd : AxisPrice; }
+    Range rangeOf(Axis a) const;
+    TraceData traces[TraceCount]; QString title; Style style;
+};
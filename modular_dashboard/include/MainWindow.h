@@ -5,14 +5,19 @@
 #include <QHash>
 #include <QGridLayout>
 #include <QStringList>
+#include <memory>
 #include "DataWorker.h"
+#include "DataWorkerPool.h"
+#include "TickConflator.h"
 #include "DynamicSpeedometerCharts.h"
 #include "ThemeManager.h"
 #include "MarketAnalyzer.h"
 class MarketOverviewWindow;
 class MultiCompareWindow;
+class LatencyWindow;
 
 class QThread;
+class QTimer;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -26,10 +31,12 @@ private slots:
     void openPerformanceDialog();
     void openThemeDialog();
     void handleData(const QString& currency, double price, double timestamp);
+    void handleTickBatch(const TickBatch& batch);
+    void drainTickRings();
     void onRequestRename(const QString& currentTicker);
     void showAbout();
 private:
-    struct PerfSettings { int animMs; int renderMs; int cacheMs; int volWindow; int maxPts; int rawCache; };
+    struct PerfSettings { int animMs; int renderMs; int cacheMs; int volWindow; int maxPts; int rawCache; int batchMs; bool tickRing; int ringPolicy; int shards; int shardThreads; bool conflate; int rasterThreads; };
     PerfSettings readPerfSettings();
     void writePerfSettings(const PerfSettings& s);
     void loadSettingsAndApply();
@@ -39,6 +46,8 @@ private:
     void applyThresholdsToAll(bool enabled, double warnValue, double dangerValue);
     void onThemeChanged(const ThemeManager::ColorTheme& theme);
     void reflowGrid();
+    bool applyTicks(const QVector<TickRecord>& ticks);
+    void applyTickRingSettings(const PerfSettings& s);
     // Pseudo tickers support
     bool isPseudo(const QString& name) const { return name.startsWith("@"); }
     enum class PseudoKind { None, Avg, AltAvg, Median, Spread, Diff, Top10Avg, VolAvg, BtcDom, ZScore };
@@ -53,18 +62,28 @@ private:
     QGridLayout* gridLayout = nullptr;
     int gridCols = 4;
     int gridRows = 3; // informational, placement uses gridCols
-    DataWorker* dataWorker=nullptr; QThread* workerThread=nullptr; double btcPrice=0.0; StreamMode streamMode=StreamMode::Trade; QStringList currentCurrencies; ThemeManager* themeManager;
+    DataWorkerPool* dataPool=nullptr; StreamMode streamMode=StreamMode::Trade; QStringList currentCurrencies; ThemeManager* themeManager;
     // Aggregation maps
-    QHash<QString,double> normalizedBySymbol; // 0..100 per real symbol
-    QHash<QString,double> volBySymbol; // volatility % per real symbol
+    SymbolVector<double> normalizedById; // 0..100 per real symbol
+    SymbolVector<double> volById; // volatility % per real symbol
+    SymbolId btcId = InvalidSymbol;
+    // Symbol id -> widget cache for the tick path; entries are validated against the widget's own id and refilled from widgets
+    QVector<QPointer<DynamicSpeedometerCharts>> widgetById;
+    DynamicSpeedometerCharts* widgetFor(SymbolId id);
     // Compare workers (Binance + Bybit Linear/Spot)
     DataWorker* cmpBinance=nullptr; QThread* cmpBinanceThread=nullptr;
     DataWorker* cmpBybitLinear=nullptr; QThread* cmpBybitLinearThread=nullptr;
     DataWorker* cmpBybitSpot=nullptr; QThread* cmpBybitSpotThread=nullptr;
     QSet<QString> cmpSymsBinance, cmpSymsBybitLinear, cmpSymsBybitSpot;
-    QHash<QString,double> binancePrice, bybitLinearPrice, bybitSpotPrice;
+    SymbolVector<double> binancePrice, bybitLinearPrice, bybitSpotPrice;
     // Market overview analyzer and window
     MarketAnalyzer* marketAnalyzer = nullptr;
     MarketOverviewWindow* marketWindow = nullptr;
     MultiCompareWindow* compareWindow = nullptr;
+    LatencyWindow* latencyWindow = nullptr;
+    // Tick handoff rings (one per compare worker; the main feed's per-shard rings live in dataPool) and the GUI-side drain
+    std::unique_ptr<TickRing> cmpBinanceRing, cmpBybitLinearRing, cmpBybitSpotRing;
+    QVector<TickRecord> drainBuf; // drainTickRings runs on FrameScheduler::frameStarted
+    // Per-frame conflation of applied ticks (perf/conflate)
+    bool conflateTicks = true; TickConflator conflator; QVector<TickRecord> conflateBuf;
 };
@@ -3,7 +3,8 @@
 #include <QString>
 #include <QSet>
 #include <QMap>
-#include <deque>
+#include "SymbolRegistry.h"
+#include "HistoryRing.h"
 
 struct MarketSnapshot {
     // Index in [-1,1]: -1 strong drop, 0 neutral/sideways, +1 strong rise
@@ -31,14 +32,14 @@ public:
     const Config& config() const { return cfg; }
     // Called from UI thread for each symbol update
     void updateSymbol(const QString& symbol, double ts, double normalized01_100, double volatilityPct);
+    void updateSymbol(SymbolId id, double ts, double normalized01_100, double volatilityPct);
     // Clear all time series
     void reset();
 signals:
     void snapshotUpdated(const MarketSnapshot& snapshot);
 private:
-    struct Sample { double t; double v; };
     struct Series {
-        std::deque<Sample> points; // normalized [0..100]
+        HistoryRing points{1 << 20}; // normalized [0..100], time-ordered; storage grows with the window
         // Running stats for slope (EMA mean/var)
         double emaSlope = 0.0;
         double emaVar = 0.0;
@@ -47,10 +48,11 @@ private:
         double lastV = 50.0;
         double lastVolatility = 0.0; // %
     };
-    QMap<QString, Series> series; // key upper symbol
+    SymbolVector<Series> series; // indexed by symbol id
     Config cfg;
+    QSet<SymbolId> excludedIds; SymbolId btcId = InvalidSymbol; // resolved from cfg in setConfig
     // Helpers
-    static double regressionSlope(const std::deque<Sample>& pts);
-    void trimOld(std::deque<Sample>& pts, double now, int windowSec);
+    static double regressionSlope(const HistoryRing::View& pts);
+    void trimOld(HistoryRing& pts, double now, int windowSec);
     void computeAndEmit();
 };
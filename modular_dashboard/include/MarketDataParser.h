@@ -0,0 +1,31 @@
+#pragma once
+#include <QByteArrayView>
+#include <QStringView>
+#include <QString>
+#include "DataWorker.h"
+
+class QJsonObject;
+
+// Hot-path parser for Binance combined-stream and Bybit v5 public frames.
+// scan() walks the frame once in place (UTF-8 bytes or the UTF-16 buffer of a QString), matches only the
+// field names we consume and converts numbers with std::from_chars; it never allocates. Anything it does
+// not recognise (control/ack frames, unexpected layout) is reported as Fallback so the caller can use
+// fromJson(), which is the reference QJsonDocument implementation of the same extraction.
+struct MarketTick {
+    double price = 0.0;
+    double timestamp = 0.0; // seconds
+    double volBase = 0.0, volQuote = 0.0, volIncr = 0.0;
+    // Trade frames batching several trades (Bybit publicTrade): price/timestamp are the last trade, volIncr the summed size,
+    // open/high/low span the batch. Single-trade and ticker frames leave open/high/low at 0 (= price).
+    double open = 0.0, high = 0.0, low = 0.0; int trades = 1;
+    char symbol[24] = {}; int symbolLen = 0; // raw exchange symbol, e.g. BTCUSDT
+    QString currency() const { return QString::fromLatin1(symbol, symbolLen > 4 ? symbolLen - 4 : 0).toUpper(); }
+};
+
+class MarketDataParser {
+public:
+    enum class Result { Tick, Skip, Fallback };
+    static Result scan(QByteArrayView utf8, DataProvider provider, StreamMode mode, MarketTick& out);
+    static Result scan(QStringView text, DataProvider provider, StreamMode mode, MarketTick& out);
+    static Result fromJson(const QJsonObject& root, DataProvider provider, StreamMode mode, MarketTick& out);
+};
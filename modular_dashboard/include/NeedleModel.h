@@ -0,0 +1,26 @@
+#pragma once
+#include <QtGlobal>
+
+// Speedometer needle as a critically damped spring (0..100 scale). setTarget keeps the current position and velocity,
+// so a burst of ticks bends the motion instead of restarting an easing curve from zero speed. The state is solved in
+// closed form at the caller's clock (FrameScheduler::frameTimeNs), so nothing runs between paints and any frame
+// interval gives the same trajectory.
+class NeedleModel {
+public:
+    // Time for a step to settle within 1% of its size (Performance settings "Animation (ms)")
+    void setSettleMs(int ms);
+    void setTarget(double target, qint64 nowNs);
+    // Jumps to v and stops
+    void snap(double v) { x = tgt = v; vel = 0.0; rest = true; }
+    // Position at nowNs without changing the state (times before the last advance give that position)
+    double value(qint64 nowNs) const;
+    // Moves the state to nowNs; stops once within 1e-3 of the target at near-zero speed (paint calls this)
+    void advance(qint64 nowNs);
+    double target() const { return tgt; }
+    bool moving() const { return !rest; }
+private:
+    static void solve(double w, double t, double& e, double& v);
+    double x = 0.0, vel = 0.0, tgt = 0.0; // position, velocity (units/s), target
+    double omega = 6.64 / 0.4;            // natural frequency: 1 - (1 + wT) e^-wT = 0.99 at wT ~ 6.64
+    qint64 t0 = 0; bool rest = true;
+};
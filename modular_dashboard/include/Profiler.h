@@ -5,26 +5,36 @@
 #include <QFile>
 #include <QTextStream>
 #include <QCoreApplication>
+#include <QMutex>
+#include <chrono>
 
 class Profiler {
 public:
     static void setEnabled(bool en) { enabled() = en; }
     static bool isEnabled() { return enabled(); }
+    // Monotonic clock shared by all threads (for cross-thread latency measurements)
+    static qint64 nowNs() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
     class Scope {
     public:
         Scope(const char* name) : _name(name) { if (Profiler::isEnabled()) _timer.start(); }
         ~Scope() {
             if (!Profiler::isEnabled()) return;
             qint64 ns = _timer.nsecsElapsed();
-            totals()[_name] += ns;
-            counts()[_name] += 1;
+            { QMutexLocker lock(&mutex()); totals()[_name] += ns; counts()[_name] += 1; }
             maybeDump();
         }
     private:
         const char* _name; QElapsedTimer _timer;
     };
+    // Value samples (batch sizes, latencies, ...): dumped as count/avg/max
+    static void sample(const char* name, double value) {
+        if (!isEnabled()) return;
+        { QMutexLocker lock(&mutex()); auto& s = samples()[name]; s.count++; s.sum += value; if (s.count==1 || value > s.max) s.max = value; }
+        maybeDump();
+    }
     static void maybeDump() {
         if (!isEnabled()) return;
+        QMutexLocker lock(&mutex());
         qint64 now = dumpTimer().elapsed();
         if (now - lastDumpMs() < 5000) return; // dump each 5 seconds
         dumpToFile(); lastDumpMs() = now;
@@ -41,13 +51,21 @@ public:
                 out << it.key() << ": calls=" << c << ", total_ms=" << QString::number(totalMs,'f',3)
                     << ", avg_ms=" << QString::number(avgMs,'f',3) << '\n';
             }
+            for (auto it = samples().cbegin(); it != samples().cend(); ++it) {
+                const auto& s = it.value(); double avg = s.count>0 ? s.sum / double(s.count) : 0.0;
+                out << it.key() << ": samples=" << s.count << ", avg=" << QString::number(avg,'f',3)
+                    << ", max=" << QString::number(s.max,'f',3) << '\n';
+            }
             out << '\n';
         }
     }
 private:
+    struct SampleStat { qint64 count = 0; double sum = 0.0; double max = 0.0; };
     static bool& enabled() { static bool e = false; return e; }
+    static QMutex& mutex() { static QMutex m; return m; }
     static QMap<QString,qint64>& totals() { static QMap<QString,qint64> t; return t; }
     static QMap<QString,qint64>& counts() { static QMap<QString,qint64> c; return c; }
+    static QMap<QString,SampleStat>& samples() { static QMap<QString,SampleStat> s; return s; }
     static qint64& lastDumpMs() { static qint64 v = 0; return v; }
     static QElapsedTimer& dumpTimer() { static QElapsedTimer t = [](){ QElapsedTimer z; z.start(); return z; }(); return t; }
 };
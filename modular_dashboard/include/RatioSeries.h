@@ -0,0 +1,28 @@
+#pragma once
+#include "HistoryRing.h"
+
+class TimePyramid;
+
+// BTC-ratio series derived on demand instead of a second history ring per widget: each price point is divided by the
+// BTC price as of its timestamp (last BTC raw point with ts <= it; points older than the BTC ring fall back to the BTC
+// pyramid's close at its resolution; points with no BTC price at all are skipped). The joined series is materialized
+// only while something reads it (btc_ratio view) and kept current incrementally: sync() joins just the points appended
+// since the last call and drops the ones the price history evicted; release() frees it when the view is left.
+// Points newer than the last BTC tick use that tick's price; they are not restated when an older BTC tick arrives late.
+class RatioSeries {
+public:
+    struct Reference { const HistoryRing* raw = nullptr; const TimePyramid* coarse = nullptr; };
+    // unit: the priced symbol is BTC itself (ratio 1 for every point)
+    const HistoryRing& sync(const HistoryRing& src, const Reference& btc, bool unit);
+    void release();
+    bool isLive() const { return live; }
+    // Bumped whenever the series is rebuilt or released: absolute indexes into it restart, so incremental readers
+    // (the ratio Decimator) must start over
+    quint64 epoch() const { return gen; }
+    size_t memoryBytes() const { return out.memoryBytes(); }
+private:
+    HistoryRing out{20000};
+    quint64 fed = 0; // absolute index in the price history up to which points were joined
+    quint64 gen = 0;
+    bool live = false;
+};
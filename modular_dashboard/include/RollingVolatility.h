@@ -0,0 +1,33 @@
+#pragma once
+#include "HistoryRing.h"
+#include <deque>
+
+// Per-widget volatility estimate (in %) over the last N history points, fed incrementally from the HistoryRing so a tick
+// costs O(1) amortized instead of re-copying the window:
+//  - MeanAbsReturn: mean |p[i]/p[i-1] - 1| over the window (the original updateVolatility figure), running sum
+//  - Ewma: sqrt of the exponentially weighted mean of squared returns, alpha = 2/(N+1)
+//  - Parkinson: range estimator over blocks of kBlock consecutive points, ln(high/low)^2 / (4 ln 2), scaled per point;
+//    a point with a noted trade range (conflated / batched trades) contributes its high/low instead of only its close
+// Points leave the window by absolute index, so ring trims/evictions need no notification; reset() after a history replace.
+class RollingVolatility {
+public:
+    enum class Kind { MeanAbsReturn, Ewma, Parkinson };
+    static constexpr int kBlock = 16;
+    void setKind(Kind k) { if (k != kind) { kind = k; restart(); } }
+    Kind currentKind() const { return kind; }
+    double update(const HistoryRing& h, int window);
+    // Trade range folded into the point at absolute ring index i (call before the update() that feeds it)
+    void noteRange(quint64 i, double high, double low) { if (high > low) ranges.push_back(Range{i, high, low}); }
+    void reset() { restart(); ranges.clear(); }
+private:
+    void restart() { terms.clear(); sum = 0.0; evicted = 0; validFrom = end = 0; ewmaVar = 0.0; ewmaN = 0; blockN = 0; } // keeps ranges
+    void feed(const HistoryRing& h, quint64 i, double alpha);
+    struct Term { quint64 key; double v; }; // key = first point index the term depends on
+    Kind kind = Kind::MeanAbsReturn;
+    std::deque<Term> terms; double sum = 0.0; quint64 evicted = 0;
+    quint64 validFrom = 0, end = 0; // every point in [validFrom, end) has been fed
+    double ewmaVar = 0.0; quint64 ewmaN = 0;
+    quint64 blockStart = 0; double blockHi = 0.0, blockLo = 0.0; int blockN = 0;
+    struct Range { quint64 i; double hi, lo; };
+    std::deque<Range> ranges; // by index, trimmed to the window
+};
@@ -0,0 +1,70 @@
+#pragma once
+#include <QString>
+#include <QHash>
+#include <QVector>
+#include <QReadWriteLock>
+#include <cmath>
+#include <vector>
+
+// Dense integer ids for currency codes ("BTC", "ETH", also pseudo names like "@AVG").
+// Ids are assigned once (at subscription / widget creation time), never reused, and are safe to use as array indexes
+// on the hot path; QString names are only needed at the UI and persistence edges.
+using SymbolId = int;
+constexpr SymbolId InvalidSymbol = -1;
+
+class SymbolRegistry {
+public:
+    static SymbolRegistry& instance();
+    // Thread-safe; name is expected uppercase (as produced by the workers)
+    SymbolId intern(const QString& name);
+    SymbolId find(const QString& name) const;
+    QString name(SymbolId id) const;
+    int size() const;
+private:
+    SymbolRegistry() = default;
+    mutable QReadWriteLock lock;
+    QHash<QString, SymbolId> ids;
+    QVector<QString> names;
+};
+
+// Allocation-free lookup of raw exchange symbols ("BTCUSDT") to ids for the parser hot path.
+// Owned by one worker, rebuilt when its subscription list changes.
+class SymbolIndex {
+public:
+    void clear() { slots.assign(slots.size(), Slot{}); used = 0; }
+    void insert(const QString& raw, SymbolId id);
+    SymbolId find(const char* raw, int len) const {
+        if (slots.empty() || len <= 0 || len >= int(sizeof(Slot::key))) return InvalidSymbol;
+        const size_t mask = slots.size() - 1;
+        for (size_t i = hash(raw, len) & mask; ; i = (i + 1) & mask) {
+            const Slot& s = slots[i];
+            if (s.id == InvalidSymbol) return InvalidSymbol;
+            if (s.len == len && equalsUpper(s.key, raw, len)) return s.id;
+        }
+    }
+private:
+    struct Slot { char key[24] = {}; int len = 0; SymbolId id = InvalidSymbol; };
+    static char up(char c) { return (c >= 'a' && c <= 'z') ? char(c - 'a' + 'A') : c; }
+    static bool equalsUpper(const char* key, const char* raw, int len) { for (int i=0; i<len; ++i) if (key[i] != up(raw[i])) return false; return true; }
+    static size_t hash(const char* s, int len) { quint32 h = 2166136261u; for (int i=0; i<len; ++i) { h ^= quint8(up(s[i])); h *= 16777619u; } return h; }
+    void rehash(size_t capacity);
+    std::vector<Slot> slots; int used = 0;
+};
+
+// Dense per-symbol storage indexed by SymbolId (replaces QHash<QString,T> on hot paths)
+template<typename T>
+class SymbolVector {
+public:
+    bool contains(SymbolId id) const { return id >= 0 && id < present.size() && present[id]; }
+    T value(SymbolId id, const T& def = T()) const { return contains(id) ? data[id] : def; }
+    const T* find(SymbolId id) const { return contains(id) ? &data[id] : nullptr; } // no copy, for large T
+    T& operator[](SymbolId id) { if (id >= data.size()) { data.resize(id + 1); present.resize(id + 1, false); } if (!present[id]) { present[id] = true; ++n; } return data[id]; }
+    void remove(SymbolId id) { if (contains(id)) { present[id] = false; data[id] = T(); --n; } }
+    void clear() { data.clear(); present.clear(); n = 0; }
+    bool isEmpty() const { return n == 0; }
+    int count() const { return n; }
+    template<typename F> void forEach(F&& f) const { for (int i=0; i<data.size(); ++i) if (present[i]) f(SymbolId(i), data[i]); }
+    template<typename F> void forEachMutable(F&& f) { for (int i=0; i<data.size(); ++i) if (present[i]) f(SymbolId(i), data[i]); }
+private:
+    QVector<T> data; QVector<bool> present; int n = 0;
+};
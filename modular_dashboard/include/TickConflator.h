@@ -0,0 +1,26 @@
+#pragma once
+#include <QVector>
+#include "DataWorker.h"
+
+// GUI-side per-frame conflation: every record of a symbol drained in one frame is folded into one (latest price, OHLC,
+// summed trade volume, tick count; see TickRecord::merge), so widget work scales with symbols x frame rate instead of
+// the raw message rate. Output keeps the order in which symbols first appeared. GUI thread only; no allocation once warm.
+class TickConflator {
+public:
+    void fold(const QVector<TickRecord>& in, QVector<TickRecord>& out) {
+        out.clear(); ++generation;
+        for (const TickRecord& r : in) {
+            if (r.symbol == InvalidSymbol) continue;
+            if (r.symbol >= slot.size()) { slot.resize(r.symbol + 1); seen.resize(r.symbol + 1, 0); }
+            if (seen[r.symbol] != generation) { seen[r.symbol] = generation; slot[r.symbol] = int(out.size()); out.append(r); }
+            else { out[slot[r.symbol]].merge(r); ++conflated; }
+        }
+        ticksIn += quint64(in.size()); ticksOut += quint64(out.size());
+    }
+    quint64 inTotal() const { return ticksIn; }
+    quint64 outTotal() const { return ticksOut; }
+    quint64 conflatedTotal() const { return conflated; }
+private:
+    QVector<int> slot; QVector<quint32> seen; quint32 generation = 0;
+    quint64 ticksIn = 0, ticksOut = 0, conflated = 0;
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+// Bounded lock-free queue with per-slot sequence numbers (Vyukov): single producer (tryPush does not CAS), any number of
+// poppers (tryPop does), so the producer may also pop (evict the oldest) while the consumer drains. Never allocates after
+// construction.
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(int capacityPow2) : slots(size_t(capacityPow2)), mask(size_t(capacityPow2) - 1) {
+        for (size_t i=0; i<slots.size(); ++i) slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+    bool tryPush(const T& v) {
+        const size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Slot& s = slots[pos & mask];
+        if (s.seq.load(std::memory_order_acquire) != pos) return false; // full
+        s.value = v; s.seq.store(pos + 1, std::memory_order_release);
+        enqueuePos.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    bool tryPop(T& out) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& s = slots[pos & mask];
+            const intptr_t dif = intptr_t(s.seq.load(std::memory_order_acquire)) - intptr_t(pos + 1);
+            if (dif == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { out = s.value; s.seq.store(pos + mask + 1, std::memory_order_release); return true; }
+            } else if (dif < 0) return false; // empty
+            else pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    size_t sizeApprox() const { const size_t e = enqueuePos.load(std::memory_order_acquire), d = dequeuePos.load(std::memory_order_acquire); return e > d ? e - d : 0; }
+    int capacity() const { return int(mask + 1); }
+private:
+    struct Slot { std::atomic<size_t> seq{0}; T value{}; };
+    std::vector<Slot> slots; const size_t mask;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+};
+
+// Tick handoff between one DataWorker thread (producer) and the GUI frame tick (consumer), with an overflow policy
+// and counters. Rec must expose an integer symbol id and merge(newer) (see TickRecord) and be default-constructible.
+// Conflated records wait in a per-SymbolId slot table (reserved for kReservedSymbols ids; it grows only when a higher id
+// is first conflated) and are flushed in the order their symbols were first conflated: only per-symbol order is kept,
+// records of different symbols may reach the consumer in another order than they were pushed.
+template<typename Rec>
+class TickRingT {
+public:
+    enum class Policy { DropOldest, Conflate, Block };
+    struct Stats { quint64 pushed=0, dropped=0, conflated=0, highWater=0; };
+    static constexpr int kReservedSymbols = 512;
+    explicit TickRingT(int capacityPow2 = 8192, Policy p = Policy::DropOldest) : ring(capacityPow2), policy(int(p)) {
+        slot.resize(kReservedSymbols); queued.resize(kReservedSymbols, 0); order.reserve(kReservedSymbols);
+    }
+    void setPolicy(Policy p) { policy.store(int(p), std::memory_order_relaxed); }
+    Policy currentPolicy() const { return Policy(policy.load(std::memory_order_relaxed)); }
+    void setBlockTimeoutMs(int ms) { blockTimeoutMs.store(ms, std::memory_order_relaxed); }
+    // Unblocks a producer waiting under Block (shutdown)
+    void close() { closed.store(true, std::memory_order_release); }
+    int capacity() const { return ring.capacity(); }
+
+    // Producer thread only. Returns true while conflated records are still waiting for room (call flushPending later).
+    bool push(const Rec& r) {
+        pushed.fetch_add(1, std::memory_order_relaxed);
+        switch (currentPolicy()) {
+        case Policy::DropOldest: {
+            Rec old; while (!ring.tryPush(r)) { if (ring.tryPop(old)) dropped.fetch_add(1, std::memory_order_relaxed); }
+            break; }
+        case Policy::Conflate: {
+            if (flushPending() || !ring.tryPush(r)) { conflate(r); noteHighWater(); return true; }
+            break; }
+        case Policy::Block: {
+            if (ring.tryPush(r)) break;
+            QElapsedTimer t; t.start();
+            while (!ring.tryPush(r)) {
+                if (closed.load(std::memory_order_acquire) || t.elapsed() > blockTimeoutMs.load(std::memory_order_relaxed)) { dropped.fetch_add(1, std::memory_order_relaxed); break; }
+                QThread::usleep(200);
+            }
+            break; }
+        }
+        noteHighWater();
+        return false;
+    }
+    // Producer thread only: moves conflated records into the ring while there is room; true if some remain
+    bool flushPending() {
+        for (; flushed < order.size(); ++flushed) { const int id = order[flushed]; if (!ring.tryPush(slot[size_t(id)])) return true; queued[size_t(id)] = 0; }
+        order.clear(); flushed = 0;
+        return false;
+    }
+    // Consumer thread: appends up to max records to out, returns how many were taken
+    int drain(QVector<Rec>& out, int max = INT_MAX) {
+        int n = 0; Rec r; while (n < max && ring.tryPop(r)) { out.append(r); ++n; }
+        return n;
+    }
+    Stats stats() const {
+        Stats s; s.pushed = pushed.load(std::memory_order_relaxed); s.dropped = dropped.load(std::memory_order_relaxed);
+        s.conflated = conflated.load(std::memory_order_relaxed); s.highWater = highWater.load(std::memory_order_relaxed); return s;
+    }
+private:
+    // Keep the latest price per symbol; trade volume and OHLC keep accumulating so nothing is lost from volume overlays
+    void conflate(const Rec& r) {
+        if (r.symbol < 0) return;
+        const size_t id = size_t(r.symbol);
+        if (id >= slot.size()) { slot.resize(std::max(id + 1, slot.size() * 2)); queued.resize(slot.size(), 0); }
+        if (!queued[id]) { queued[id] = 1; slot[id] = r; order.push_back(int(id)); return; }
+        slot[id].merge(r);
+        conflated.fetch_add(1, std::memory_order_relaxed);
+    }
+    void noteHighWater() { const quint64 sz = quint64(ring.sizeApprox()); if (sz > highWater.load(std::memory_order_relaxed)) highWater.store(sz, std::memory_order_relaxed); }
+    BoundedQueue<Rec> ring;
+    // Producer-only conflation state: slot/queued by symbol id, order = symbols waiting, flushed = how many already pushed
+    std::vector<Rec> slot; std::vector<quint8> queued; std::vector<int> order; size_t flushed = 0;
+    std::atomic<int> policy; std::atomic<int> blockTimeoutMs{100}; std::atomic<bool> closed{false};
+    std::atomic<quint64> pushed{0}, dropped{0}, conflated{0}, highWater{0};
+};
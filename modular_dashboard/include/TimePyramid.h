@@ -0,0 +1,38 @@
+#pragma once
+#include <QtGlobal>
+#include <deque>
+#include <vector>
+
+// Per-symbol multi-resolution price history: OHLC/volume buckets at 1 s, 10 s, 1 m and 5 m, each level built
+// incrementally on ingest and capped (1 h / 6 h / 48 h / 7 d), so long chart scales read O(maxPoints) buckets instead of
+// scanning the raw history, and days of history fit in bounded memory (~0.7 MB per symbol with every level full).
+class TimePyramid {
+public:
+    // count = points added (sum / count = mean close), trades = trades those points folded (conflation, batched frames)
+    struct Bucket { double t0 = 0.0, open = 0.0, high = 0.0, low = 0.0, close = 0.0, sum = 0.0, volume = 0.0; quint32 count = 0, trades = 0; };
+    // One ingested point: close is the price the ring keeps, open/high/low span every trade folded into it
+    struct Ohlc { double open = 0.0, high = 0.0, low = 0.0, close = 0.0; quint32 trades = 1; };
+    static constexpr int kLevels = 4;
+    static double levelSeconds(int level);
+    static int levelCapacity(int level);
+
+    void add(double ts, double price) { add(ts, Ohlc{price, price, price, price, 1}); }
+    // A folded point lands whole in the bucket of ts (its open only opens a bucket it creates)
+    void add(double ts, const Ohlc& p);
+    void addVolume(double ts, double volume);
+    void clear() { for (auto& l : levels) l.clear(); }
+    const std::deque<Bucket>& level(int i) const { return levels[size_t(i)]; }
+    // Coarsest level that still yields at least minPoints buckets over windowSec and can hold that span; -1 = use raw points
+    static int pickLevel(double windowSec, int minPoints);
+    // Samples of level lvl newer than from, merged into groups of `group` buckets aligned to absolute time so a group keeps
+    // its timestamp as the window slides. method: 0 = close (last), 1 = mean, 2 = high (max),
+    // 3 = low/high envelope (two samples per group, at its start and middle). ts = group start.
+    void sample(int lvl, double from, int group, int method, std::vector<double>& ts, std::vector<double>& out) const;
+    // As-of price at ts from the finest level that reaches back to it: close of the last bucket that ended by ts (so
+    // later ticks cannot change it); false if no such bucket
+    bool closeAsOf(double ts, double& close) const;
+    size_t memoryBytes() const;
+private:
+    Bucket* find(int lvl, double ts);
+    std::deque<Bucket> levels[kLevels];
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <QVector>
+#include <memory>
+#include <vector>
+#include "HistoryRing.h"
+#include "SymbolRegistry.h"
+#include "TimePyramid.h"
+
+// Process-wide price history keyed by SymbolId, owned outside the widgets. GUI-thread owned, no locking: ingest appends
+// from MainWindow::applyTicks after the frame drain (tags come from HistoryRing's GUI-thread label table), and widgets,
+// MultiCompareWindow, HistoryStorage and the BTC-ratio join read through Reader, which exposes the symbol's ring and
+// pyramid in place. Offscreen tile rasterization reads it from pool threads only while the GUI thread waits in the
+// frame join, so no append can run concurrently.
+// Widgets are views bound to a symbol: renaming one rebinds it and leaves both symbols' data here, and a symbol keeps
+// its history whether or not a widget shows it.
+class TimeSeriesStore {
+public:
+    struct Point { double ts = 0.0, value = 0.0; quint64 seq = 0; HistoryRing::Tag tag; };
+    class Reader;
+    static TimeSeriesStore& instance();
+
+    // Unknown symbols read as an empty series
+    Reader read(SymbolId id) const;
+    // Appends one point (assigning the next seq) and trims by the series' retention; ts is expected non-decreasing
+    void append(SymbolId id, double ts, double value, const HistoryRing::Tag& tag) { append(id, ts, TimePyramid::Ohlc{value, value, value, value, 1}, tag); }
+    // Folded tick (conflated / batched trades): the ring keeps the close, the pyramid buckets its open/high/low and trade count
+    void append(SymbolId id, double ts, const TimePyramid::Ohlc& p, const HistoryRing::Tag& tag);
+    void addVolume(SymbolId id, double ts, double volume);
+    // Replaces the series (points sorted by ts) and rebuilds its pyramid from the closes (saved points carry no trade range)
+    void replace(SymbolId id, const std::vector<Point>& pts);
+    void setCapacity(SymbolId id, int points);
+    void setRetention(SymbolId id, double seconds);
+    // Symbols holding at least one point
+    QVector<SymbolId> symbols() const;
+    size_t memoryBytes() const;
+private:
+    struct Series {
+        HistoryRing history{20000}; TimePyramid pyramid;
+        double retentionSec = 48*3600.0; quint64 seq = 0;
+    };
+    TimeSeriesStore() = default;
+    Series* series(SymbolId id); // created on demand
+    const Series* find(SymbolId id) const;
+    std::vector<std::unique_ptr<Series>> slots; // by SymbolId; Series addresses stay stable
+    Series none;
+};
+
+// Read access to one symbol's series: the ring and pyramid in place, valid until the next append to that symbol, so keep
+// it scoped to one pass.
+class TimeSeriesStore::Reader {
+public:
+    Reader(Reader&& o) noexcept : s(o.s) { o.s = nullptr; }
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+    const HistoryRing& history() const { return s->history; }
+    const TimePyramid& pyramid() const { return s->pyramid; }
+    HistoryRing::View window(double from) const { return s->history.window(from); }
+private:
+    friend class TimeSeriesStore;
+    explicit Reader(const Series* series) : s(series) {}
+    const Series* s;
+};
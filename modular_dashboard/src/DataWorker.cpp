@@ -1,4 +1,7 @@
 ﻿#include "DataWorker.h"
+#include "MarketDataParser.h"
+#include "Profiler.h"
+#include "FrameCapture.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -9,17 +12,33 @@
 #include <QSet>
 #include <QHash>
 
-static inline double jsonToDouble(const QJsonValue& v) {
-    if (v.isDouble()) return v.toDouble();
-    if (v.isString()) return v.toString().toDouble();
-    if (v.isNull() || v.isUndefined()) return 0.0;
-    auto var = v.toVariant();
-    bool ok=false; double d = var.toString().toDouble(&ok); if (ok) return d;
-    return var.toDouble();
-}
-
 DataWorker::DataWorker(QObject* parent) : QObject(parent) {
     last_report_time = QDateTime::currentMSecsSinceEpoch() / 1000.0;
+    qRegisterMetaType<TickBatch>();
+}
+
+DataWorker::~DataWorker() = default;
+
+void DataWorker::setBatchInterval(int ms) {
+    batchIntervalMs = std::max(0, ms);
+    qDebug() << "[DataWorker] setBatchInterval ->" << batchIntervalMs << "ms";
+    if (batchIntervalMs == 0) { flushBatch(); if (batchTimer) batchTimer->stop(); return; }
+    if (!batchTimer) { batchTimer = new QTimer(this); batchTimer->setSingleShot(true); batchTimer->setTimerType(Qt::PreciseTimer); connect(batchTimer, &QTimer::timeout, this, &DataWorker::flushBatch); }
+}
+
+void DataWorker::flushBatch() {
+    if (pendingBatch.ticks.isEmpty()) return;
+    TickBatch out; std::swap(out, pendingBatch); pendingBatch.ticks.reserve(out.ticks.size());
+    out.publishedNs = Profiler::nowNs();
+    emit ticksReady(out);
+}
+
+TickRecord DataWorker::makeRecord(SymbolId id, const MarketTick& tick) const {
+    TickRecord r; r.symbol = id;
+    r.provider = provider; r.price = tick.price; r.timestamp = tick.timestamp; r.volBase = tick.volBase; r.volQuote = tick.volQuote; r.volIncr = tick.volIncr; r.recvNs = frameRecvNs; r.bufferedNs = Profiler::nowNs(); r.open = r.high = r.low = tick.price; r.ticks = quint32(std::max(1, tick.trades));
+    if (tick.trades > 1) { r.open = tick.open; r.high = tick.high; r.low = tick.low; }
+    if (provider==DataProvider::Bybit) r.market = (lastSubMarket.value(id, (bybitPreference==BybitPreference::LinearFirst)?BybitMarket::Linear:BybitMarket::Spot)==BybitMarket::Linear) ? TickMarket::Linear : TickMarket::Spot;
+    return r;
 }
 
 void DataWorker::setMode(StreamMode m) {
@@ -30,7 +49,7 @@ void DataWorker::setMode(StreamMode m) {
 void DataWorker::setProvider(DataProvider p) {
     provider = p;
     qDebug() << "[DataWorker] setProvider ->" << (provider==DataProvider::Binance?"Binance":"Bybit");
-    if (running) {
+    if (running && replayPath.isEmpty()) {
         reconnectPlanned = true;
         if (webSocket) { webSocket->abort(); webSocket->deleteLater(); webSocket = nullptr; }
         startPingWatchdog(false);
@@ -44,12 +63,69 @@ void DataWorker::start() {
     qDebug() << "[DataWorker] start: provider=" << (provider==DataProvider::Binance?"Binance":"Bybit")
              << ", mode=" << (mode==StreamMode::Trade?"TRADE":"TICKER")
              << ", currencies=" << subscribedCurrencies;
+    if (!replayPath.isEmpty()) { startReplay(); return; }
     connectWebSocket();
 }
 
+void DataWorker::setReplaySource(const QString& path, double speed) {
+    replayPath = path; replaySpeed = std::max(0.0, speed);
+    qDebug() << "[DataWorker] setReplaySource ->" << (path.isEmpty() ? QStringLiteral("live") : path) << "speed" << replaySpeed;
+}
+
+void DataWorker::setBaseUrls(const QString& binance, const QString& bybit) {
+    auto trim = [](QString b){ b = b.trimmed(); while (b.endsWith('/')) b.chop(1); return b; };
+    binanceBase = trim(binance); bybitBase = trim(bybit);
+    if (!binanceBase.isEmpty() || !bybitBase.isEmpty()) qDebug() << "[DataWorker] endpoint override: binance=" << binanceBase << "bybit=" << bybitBase;
+}
+
+QString DataWorker::binanceUrl(const QStringList& streams) const {
+    const QString base = binanceBase.isEmpty() ? QStringLiteral("wss://stream.binance.com:9443") : binanceBase;
+    return streams.isEmpty() ? base + QStringLiteral("/stream") : QString("%1/stream?streams=%2").arg(base, streams.join('/'));
+}
+
+QString DataWorker::bybitUrl(BybitMarket market) const {
+    const QString base = bybitBase.isEmpty() ? QStringLiteral("wss://stream.bybit.com") : bybitBase;
+    return base + (market==BybitMarket::Linear ? QStringLiteral("/v5/public/linear?compress=false") : QStringLiteral("/v5/public/spot?compress=false"));
+}
+
+void DataWorker::startReplay() {
+    replayReader.reset(new FrameReader(replayPath));
+    if (!replayReader->isOpen()) { qDebug() << "[DataWorker] replay: cannot read" << replayPath << replayReader->errorString(); emit workerError(replayReader->errorString()); replayReader.reset(); return; }
+    replayNext.reset(new CapturedFrame()); replayFrames = 0; replayBaseNs = -1;
+    if (!replayReader->next(*replayNext)) replayNext.reset();
+    if (!replayTimer) { replayTimer = new QTimer(this); replayTimer->setSingleShot(true); replayTimer->setTimerType(Qt::PreciseTimer); connect(replayTimer, &QTimer::timeout, this, &DataWorker::replayStep); }
+    replayClock.start(); replayTimer->start(0);
+}
+
+// Feeds due frames through processMessage. Recorded inter-frame spacing is kept (scaled by replaySpeed); at max speed
+// frames go out in slices so stop()/settings calls still get through the event loop.
+void DataWorker::replayStep() {
+    if (!running || !replayReader) return;
+    const qint64 elapsedNs = replayClock.nsecsElapsed();
+    for (int budget = 4096; replayNext && budget > 0; --budget) {
+        if (replayBaseNs < 0) replayBaseNs = replayNext->recvNs;
+        if (replaySpeed > 0) {
+            const qint64 dueNs = qint64(double(replayNext->recvNs - replayBaseNs) / replaySpeed);
+            if (dueNs > elapsedNs) { replayTimer->start(int(std::min<qint64>((dueNs - elapsedNs) / 1000000, 1000))); return; }
+        }
+        provider = replayNext->provider; mode = replayNext->mode;
+        processMessage(QString::fromUtf8(replayNext->payload)); ++replayFrames;
+        if (!replayReader->next(*replayNext)) replayNext.reset();
+    }
+    if (replayNext) { replayTimer->start(0); return; }
+    const double secs = replayClock.nsecsElapsed() / 1e9;
+    qDebug() << "[DataWorker] replay finished:" << replayFrames << "frames in" << secs << "s (" << (replayFrames / std::max(secs, 1e-9)) << "frames/s)";
+    replayReader.reset(); flushBatch();
+    emit replayFinished(replayFrames, secs);
+}
+
 void DataWorker::stop() {
     running = false;
     startPingWatchdog(false);
+    if (batchTimer) batchTimer->stop();
+    if (replayTimer) replayTimer->stop();
+    replayReader.reset(); replayNext.reset();
+    pendingBatch.ticks.clear();
     qDebug() << "[DataWorker] stop";
     if (webSocket) {
         webSocket->abort(); webSocket->deleteLater(); webSocket = nullptr;
@@ -66,10 +142,25 @@ void DataWorker::stop() {
 }
 
 void DataWorker::setCurrencies(const QStringList& list) {
+    const QSet<SymbolId> previous(subscribedIds.cbegin(), subscribedIds.cend());
     subscribedCurrencies = list;
-    for (const QString& c : subscribedCurrencies) if (!msg_counter.contains(c)) msg_counter[c]=0;
+    // Intern ids at subscription time; the hot path resolves raw symbols through symbolIndex without allocating
+    subscribedIds.clear(); symbolIndex.clear();
+    for (const QString& c : subscribedCurrencies) {
+        const QString up = c.toUpper(); const SymbolId id = SymbolRegistry::instance().intern(up);
+        subscribedIds.append(id); symbolIndex.insert(up + "USDT", id);
+        if (id >= msgCountById.size()) { msgCountById.resize(id + 1, 0); lastTickMsById.resize(id + 1, 0); }
+    }
     qDebug() << "[DataWorker] setCurrencies ->" << subscribedCurrencies;
-    if (running) {
+    if (running && replayPath.isEmpty()) {
+        // Watch symbols kept across the change: their first tick afterwards reports the gap (0 expected without reconnect)
+        gapPending.clear(); gapMaxMs = 0; gapSinceMs = nowMs();
+        for (SymbolId id : std::as_const(subscribedIds)) if (previous.contains(id)) gapPending.insert(id);
+        // Still resolving / connecting: onConnected reconciles the list on the new connection
+        if (webSocket && (webSocket->state()==QAbstractSocket::HostLookupState || webSocket->state()==QAbstractSocket::ConnectingState)) { gapReconnect = true; return; }
+        gapReconnect = !syncSubscriptions();
+        if (!gapReconnect) return;
+        qDebug() << "[DataWorker] no live connection, reconnecting with the new list";
         reconnectPlanned = true;
         if (webSocket) { webSocket->abort(); webSocket->deleteLater(); webSocket=nullptr; }
         startPingWatchdog(false);
@@ -85,7 +176,59 @@ void DataWorker::onConnected() {
         // Send on primary market first according to preference
         const BybitMarket primary = (bybitPreference==BybitPreference::LinearFirst) ? BybitMarket::Linear : BybitMarket::Spot;
         sendBybitSubscriptions(webSocket, args, primary);
+        liveTopics = QSet<QString>(args.cbegin(), args.cend());
+    } else {
+        syncSubscriptions(); // list may have changed while the handshake was in flight
+    }
+}
+
+// Brings the live connection to the wanted topic set with SUBSCRIBE/UNSUBSCRIBE control messages instead of a reconnect.
+// Returns false when there is no connected socket (caller reconnects).
+bool DataWorker::syncSubscriptions() {
+    if (!webSocket || webSocket->state()!=QAbstractSocket::ConnectedState) return false;
+    const QStringList wanted = (provider==DataProvider::Binance) ? buildBinanceStreams() : buildBybitArgs();
+    const QSet<QString> want(wanted.cbegin(), wanted.cend());
+    QStringList add, drop;
+    for (const QString& t : wanted) if (!liveTopics.contains(t)) add << t;
+    for (const QString& t : std::as_const(liveTopics)) if (!want.contains(t)) drop << t;
+    if (add.isEmpty() && drop.isEmpty()) return true;
+    qDebug() << "[DataWorker] incremental resubscribe: +" << add << "-" << drop;
+    if (provider == DataProvider::Binance) {
+        // Binance accepts at most 5 control messages per second per connection
+        auto send = [this](const char* method, const QStringList& params, int delayMs) {
+            const QString payload = QString::fromUtf8(QJsonDocument(QJsonObject{{"method", method}, {"params", QJsonArray::fromStringList(params)}, {"id", ++binanceReqId}}).toJson(QJsonDocument::Compact));
+            QTimer::singleShot(delayMs, this, [this, payload](){ if (webSocket && webSocket->state()==QAbstractSocket::ConnectedState) webSocket->sendTextMessage(payload); });
+        };
+        int delay = 0;
+        if (!drop.isEmpty()) { send("UNSUBSCRIBE", drop, delay); delay += 250; }
+        if (!add.isEmpty()) send("SUBSCRIBE", add, delay);
+    } else {
+        // Symbols that fell back to the alternate market are unsubscribed there
+        const BybitMarket primary = (bybitPreference==BybitPreference::LinearFirst) ? BybitMarket::Linear : BybitMarket::Spot;
+        const BybitMarket alt = (primary==BybitMarket::Linear) ? BybitMarket::Spot : BybitMarket::Linear;
+        QStringList dropPrimary, dropAlt;
+        for (const QString& t : drop) {
+            QString sym = t.section('.', 1, 1); if (sym.endsWith("USDT")) sym.chop(4);
+            const SymbolId id = SymbolRegistry::instance().intern(sym.toUpper());
+            (lastSubMarket.value(id, primary)==primary ? dropPrimary : dropAlt) << t; lastSubMarket.remove(id);
+        }
+        sendBybitSubscriptions(webSocket, dropPrimary, primary, "unsubscribe");
+        sendBybitSubscriptions(bybitAlt, dropAlt, alt, "unsubscribe");
+        sendBybitSubscriptions(webSocket, add, primary);
     }
+    for (const QString& t : drop) liveTopics.remove(t);
+    for (const QString& t : add) liveTopics.insert(t);
+    return true;
+}
+
+void DataWorker::noteResubscribeGap(SymbolId id, qint64 now) {
+    // Inter-tick interval straddling the subscription change (falls back to time since the change for a symbol that was silent)
+    const qint64 last = (id < lastTickMsById.size()) ? lastTickMsById[id] : 0;
+    const qint64 gap = now - (last > 0 ? last : gapSinceMs);
+    gapMaxMs = std::max(gapMaxMs, gap);
+    Profiler::sample(gapReconnect ? "subscribe/reconnect_gap_ms" : "subscribe/unchanged_gap_ms", double(gap));
+    if (gapPending.isEmpty())
+        qDebug() << "[DataWorker] resubscribe" << (gapReconnect ? "(reconnect)" : "(incremental)") << ": unchanged symbols resumed, max inter-tick gap" << gapMaxMs << "ms";
 }
 
 void DataWorker::onDisconnected() {
@@ -113,10 +256,26 @@ void DataWorker::onError(QAbstractSocket::SocketError err) {
 
 void DataWorker::processMessage(const QString& message) {
     if (!running) return;
+    frameRecvNs = Profiler::nowNs();
+    framesIn.fetch_add(1, std::memory_order_relaxed);
+    if (recorder && !replayReader) recorder->append(provider, mode, message);
     if (message == "ping") { if (webSocket && webSocket->state()==QAbstractSocket::ConnectedState) webSocket->sendTextMessage("pong"); return; }
+    if (provider == DataProvider::Bybit) { static int rawDbg = 0; if (rawDbg < 10) { qDebug() << "Bybit raw:" << message.left(500); rawDbg++; } }
+    // Fast path: scan market-data frames in place (no UTF-8 conversion, no JSON DOM); control/unknown frames fall through
+    MarketTick tick;
+    switch (MarketDataParser::scan(QStringView(message), provider, mode, tick)) {
+    case MarketDataParser::Result::Tick: emitTick(tick); return;
+    case MarketDataParser::Result::Skip: return;
+    case MarketDataParser::Result::Fallback: break;
+    }
     QJsonParseError jerr; QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &jerr); if (jerr.error != QJsonParseError::NoError) return; if (!doc.isObject()) return; QJsonObject root = doc.object();
     if (root.value("op").toString() == "ping") { QJsonObject pong; pong["op"] = "pong"; if (root.contains("ts")) pong["ts"] = root.value("ts"); QJsonDocument d(pong); if (webSocket && webSocket->state()==QAbstractSocket::ConnectedState) webSocket->sendTextMessage(QString::fromUtf8(d.toJson(QJsonDocument::Compact))); lastPongMs = nowMs(); return; }
     if (root.value("op").toString() == "pong") { lastPongMs = nowMs(); return; }
+    // Binance SUBSCRIBE/UNSUBSCRIBE responses: {"result":null,"id":N} or {"error":{...},"id":N}
+    if (provider == DataProvider::Binance && root.contains("id") && (root.contains("result") || root.contains("error"))) {
+        if (root.contains("error")) qDebug() << "[DataWorker] Binance control error:" << QString::fromUtf8(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        return;
+    }
     // Bybit subscription ack / error diagnostics
     if (provider == DataProvider::Bybit && root.contains("op") && root.value("op").toString() == "subscribe") {
         bool success = root.value("success").toBool(true);
@@ -127,30 +286,42 @@ void DataWorker::processMessage(const QString& message) {
         handleBybitSubscribeAck(root);
         // don't return; allow further parsing if data present, but most acks have no data
     }
-    double price=0.0, timestamp=0.0; QString currency;
-    double volBase=0.0, volQuote=0.0, volIncr=0.0;
-    if (provider == DataProvider::Bybit) { static int rawDbg = 0; if (rawDbg < 10) { qDebug() << "Bybit raw topic/type:" << root.value("topic").toString() << root.value("type").toString(); qDebug() << "Bybit raw:" << message.left(500); rawDbg++; } }
-    if (provider == DataProvider::Binance) {
-        if (!root.contains("data")) return; QJsonObject data = root["data"].toObject(); QString symbol = data.value("s").toString(); if (symbol.isEmpty()) return; currency = symbol.left(symbol.length()-4).toUpper(); if (mode==StreamMode::Trade) { price = jsonToDouble(data.value("p")); timestamp = jsonToDouble(data.value("T"))/1000.0; volIncr = jsonToDouble(data.value("q")); } else { price = jsonToDouble(data.value("c")); timestamp = jsonToDouble(data.value("E"))/1000.0; volBase = jsonToDouble(data.value("v")); volQuote = jsonToDouble(data.value("q")); }
-    } else {
-        QString topic = root.value("topic").toString(); QJsonValue dataVal = root.value("data"); QJsonArray arr; QJsonObject obj; if (dataVal.isArray()) arr = dataVal.toArray(); else if (dataVal.isObject()) obj = dataVal.toObject(); QString symbol;
-    if (!arr.isEmpty()) { QJsonObject e = arr.last().toObject(); symbol = e.value("symbol").toString(); if (symbol.isEmpty()) symbol = e.value("s").toString(); if (mode==StreamMode::Trade) { price = jsonToDouble(e.value("p")); timestamp = jsonToDouble(e.value("T"))/1000.0; volIncr = jsonToDouble(e.value("q")); } else { price = e.contains("lastPrice") ? jsonToDouble(e.value("lastPrice")) : jsonToDouble(e.value("lp")); double tsRoot = jsonToDouble(root.value("ts")); double tsData = jsonToDouble(e.value("ts")); timestamp = ((tsRoot>0? tsRoot : tsData))/1000.0; volBase = jsonToDouble(e.value("turnover24h")); volQuote = jsonToDouble(e.value("volume24h")); } }
-    else if (!obj.isEmpty()) { symbol = obj.value("symbol").toString(); if (symbol.isEmpty()) symbol = obj.value("s").toString(); if (mode==StreamMode::Trade) { price = jsonToDouble(obj.value("p")); timestamp = jsonToDouble(obj.value("T"))/1000.0; volIncr = jsonToDouble(obj.value("q")); } else { price = obj.contains("lastPrice") ? jsonToDouble(obj.value("lastPrice")) : jsonToDouble(obj.value("lp")); double tsRoot = jsonToDouble(root.value("ts")); double tsData = jsonToDouble(obj.value("ts")); timestamp = ((tsRoot>0? tsRoot : tsData))/1000.0; volBase = jsonToDouble(obj.value("turnover24h")); volQuote = jsonToDouble(obj.value("volume24h")); } }
-        if (symbol.isEmpty() && !topic.isEmpty()) { auto parts = topic.split('.'); if (parts.size()>=2) symbol = parts.last(); }
-        if (symbol.isEmpty()) return; currency = symbol.left(symbol.length()-4).toUpper();
+    if (MarketDataParser::fromJson(root, provider, mode, tick) == MarketDataParser::Result::Tick) emitTick(tick);
+}
+
+void DataWorker::emitTick(const MarketTick& tick) {
+    const double price = tick.price, timestamp = tick.timestamp;
+    // Subscribed symbols resolve without allocating; anything else (e.g. symbol only known from a topic) is interned once
+    SymbolId id = symbolIndex.find(tick.symbol, tick.symbolLen); QString currency;
+    if (id == InvalidSymbol) { currency = tick.currency(); if (currency.isEmpty()) return; id = SymbolRegistry::instance().intern(currency); }
+    if (price<=0 || timestamp<=0) return;
+    if (provider == DataProvider::Bybit) { int &c = bybitDbgCount[id]; if (c < 2) { qDebug() << "Bybit tick" << SymbolRegistry::instance().name(id) << "price" << price << "ts" << timestamp; c++; } }
+    if (id < msgCountById.size()) msgCountById[id]++;
+    const qint64 nowTickMs = nowMs();
+    if (!gapPending.isEmpty() && gapPending.remove(id)) noteResubscribeGap(id, nowTickMs);
+    if (id < lastTickMsById.size()) lastTickMsById[id] = nowTickMs;
+    double now = QDateTime::currentMSecsSinceEpoch()/1000.0; if (now - last_report_time >= 10) { double interval = now - last_report_time; for (int i=0; i<subscribedIds.size() && i<subscribedCurrencies.size(); ++i) { const SymbolId sid = subscribedIds[i]; qDebug() << QString("  %1: %2 msg/s").arg(subscribedCurrencies[i]).arg(msgCountById.value(sid)/interval,0,'f',2); if (sid < msgCountById.size()) msgCountById[sid]=0; } last_report_time = now; }
+    lastMsgMs = nowTickMs;
+    if (tickRing) {
+        if (tickRing->push(makeRecord(id, tick))) {
+            if (!ringFlushTimer) { ringFlushTimer = new QTimer(this); ringFlushTimer->setSingleShot(true); connect(ringFlushTimer, &QTimer::timeout, this, [this](){ if (tickRing && tickRing->flushPending()) ringFlushTimer->start(8); }); }
+            if (!ringFlushTimer->isActive()) ringFlushTimer->start(8);
+        }
+        return;
+    }
+    if (batchIntervalMs > 0 && batchTimer) {
+        pendingBatch.ticks.append(makeRecord(id, tick));
+        if (!batchTimer->isActive()) batchTimer->start(batchIntervalMs);
+        return;
     }
-    if (price<=0 || timestamp<=0 || currency.isEmpty()) return;
-    if (provider == DataProvider::Bybit) { static QHash<QString,int> dbgCount; int &c = dbgCount[currency]; if (c < 2) { qDebug() << "Bybit tick" << currency << "price" << price << "ts" << timestamp; c++; } }
-    if (msg_counter.contains(currency)) msg_counter[currency]++;
-    double now = QDateTime::currentMSecsSinceEpoch()/1000.0; if (now - last_report_time >= 10) { double interval = now - last_report_time; const auto list = subscribedCurrencies; for (const QString& cur : list) { qDebug() << QString("  %1: %2 msg/s").arg(cur).arg(msg_counter[cur]/interval,0,'f',2); msg_counter[cur]=0; } last_report_time = now; }
-    lastMsgMs = nowMs();
+    if (currency.isEmpty()) currency = SymbolRegistry::instance().name(id);
     emit dataUpdated(currency, price, timestamp);
-    emit volumeTick(currency, volBase, volQuote, volIncr, timestamp);
+    emit volumeTick(currency, tick.volBase, tick.volQuote, tick.volIncr, timestamp);
     // market tag: if topic contains tickers.* from Spot fallback, label Spot; otherwise Linear for Bybit; Binance as-is
     QString providerName = (provider==DataProvider::Binance) ? "Binance" : "Bybit";
     QString marketName = "";
     if (provider==DataProvider::Bybit) {
-        BybitMarket m = lastSubMarket.value(currency, (bybitPreference==BybitPreference::LinearFirst)?BybitMarket::Linear:BybitMarket::Spot);
+        BybitMarket m = lastSubMarket.value(id, (bybitPreference==BybitPreference::LinearFirst)?BybitMarket::Linear:BybitMarket::Spot);
         marketName = (m==BybitMarket::Linear) ? "Linear" : "Spot";
     }
     emit dataTick(currency, price, timestamp, providerName, marketName);
@@ -170,16 +341,17 @@ void DataWorker::connectWebSocket() {
         qDebug() << "[DataWorker] SSL errors:";
         for (const auto& e : errs) qDebug() << "   *" << e.errorString();
     });
+    liveTopics.clear();
     if (provider == DataProvider::Binance) {
-        QStringList streams; const QString suffix = (mode==StreamMode::Trade)? "@trade" : "@ticker"; const auto& list = subscribedCurrencies; for (const QString& cur : list) streams << QString("%1usdt%2").arg(cur.toLower(), suffix);
-        const QString url = QString("wss://stream.binance.com:9443/stream?streams=%1").arg(streams.join('/'));
+        const QStringList streams = buildBinanceStreams(); liveTopics = QSet<QString>(streams.cbegin(), streams.cend());
+        // An empty list still opens /stream so later symbols can be added with SUBSCRIBE
+        const QString url = binanceUrl(streams);
         qDebug() << "[DataWorker] opening Binance WS:" << url;
         webSocket->open(QUrl(url));
     } else {
         // Bybit primary according to preference
         const bool linearPrimary = (bybitPreference==BybitPreference::LinearFirst);
-        const QString primaryUrl = linearPrimary ? QStringLiteral("wss://stream.bybit.com/v5/public/linear?compress=false")
-                                                 : QStringLiteral("wss://stream.bybit.com/v5/public/spot?compress=false");
+        const QString primaryUrl = bybitUrl(linearPrimary ? BybitMarket::Linear : BybitMarket::Spot);
         qDebug() << "[DataWorker] opening Bybit" << (linearPrimary?"Linear":"Spot") << "WS:" << primaryUrl;
         webSocket->open(QUrl(primaryUrl));
         connect(webSocket, &QWebSocket::binaryMessageReceived, this, [this,linearPrimary](const QByteArray& bin){ static int cnt = 0; if (cnt++ < 3) qDebug() << (linearPrimary?"Bybit Linear":"Bybit Spot") << "binary frame (ignored, expect compress=false): size" << bin.size(); });
@@ -199,7 +371,7 @@ void DataWorker::connectWebSocket() {
 void DataWorker::scheduleReconnect() {
     if (!running) return;
     int base=1000; int delay = base * (1 << std::min(reconnectAttempt, 5)); delay = std::min(delay, 30000);
-    delay += int(QRandomGenerator::global()->bounded(500)); reconnectAttempt++;
+    delay += int(QRandomGenerator::global()->bounded(500)); reconnectAttempt++; reconnects.fetch_add(1, std::memory_order_relaxed);
     QTimer::singleShot(delay, this, &DataWorker::connectWebSocket);
 }
 
@@ -240,26 +412,33 @@ QStringList DataWorker::buildBybitArgs() const {
     return args;
 }
 
-void DataWorker::sendBybitSubscriptions(QWebSocket* target, const QStringList& args, BybitMarket market) {
-    if (!target || target->state()!=QAbstractSocket::ConnectedState) return;
+QStringList DataWorker::buildBinanceStreams() const {
+    QStringList streams; const QString suffix = (mode==StreamMode::Trade)? "@trade" : "@ticker";
+    for (const QString& cur : subscribedCurrencies) streams << QString("%1usdt%2").arg(cur.toLower(), suffix);
+    return streams;
+}
+
+void DataWorker::sendBybitSubscriptions(QWebSocket* target, const QStringList& args, BybitMarket market, const char* op) {
+    if (!target || target->state()!=QAbstractSocket::ConnectedState || args.isEmpty()) return;
+    const bool subscribe = qstrcmp(op, "subscribe") == 0;
     const int chunk = 10; // bybit may limit per subscribe size; be conservative
     int batchIdx = 0;
     for (int i=0; i<args.size(); i+=chunk, ++batchIdx) {
         const QStringList slice = args.mid(i, chunk);
-        QJsonObject sub; sub["op"] = "subscribe"; QJsonArray a; for (const auto& s : slice) a.append(s); sub["args"] = a;
+        QJsonObject sub; sub["op"] = op; QJsonArray a; for (const auto& s : slice) a.append(s); sub["args"] = a;
         const QString payload = QString::fromUtf8(QJsonDocument(sub).toJson(QJsonDocument::Compact));
         const int totalBatches = (args.size()+chunk-1)/chunk;
-        qDebug() << (market==BybitMarket::Linear?"Bybit Linear":"Bybit Spot") << "subscribe (chunk)" << (i/chunk+1) << "/" << totalBatches << ":" << payload;
+        qDebug() << (market==BybitMarket::Linear?"Bybit Linear":"Bybit Spot") << op << "(chunk)" << (i/chunk+1) << "/" << totalBatches << ":" << payload;
         // Spread out subscription messages to avoid server disconnects
         QTimer::singleShot(150 * batchIdx, this, [this, payload, target](){
             if (target && target->state()==QAbstractSocket::ConnectedState) target->sendTextMessage(payload);
         });
         // Track last attempted market for included symbols
-        for (const auto& s : slice) {
+        if (subscribe) for (const auto& s : slice) {
             QString topic = s;
             QString sym = topic.contains('.') ? topic.section('.',1,1) : topic;
             if (sym.endsWith("USDT")) sym.chop(4);
-            lastSubMarket[sym] = market;
+            lastSubMarket[SymbolRegistry::instance().intern(sym.toUpper())] = market;
         }
     }
 }
@@ -280,12 +459,12 @@ void DataWorker::handleBybitSubscribeAck(const QJsonObject& root) {
     if (!sym.isEmpty()) {
         // If Linear rejects symbol, attempt to subscribe it on Spot
         // Decide which market rejected based on lastSubMarket
-        BybitMarket last = lastSubMarket.value(sym, (bybitPreference==BybitPreference::LinearFirst)?BybitMarket::Linear:BybitMarket::Spot);
+        BybitMarket last = lastSubMarket.value(SymbolRegistry::instance().intern(sym), (bybitPreference==BybitPreference::LinearFirst)?BybitMarket::Linear:BybitMarket::Spot);
         if (allowBybitFallback && last == BybitMarket::Linear && !invalidLinearBybit.contains(sym)) {
             invalidLinearBybit.insert(sym);
             qDebug() << "[DataWorker] Bybit Linear does not support" << sym << ", trying Spot.";
             if (bybitAlt && bybitAlt->state()==QAbstractSocket::UnconnectedState) {
-                const QString spotUrl = QStringLiteral("wss://stream.bybit.com/v5/public/spot?compress=false");
+                const QString spotUrl = bybitUrl(BybitMarket::Spot);
                 qDebug() << "[DataWorker] opening Bybit Spot WS:" << spotUrl;
                 bybitAlt->open(QUrl(spotUrl));
             }
@@ -0,0 +1,168 @@
+#include "DataWorkerPool.h"
+#include "Profiler.h"
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+#include <memory>
+
+DataWorkerPool::DataWorkerPool(QObject* parent) : QObject(parent) {
+    statsTimer = new QTimer(this); statsTimer->setInterval(10000);
+    connect(statsTimer, &QTimer::timeout, this, &DataWorkerPool::reportStats);
+}
+
+DataWorkerPool::~DataWorkerPool() { shutdown(); }
+
+int DataWorkerPool::targetShardCount(int symbolCount) const {
+    if (!replayPath.isEmpty()) return 1;
+    if (requestedShards > 0) return requestedShards;
+    return std::clamp((symbolCount + AutoStreamsPerShard - 1) / AutoStreamsPerShard, 1, MaxShards);
+}
+
+void DataWorkerPool::configure(int shardsWanted, int threadsWanted) {
+    requestedShards = std::clamp(shardsWanted, 0, MaxShards); requestedThreads = std::max(1, threadsWanted);
+    if (shards.empty()) return; // built by the first setCurrencies
+    const int count = targetShardCount(int(currencies.size()));
+    if (count == shardCount() && std::min(requestedThreads, count) == threads.size()) return;
+    rebuild(count);
+}
+
+void DataWorkerPool::rebuild(int count) {
+    teardown();
+    const int nThreads = std::clamp(requestedThreads, 1, count);
+    for (int t=0; t<nThreads; ++t) { auto* th = new QThread(this); th->setObjectName(QString("ingest-%1").arg(t)); threads << th; }
+    shards.resize(size_t(count));
+    for (int i=0; i<count; ++i) {
+        Shard& s = shards[size_t(i)]; s.thread = i % nThreads; s.ring.reset(new TickRing(8192, ringPolicy));
+        auto* w = new DataWorker(); w->setMode(mode); w->setProvider(provider); w->setBybitPreference(bybitPreference); w->setBaseUrls(binanceBase, bybitBase);
+        w->setTickRing(ringEnabled ? s.ring.get() : nullptr);
+        if (!replayPath.isEmpty()) w->setReplaySource(replayPath, replaySpeed); else w->setRecorder(recorder);
+        w->moveToThread(threads[s.thread]);
+        connect(threads[s.thread], &QThread::finished, w, &QObject::deleteLater);
+        connect(w, &DataWorker::dataUpdated, this, &DataWorkerPool::dataUpdated);
+        connect(w, &DataWorker::dataTick, this, &DataWorkerPool::dataTick);
+        connect(w, &DataWorker::volumeTick, this, &DataWorkerPool::volumeTick);
+        connect(w, &DataWorker::unsupportedSymbol, this, &DataWorkerPool::unsupportedSymbol);
+        connect(w, &DataWorker::ticksReady, this, &DataWorkerPool::ticksReady);
+        connect(w, &DataWorker::replayFinished, this, &DataWorkerPool::replayFinished);
+        s.worker = w;
+    }
+    const int batch = batchMs; invokeAll([batch](DataWorker* w){ w->setBatchInterval(batch); });
+    shardOf.clear(); distribute(true);
+    if (running) invokeAll([](DataWorker* w){ w->start(); });
+    for (QThread* th : std::as_const(threads)) th->start();
+    lastStats.clear(); statsClock.start(); statsTimer->start();
+    qDebug() << "[DataWorkerPool]" << count << "connection(s) on" << nThreads << "thread(s) for" << currencies.size() << "symbols";
+}
+
+void DataWorkerPool::teardown() {
+    for (auto& s : shards) if (s.ring) s.ring->close(); // release producers blocked on a full ring
+    for (auto& s : shards) QMetaObject::invokeMethod(s.worker, "stop", Qt::QueuedConnection);
+    for (int i=0; i<threads.size(); ++i) {
+        QThread* t = threads[i]; t->quit(); if (!t->wait(2500)) { t->quit(); t->wait(1000); }
+        if (t->isFinished()) { delete t; continue; }
+        // Still running (stuck in a socket call): its workers may still push, so their rings are freed with the thread
+        qWarning() << "[DataWorkerPool]" << t->objectName() << "did not stop; its rings are kept until it finishes";
+        auto rings = std::make_shared<std::vector<std::unique_ptr<TickRing>>>();
+        for (auto& s : shards) if (s.thread == i && s.ring) rings->push_back(std::move(s.ring));
+        t->setParent(nullptr); // the pool may go away first; deleting a running QThread aborts
+        connect(t, &QThread::finished, t, [t, rings]{ rings->clear(); t->deleteLater(); });
+    }
+    threads.clear(); shards.clear();
+}
+
+void DataWorkerPool::shutdown() {
+    if (statsTimer) statsTimer->stop();
+    running = false; teardown();
+}
+
+// Keeps existing symbol->shard assignments, drops removed symbols and puts new ones on the least loaded shard;
+// only shards whose list changed get setCurrencies (incremental resubscribe), the others keep streaming untouched
+void DataWorkerPool::distribute(bool pushAll) {
+    const int n = shardCount(); if (n == 0) return;
+    const QSet<QString> wanted(currencies.cbegin(), currencies.cend());
+    for (auto it = shardOf.begin(); it != shardOf.end(); ) { if (wanted.contains(it.key()) && it.value() < n) ++it; else it = shardOf.erase(it); }
+    QVector<int> load(n, 0); for (int s : std::as_const(shardOf)) ++load[s];
+    for (const QString& c : currencies) if (!shardOf.contains(c)) { const int s = int(std::min_element(load.begin(), load.end()) - load.begin()); shardOf.insert(c, s); ++load[s]; }
+    QVector<QStringList> lists(n); for (const QString& c : currencies) lists[shardOf.value(c)] << c;
+    for (int i=0; i<n; ++i) {
+        Shard& s = shards[size_t(i)];
+        if (!pushAll && lists[i] == s.symbols) continue;
+        s.symbols = lists[i]; DataWorker* w = s.worker; const QStringList l = lists[i];
+        QMetaObject::invokeMethod(w, [w,l](){ w->setCurrencies(l); }, Qt::QueuedConnection);
+    }
+}
+
+void DataWorkerPool::setCurrencies(const QStringList& list) {
+    currencies = list;
+    const int target = targetShardCount(int(list.size()));
+    if (target != shardCount()) rebuild(target); else distribute(false);
+}
+
+void DataWorkerPool::setMode(StreamMode m) { mode = m; invokeAll([m](DataWorker* w){ w->setMode(m); }); }
+void DataWorkerPool::setProvider(DataProvider p) { provider = p; invokeAll([p](DataWorker* w){ w->setProvider(p); }); }
+void DataWorkerPool::setBybitPreference(BybitPreference pref) { bybitPreference = pref; invokeAll([pref](DataWorker* w){ w->setBybitPreference(pref); }); }
+void DataWorkerPool::setBatchInterval(int ms) { batchMs = ms; invokeAll([ms](DataWorker* w){ w->setBatchInterval(ms); }); }
+void DataWorkerPool::setBaseUrls(const QString& binance, const QString& bybit) {
+    if (binance == binanceBase && bybit == bybitBase) return;
+    binanceBase = binance; bybitBase = bybit;
+    const bool live = running && replayPath.isEmpty();
+    invokeAll([binance,bybit,live](DataWorker* w){ w->setBaseUrls(binance, bybit); if (live) { w->stop(); w->start(); } });
+}
+void DataWorkerPool::start() { running = true; invokeAll([](DataWorker* w){ w->start(); }); }
+void DataWorkerPool::stop() { running = false; invokeAll([](DataWorker* w){ w->stop(); }); }
+
+bool DataWorkerPool::setRecording(const QString& path) {
+    std::shared_ptr<FrameRecorder> rec;
+    if (!path.isEmpty()) { rec = std::make_shared<FrameRecorder>(path); if (!rec->isOpen()) return false; }
+    recorder = rec; // the previous recorder flushes and closes once the last shard drops it
+    if (replayPath.isEmpty()) invokeAll([rec](DataWorker* w){ w->setRecorder(rec); });
+    return true;
+}
+
+void DataWorkerPool::setReplay(const QString& path, double speed) {
+    replayPath = path; replaySpeed = speed;
+    rebuild(targetShardCount(int(currencies.size()))); // sources change on every shard: start over
+}
+
+void DataWorkerPool::setTickRing(bool enabled, TickRing::Policy policy) {
+    ringEnabled = enabled; ringPolicy = policy;
+    for (auto& s : shards) {
+        s.ring->setPolicy(policy);
+        DataWorker* w = s.worker; TickRing* ring = enabled ? s.ring.get() : nullptr;
+        QMetaObject::invokeMethod(w, [w,ring](){ w->setTickRing(ring); }, Qt::QueuedConnection);
+    }
+}
+
+// Shards are appended one after another; a symbol lives on a single shard, so its ticks stay in order
+int DataWorkerPool::drain(QVector<TickRecord>& out) {
+    int n = 0; for (auto& s : shards) n += s.ring->drain(out);
+    return n;
+}
+
+void DataWorkerPool::closeRings() { for (auto& s : shards) if (s.ring) s.ring->close(); }
+
+void DataWorkerPool::sampleRingStats() const {
+    for (int i=0; i<shardCount(); ++i) {
+        const auto st = shards[size_t(i)].ring->stats();
+        const QByteArray prefix = shardCount()==1 ? QByteArray("ring/main") : "ring/main" + QByteArray::number(i);
+        Profiler::sample((prefix + "/high_water").constData(), double(st.highWater));
+        Profiler::sample((prefix + "/dropped_total").constData(), double(st.dropped));
+        Profiler::sample((prefix + "/conflated_total").constData(), double(st.conflated));
+    }
+}
+
+void DataWorkerPool::reportStats() {
+    const double secs = std::max(0.001, statsClock.restart() / 1000.0);
+    lastStats.clear();
+    for (int i=0; i<shardCount(); ++i) {
+        Shard& s = shards[size_t(i)];
+        ShardStats st; st.shard = i; st.thread = s.thread; st.symbols = int(s.symbols.size());
+        st.messages = s.worker->messageCount(); st.reconnects = s.worker->reconnectCount();
+        st.msgPerSec = double(st.messages - s.lastMessages) / secs; s.lastMessages = st.messages;
+        lastStats << st;
+        qDebug() << QString("[DataWorkerPool] shard %1 (thread %2): %3 symbols, %4 msg/s, %5 reconnects").arg(i).arg(st.thread).arg(st.symbols).arg(st.msgPerSec,0,'f',1).arg(st.reconnects);
+        const QByteArray key = "shard/" + QByteArray::number(i);
+        Profiler::sample((key + "/msg_s").constData(), st.msgPerSec);
+        Profiler::sample((key + "/reconnects").constData(), double(st.reconnects));
+    }
+}
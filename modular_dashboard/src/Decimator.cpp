@@ -0,0 +1,70 @@
+#include "Decimator.h"
+#include <algorithm>
+#include <cmath>
+
+bool Decimator::configure(Mode m, double bucketSec) {
+    if (m == mode && bucketSec == width) return false;
+    mode = m; width = bucketSec; clear();
+    return true;
+}
+
+void Decimator::clear() { buckets.clear(); head = 0; prevPts.clear(); tailPts.clear(); fed = 0; }
+
+Decimator::Pt Decimator::lttbPick(const std::vector<Pt>& pts, const Pt& a, const Bucket& c) {
+    const double cTs = c.sumTs / c.n, cV = c.sum / c.n;
+    Pt best = pts.empty() ? a : pts.front(); double bestArea = -1.0;
+    for (const Pt& p : pts) {
+        const double area = std::abs((a.ts - cTs) * (p.v - a.v) - (a.ts - p.ts) * (cV - a.v));
+        if (area > bestArea) { bestArea = area; best = p; }
+    }
+    return best;
+}
+
+// LTTB pick of the bucket before the open one, against the open bucket's current average (prevPts = its points)
+void Decimator::pickLastClosed() {
+    if (buckets.size() - head < 2) return;
+    const size_t i = buckets.size() - 2;
+    if (i == head) { buckets[i].pick = buckets[i].first; return; }
+    buckets[i].pick = lttbPick(prevPts, (i-1 == head) ? buckets[i-1].first : buckets[i-1].pick, buckets.back());
+}
+
+void Decimator::append(double ts, double v) {
+    if (width <= 0.0) return;
+    const double t0 = std::floor(ts / width) * width;
+    if (head < buckets.size() && t0 < buckets.back().t0) return;
+    if (head == buckets.size() || t0 > buckets.back().t0) {
+        // Closing the open bucket makes its average final, which fixes the pick of the bucket before it
+        if (mode == Mode::Lttb) { pickLastClosed(); prevPts.swap(tailPts); tailPts.clear(); }
+        Bucket nb; nb.t0 = t0; nb.first = nb.mn = nb.mx = Pt{ts, v}; buckets.push_back(nb);
+    }
+    Bucket& b = buckets.back();
+    b.sumTs += ts; b.sum += v; ++b.n; b.last = b.pick = Pt{ts, v};
+    if (v < b.mn.v) b.mn = Pt{ts, v};
+    if (v > b.mx.v) b.mx = Pt{ts, v};
+    if (mode == Mode::Lttb) tailPts.push_back(Pt{ts, v});
+}
+
+void Decimator::dropBefore(double from) {
+    while (head < buckets.size() && buckets[head].t0 + width <= from) ++head;
+    if (head > 1024 && head * 2 > buckets.size()) { buckets.erase(buckets.begin(), buckets.begin() + std::ptrdiff_t(head)); head = 0; }
+}
+
+void Decimator::output(std::vector<double>& ts, std::vector<double>& out) {
+    ts.clear(); out.clear();
+    const size_t live = buckets.size() - head;
+    if (live == 0) return;
+    if (mode == Mode::Lttb) {
+        pickLastClosed(); // provisional until the open bucket closes
+        ts.reserve(live); out.reserve(live);
+        ts.push_back(buckets[head].first.ts); out.push_back(buckets[head].first.v); // the window's first point is always kept
+        for (size_t i=head+1; i<buckets.size(); ++i) { ts.push_back(buckets[i].pick.ts); out.push_back(buckets[i].pick.v); }
+    } else {
+        ts.reserve(live * 2); out.reserve(live * 2);
+        for (size_t i=head; i<buckets.size(); ++i) {
+            const Bucket& b = buckets[i]; const bool minFirst = b.mn.ts <= b.mx.ts;
+            const Pt& p = minFirst ? b.mn : b.mx; const Pt& q = minFirst ? b.mx : b.mn;
+            ts.push_back(p.ts); out.push_back(p.v);
+            if (q.ts != p.ts || q.v != p.v) { ts.push_back(q.ts); out.push_back(q.v); }
+        }
+    }
+}
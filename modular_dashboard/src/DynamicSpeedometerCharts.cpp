@@ -1,8 +1,12 @@
 #include "DynamicSpeedometerCharts.h"
+#include "FrameScheduler.h"
+#include "LatencyTracer.h"
+#include "Profiler.h"
 #include <QPainter>
 #include <QMenu>
 #include <QAction>
 #include <QContextMenuEvent>
+#include <QPaintEvent>
 #include <QMouseEvent>
 #include <QDateTime>
 #include <QLocale>
@@ -10,12 +14,16 @@
 #include <numeric>
 #include <QSettings>
 #include <cmath>
+#include <QtMath>
 #include <QActionGroup>
 #include <QCoreApplication>
 #include <QDebug>
 
+bool DynamicSpeedometerCharts::showRepaintRegions = false;
+
 DynamicSpeedometerCharts::DynamicSpeedometerCharts(const QString& cur, QWidget* parent)
     : QWidget(parent), currency(cur) {
+    symId = SymbolRegistry::instance().intern(currency.toUpper());
     // Initialize default theme colors (Dark theme)
     themeColors = {
         QColor(40,44,52),      // background
@@ -30,49 +38,16 @@ DynamicSpeedometerCharts::DynamicSpeedometerCharts(const QString& cur, QWidget*
     
     timeScales = {{"1m",60},{"5m",300},{"15m",900},{"30m",1800},{"1h",3600},{"4h",14400},{"24h",86400}};
     setMinimumSize(100,100);
-    animation = new QPropertyAnimation(this, "value", this); animation->setDuration(400);
-    connect(animation, &QPropertyAnimation::valueChanged, this, [this](){ if (modeView=="speedometer") update(); });
-
-    // Charts
-    chart = new QChart(); chart->setBackgroundBrush(QColor(40,44,52)); chart->legend()->hide();
-    seriesNormal = new QLineSeries(chart); seriesRatio = new QLineSeries(chart);
-    chart->addSeries(seriesNormal); chart->addSeries(seriesRatio);
-    // Indicator series
-    rsiSeries = new QLineSeries(chart); rsiSeries->setName("RSI"); rsiSeries->setColor(QColor(180, 120, 255)); rsiSeries->setVisible(false); chart->addSeries(rsiSeries);
-    macdSeries = new QLineSeries(chart); macdSeries->setName("MACD"); macdSeries->setColor(QColor(255, 90, 90)); macdSeries->setVisible(false); chart->addSeries(macdSeries);
-    macdSignalSeries = new QLineSeries(chart); macdSignalSeries->setName("Signal"); macdSignalSeries->setColor(QColor(255, 190, 120)); macdSignalSeries->setVisible(false); chart->addSeries(macdSignalSeries);
-    bbUpperSeries = new QLineSeries(chart); bbUpperSeries->setName("BB Upper"); bbUpperSeries->setColor(QColor(120, 200, 255)); bbUpperSeries->setVisible(false); chart->addSeries(bbUpperSeries);
-    bbLowerSeries = new QLineSeries(chart); bbLowerSeries->setName("BB Lower"); bbLowerSeries->setColor(QColor(120, 200, 255)); bbLowerSeries->setVisible(false); chart->addSeries(bbLowerSeries);
-
-    axisX = new QValueAxis(chart); axisY = new QValueAxis(chart);
-    axisX->setVisible(false); axisX->setTickCount(2); axisY->setLabelFormat("%.2f");
-    chart->addAxis(axisX, Qt::AlignBottom); chart->addAxis(axisY, Qt::AlignLeft);
-    // Additional axes for indicators
-    axisRSI = new QValueAxis(chart); axisRSI->setLabelFormat("%.0f"); axisRSI->setVisible(false); chart->addAxis(axisRSI, Qt::AlignRight);
-    axisMACD = new QValueAxis(chart); axisMACD->setLabelFormat("%.2f"); axisMACD->setVisible(false); chart->addAxis(axisMACD, Qt::AlignRight);
-
-    seriesNormal->attachAxis(axisX); seriesNormal->attachAxis(axisY);
-    seriesRatio->attachAxis(axisX); seriesRatio->attachAxis(axisY); seriesRatio->setVisible(false);
-    // Attach indicator series to axes
-    rsiSeries->attachAxis(axisX); rsiSeries->attachAxis(axisRSI);
-    macdSeries->attachAxis(axisX); macdSeries->attachAxis(axisMACD);
-    macdSignalSeries->attachAxis(axisX); macdSignalSeries->attachAxis(axisMACD);
-    bbUpperSeries->attachAxis(axisX); bbUpperSeries->attachAxis(axisY);
-    bbLowerSeries->attachAxis(axisX); bbLowerSeries->attachAxis(axisY);
-
-    chartView = new QChartView(chart, this); chartView->setRenderHint(QPainter::Antialiasing); chartView->setVisible(false);
-    chartView->setGeometry(rect());
-
-    renderTimer = new QTimer(this); renderTimer->setInterval(16);
-    connect(renderTimer, &QTimer::timeout, this, &DynamicSpeedometerCharts::onRenderTimeout); renderTimer->start();
-    cacheUpdateTimer = new QTimer(this); cacheUpdateTimer->setInterval(300);
-    connect(cacheUpdateTimer, &QTimer::timeout, this, &DynamicSpeedometerCharts::cacheChartData); cacheUpdateTimer->start();
+    needle.setSettleMs(400);
+
+    FrameScheduler::instance().add(this);
 
     // Load per-widget overlay settings
     {
         QSettings st("alel12", "modular_dashboard");
         showVolOverlay = st.value(QString("ui/overlays/vol/%1").arg(currency), false).toBool();
         showChangeOverlay = st.value(QString("ui/overlays/chg/%1").arg(currency), false).toBool();
+        showRepaintRegions = st.value("ui/debug/repaint_regions", false).toBool();
     // Volume visualization mode
     QString vv = st.value(QString("ui/volume/vis/%1").arg(currency), "off").toString().toLower();
     if (vv=="bar") volVis = VolumeVis::Bar;
@@ -83,6 +58,13 @@ DynamicSpeedometerCharts::DynamicSpeedometerCharts(const QString& cur, QWidget*
         showRSI = st.value(QString("ui/indicators/rsi/%1").arg(currency), false).toBool();
         showMACD = st.value(QString("ui/indicators/macd/%1").arg(currency), false).toBool();
         showBB = st.value(QString("ui/indicators/bb/%1").arg(currency), false).toBool();
+        // Volatility estimator
+        const QString vk = st.value(QString("ui/volatility/kind/%1").arg(currency), "mean").toString().toLower();
+        if (vk=="ewma") volEstimator.setKind(RollingVolatility::Kind::Ewma);
+        else if (vk=="parkinson") volEstimator.setKind(RollingVolatility::Kind::Parkinson);
+        // Chart decimation
+        const QString dk = st.value(QString("ui/chart/decimation/%1").arg(currency), "last").toString().toLower();
+        sampleMethod = dk=="mean" ? 1 : dk=="max" ? 2 : dk=="lttb" ? 3 : dk=="minmax" ? 4 : 0;
         // Transitions (global)
         transitionsEnabled = st.value("ui/transitions/enabled", true).toBool();
         const QString t = st.value("ui/transitions/type", "flip").toString().toLower();
@@ -211,6 +193,26 @@ void DynamicSpeedometerCharts::setOverlayVolatility(bool enabled) {
     if (modeView=="speedometer") update();
 }
 
+void DynamicSpeedometerCharts::setVolatilityKindByKey(const QString& key) {
+    const QString k = key.toLower();
+    RollingVolatility::Kind kind = RollingVolatility::Kind::MeanAbsReturn;
+    if (k=="ewma") kind = RollingVolatility::Kind::Ewma;
+    else if (k=="parkinson") kind = RollingVolatility::Kind::Parkinson;
+    volEstimator.setKind(kind);
+    QSettings st("alel12","modular_dashboard");
+    st.setValue(QString("ui/volatility/kind/%1").arg(currency), kind==RollingVolatility::Kind::Ewma ? "ewma" : kind==RollingVolatility::Kind::Parkinson ? "parkinson" : "mean"); st.sync();
+    updateVolatility(); if (modeView=="speedometer") update();
+}
+
+void DynamicSpeedometerCharts::setDecimationByKey(const QString& key) {
+    static const QStringList keys{"last","mean","max","lttb","minmax"};
+    const int m = std::max(0, int(keys.indexOf(key.toLower())));
+    if (m == sampleMethod) return;
+    sampleMethod = m; priceDecimator.clear(); ratioDecimator.clear();
+    QSettings st("alel12","modular_dashboard"); st.setValue(QString("ui/chart/decimation/%1").arg(currency), keys[m]); st.sync();
+    cacheChartData(); updateChartSeries();
+}
+
 void DynamicSpeedometerCharts::setOverlayChange(bool enabled) {
     if (showChangeOverlay != enabled) showChangeOverlay = enabled;
     QSettings st("alel12","modular_dashboard");
@@ -224,31 +226,26 @@ void DynamicSpeedometerCharts::setPythonScalingParams(double initSpanPct, double
     pyMaxCompress = std::min(1.0, std::max(0.0, maxCompress)); // <= 1.0
     pyMinWidthPct = std::clamp(minWidthPct, 1e-8, 1.0);
     // Recompute bounds using latest price
-    if (!history.empty()) updateBounds(history.back().value);
+    const auto rd = series(); if (!rd.history().empty()) updateBounds(rd.history().backValue());
 }
 
-void DynamicSpeedometerCharts::applyPerformance(int animMs, int renderMs, int cacheMs, int volWindowSize, int maxPts, int rawCacheSize) {
-    animation->setDuration(animMs); renderTimer->setInterval(std::max(1, renderMs)); cacheUpdateTimer->setInterval(std::max(10, cacheMs));
+DynamicSpeedometerCharts::~DynamicSpeedometerCharts() { FrameScheduler::instance().remove(this); }
+
+double DynamicSpeedometerCharts::getValue() const { return needle.value(FrameScheduler::instance().frameTimeNs()); }
+
+void DynamicSpeedometerCharts::applyPerformance(int animMs, int volWindowSize, int maxPts, int rawCacheSize) {
+    needle.setSettleMs(animMs);
     volatilityWindow = volWindowSize; maxPoints = maxPts; setRawCacheSize(rawCacheSize); cacheChartData(); update();
 }
 
 void DynamicSpeedometerCharts::setRawCacheSize(int sz) {
     cacheSize = std::max(100, sz);
-    while (history.size() > static_cast<size_t>(cacheSize)) history.pop_front();
-    while (btcRatioHistory.size() > static_cast<size_t>(cacheSize)) btcRatioHistory.pop_front();
+    TimeSeriesStore::instance().setCapacity(symId, cacheSize);
 }
 
-void DynamicSpeedometerCharts::updateData(double price, double timestamp, double btc) {
-    HistoryPoint hp; hp.ts = timestamp; hp.value = price; hp.source = currentSourceKind; hp.provider = property("providerName").toString(); hp.market = property("marketName").toString(); hp.seq = ++seqCounter;
-    history.push_back(hp);
-    if (history.size()>static_cast<size_t>(cacheSize)) history.pop_front();
-    const double cutoff = timestamp - historyRetentionSec;
-    while (!history.empty() && history.front().ts < cutoff) history.pop_front();
-    // BTC ratio synthetic
-    HistoryPoint br = hp; br.value = (currency=="BTC") ? 1.0 : (btc>0 ? price/btc : 0.0);
-    if (currency=="BTC" || btc>0) btcRatioHistory.push_back(br);
-    if (btcRatioHistory.size()>static_cast<size_t>(cacheSize)) btcRatioHistory.pop_front();
-    while (!btcRatioHistory.empty() && btcRatioHistory.front().ts < cutoff) btcRatioHistory.pop_front();
+void DynamicSpeedometerCharts::updateData(double price, double timestamp, double high, double low) {
+    Q_UNUSED(timestamp); // the point is already in TimeSeriesStore (capacity / retention applied there)
+    if (high > low) { const auto rd = series(); if (!rd.history().empty()) volEstimator.noteRange(rd.history().endIndex() - 1, high, low); }
     updateVolatility(); updateBounds(price);
     double scaled=50; if (cachedMinVal && cachedMaxVal && cachedMaxVal.value() > cachedMinVal.value()) {
         double t = (price-cachedMinVal.value())/(cachedMaxVal.value()-cachedMinVal.value());
@@ -258,12 +255,19 @@ void DynamicSpeedometerCharts::updateData(double price, double timestamp, double
         amplified = std::clamp(amplified, 0.0, 1.0);
         scaled = amplified * 100.0;
     }
-    animation->stop(); animation->setStartValue(_value); animation->setEndValue(scaled); animation->start();
-    dataNeedsRedraw = true;
+    needle.setTarget(scaled, FrameScheduler::instance().frameTimeNs()); // keeps the needle's speed; painted by the next frames
+    dataNeedsRedraw = true; framePending = true;
 }
 
 void DynamicSpeedometerCharts::setCurrencyName(const QString& name) { 
     currency = name; 
+    const SymbolId prevId = symId;
+    symId = SymbolRegistry::instance().intern(currency.toUpper());
+    if (symId != prevId) {
+        // Rebind to the new symbol's series; the old symbol's history stays in the store
+        TimeSeriesStore& store = TimeSeriesStore::instance(); store.setCapacity(symId, cacheSize); store.setRetention(symId, historyRetentionSec);
+        resetSeriesState(); cacheChartData();
+    }
     // Reload overlay prefs for this currency
     QSettings st("alel12", "modular_dashboard");
     showVolOverlay = st.value(QString("ui/overlays/vol/%1").arg(currency), showVolOverlay).toBool();
@@ -307,17 +311,45 @@ void DynamicSpeedometerCharts::setCurrencyName(const QString& name) {
     if (modeView!="speedometer") updateChartSeries(); else update(); 
 }
 
-void DynamicSpeedometerCharts::paintEvent(QPaintEvent*) {
+void DynamicSpeedometerCharts::paintEvent(QPaintEvent* e) {
+    LatencyTracer::instance().onPaint(symId);
     // Не блокируем полностью перерисовку, чтобы оверлей мог рисоваться поверх.
     // Но если мы в режиме спидометра и активен переход, избегаем перерисовки циферблата,
     // чтобы не мигало под оверлеем.
-    if (modeView=="speedometer" && !transitionActive) {
+    // Offscreen tile finished this frame: blit it, unless the paint also covers rects it was not rendered for or the
+    // static configuration changed since (then draw directly as usual)
+    const bool blit = tileBlitPending && modeView=="speedometer" && !transitionActive && (e->region() - tileRegion).isEmpty()
+        && dialKey && *dialKey == DialKey{style, size(), devicePixelRatioF(), thresholds, themeColors, frameStyle};
+    if (blit) {
+        tileBlitPending = false;
+        QPainter p(this); p.drawImage(0, 0, tileFront);
+    } else if (modeView=="speedometer" && !transitionActive) {
+        tileBlitPending = false;
+        static const char* const scopes[] = {"DynamicSpeedometerCharts::paint/Classic", "DynamicSpeedometerCharts::paint/NeonGlow",
+            "DynamicSpeedometerCharts::paint/Minimal", "DynamicSpeedometerCharts::paint/ModernTicks", "DynamicSpeedometerCharts::paint/Circle",
+            "DynamicSpeedometerCharts::paint/Gauge", "DynamicSpeedometerCharts::paint/Ring", "DynamicSpeedometerCharts::paint/SegmentBar",
+            "DynamicSpeedometerCharts::paint/DualArc"};
+        Profiler::Scope prof(scopes[int(style)]); // per-style paint cost (dial layer rebuilds included)
+        const qint64 now = FrameScheduler::instance().frameTimeNs(); needle.advance(now); _value = needle.value(now);
         QPainter p(this); p.setRenderHint(QPainter::Antialiasing); drawSpeedometer(p);
+        if (Profiler::isEnabled()) {
+            qint64 px = 0; for (const QRect& r : e->region()) px += qint64(r.width()) * r.height();
+            Profiler::sample("DynamicSpeedometerCharts::repaintPct", 100.0 * double(px) / double(std::max(1, width() * height())));
+        }
+        if (showRepaintRegions) {
+            // Debug overlay: each paint tints its rects in the next hue, so stale tints show what was not repainted since
+            static int hue = 0; hue = (hue + 47) % 360;
+            p.setRenderHint(QPainter::Antialiasing, false);
+            p.setPen(QColor::fromHsv(hue, 255, 255, 220)); p.setBrush(QColor::fromHsv(hue, 255, 255, 50));
+            for (const QRect& r : e->region()) p.drawRect(r.adjusted(0,0,-1,-1));
+        }
+    } else if (modeView!="speedometer") {
+        // Also painted during a transition: the overlay's "to" snapshot grabs this view
+        Profiler::Scope prof("DynamicSpeedometerCharts::paint/chart");
+        QPainter p(this); p.setRenderHint(QPainter::Antialiasing); plot.paint(p, rect());
     }
 }
 
-void DynamicSpeedometerCharts::resizeEvent(QResizeEvent*) { if (chartView) chartView->setGeometry(rect()); }
-
 void DynamicSpeedometerCharts::mousePressEvent(QMouseEvent* e) {
     if (e->button()==Qt::LeftButton) {
         if (modeView=="speedometer") animateViewSwitch("line_chart");
@@ -370,6 +402,14 @@ void DynamicSpeedometerCharts::contextMenuEvent(QContextMenuEvent* e) {
     actAxis->setCheckable(true); actAxis->setChecked(showAxisLabels);
     connect(actGrid, &QAction::toggled, this, [this](bool on){ setChartOptions(on, showAxisLabels); });
     connect(actAxis, &QAction::toggled, this, [this](bool on){ setChartOptions(showGrid, on); });
+    QMenu* decMenu = chartMenu->addMenu("Decimation");
+    QActionGroup* decGrp = new QActionGroup(decMenu); decGrp->setExclusive(true);
+    auto addDec = [&](const QString& label, const QString& key, int m){ QAction* a = decMenu->addAction(label); a->setCheckable(true); a->setActionGroup(decGrp); a->setChecked(sampleMethod==m); connect(a, &QAction::triggered, this, [this,key](){ setDecimationByKey(key); }); return a; };
+    addDec("Step: last", "last", 0);
+    addDec("Step: mean", "mean", 1);
+    addDec("Step: max", "max", 2);
+    addDec("LTTB (shape-preserving)", "lttb", 3);
+    addDec("Min/Max per pixel", "minmax", 4);
 
     // Volume visualization submenu
     QMenu* volMenu = menu.addMenu("Volume");
@@ -453,6 +493,13 @@ void DynamicSpeedometerCharts::contextMenuEvent(QContextMenuEvent* e) {
     // Overlay toggles for metrics
     QAction* actVol = menu.addAction("Show volatility overlay"); actVol->setCheckable(true); actVol->setChecked(showVolOverlay);
     QAction* actChg = menu.addAction("Show change overlay"); actChg->setCheckable(true); actChg->setChecked(showChangeOverlay);
+    QAction* actRegions = menu.addAction("Debug: show repaint regions"); actRegions->setCheckable(true); actRegions->setChecked(showRepaintRegions);
+    QMenu* vkMenu = menu.addMenu("Volatility estimator");
+    QActionGroup* vkGrp = new QActionGroup(vkMenu); vkGrp->setExclusive(true);
+    auto addVK = [&](const QString& label, const QString& key, RollingVolatility::Kind k){ QAction* a = vkMenu->addAction(label); a->setCheckable(true); a->setActionGroup(vkGrp); a->setChecked(volEstimator.currentKind()==k); a->setData(key); return a; };
+    addVK("Mean |return|", "mean", RollingVolatility::Kind::MeanAbsReturn);
+    addVK("EWMA", "ewma", RollingVolatility::Kind::Ewma);
+    addVK("Parkinson (range)", "parkinson", RollingVolatility::Kind::Parkinson);
     // Widget frame styles (must be created before exec)
     QMenu* frameMenu = menu.addMenu("Widget Frame");
     QActionGroup* frameGrp = new QActionGroup(frameMenu); frameGrp->setExclusive(true);
@@ -513,6 +560,14 @@ void DynamicSpeedometerCharts::contextMenuEvent(QContextMenuEvent* e) {
         QSettings st("alel12", "modular_dashboard"); st.setValue(QString("ui/overlays/chg/%1").arg(currency), showChangeOverlay); st.sync();
         update(); 
     }
+    else if (chosen==actRegions) {
+        showRepaintRegions = !showRepaintRegions; // all widgets (ui/debug/repaint_regions)
+        QSettings st("alel12", "modular_dashboard"); st.setValue("ui/debug/repaint_regions", showRepaintRegions); st.sync();
+        update();
+    }
+    else if (chosen && chosen->actionGroup()==vkGrp) {
+        setVolatilityKindByKey(chosen->data().toString());
+    }
     else if (chosen==indRSI) {
         showRSI = !showRSI; QSettings st("alel12","modular_dashboard"); st.setValue(QString("ui/indicators/rsi/%1").arg(currency), showRSI); st.sync(); updateChartSeries();
     }
@@ -628,12 +683,109 @@ void DynamicSpeedometerCharts::contextMenuEvent(QContextMenuEvent* e) {
     }
 }
 
-void DynamicSpeedometerCharts::onRenderTimeout() { if (dataNeedsRedraw && (modeView != "speedometer")) { dataNeedsRedraw=false; updateChartSeries(); } }
+void DynamicSpeedometerCharts::presentFrame() {
+    if (transitionActive) return;
+    if (modeView != "speedometer") { if (dataNeedsRedraw) { dataNeedsRedraw=false; updateChartSeries(); } }
+    else if (needle.moving() || framePending) { invalidateChanged(); framePending = false; } // invalidateChanged re-reads price / trades only when pending
+}
+
+bool DynamicSpeedometerCharts::prepareOffscreen() {
+    if (transitionActive || modeView != "speedometer" || !isVisible() || !(needle.moving() || framePending)) return false;
+    const qint64 now = FrameScheduler::instance().frameTimeNs(); needle.advance(now); _value = needle.value(now);
+    const qreal dpr = devicePixelRatioF(); const QSize px = size() * dpr;
+    if (tileBack.size() != px) tileBack = QImage(px, QImage::Format_ARGB32_Premultiplied);
+    tileBack.setDevicePixelRatio(dpr);
+    return true;
+}
+
+void DynamicSpeedometerCharts::renderOffscreen() {
+    tileBack.fill(Qt::transparent);
+    QPainter p(&tileBack); p.setRenderHint(QPainter::Antialiasing); drawSpeedometer(p);
+}
+
+void DynamicSpeedometerCharts::finishOffscreen() {
+    std::swap(tileFront, tileBack);
+    tileRegion = invalidateChanged(); tileBlitPending = !tileRegion.isEmpty(); framePending = false;
+}
+
+QRegion DynamicSpeedometerCharts::invalidateChanged() {
+    const int w = width(), h = height();
+    const double v = needle.value(FrameScheduler::instance().frameTimeNs());
+    int warn = thresholds.warn, danger = thresholds.danger; if (!thresholds.enabled) { warn=70; danger=90; }
+    const int zone = v>=danger ? 2 : (v>=warn ? 1 : 0);
+    double price = painted.price; size_t trades = painted.trades;
+    if (framePending || !painted.valid) { const auto rd = series(); const HistoryRing& history = rd.history(); trades = history.size(); price = history.empty() ? 0.0 : history.backValue(); }
+    const PaintedState now{true, size(), zone, v, volNorm, volatility, price, trades, showAnomalyBadge && anomalyActive, anomalyLabel};
+    // Zone colours tint the whole needle/arc/glow: a zone crossing (or a resize / first frame) repaints everything
+    if (!painted.valid || painted.size != now.size || painted.zone != now.zone) { painted = now; update(); return QRegion(rect()); }
+    const QRect chips(w-162, 6, 162, 58);
+    QRegion r;
+    if (now.value != painted.value) { r += sectorRect(painted.value, now.value); if (showChangeOverlay) r += chips; }
+    if (now.price != painted.price || now.trades != painted.trades) {
+        switch (style) {
+            case SpeedometerStyle::SegmentBar: r += QRect(0, h/2-18, w, 24).adjusted(-2,-2,2,2); break;
+            case SpeedometerStyle::DualArc:    r += QRect(0, h/2-28, w, 24).adjusted(-2,-2,2,2); break;
+            case SpeedometerStyle::Ring:       r += QRect(0, h/2-15, w, 30).adjusted(-2,-2,2,2); break;
+            default: r += QRect(0, h/2+20, w, 20).adjusted(-2,-2,2,2); r += QRect(1, h-50, w-10, 20).adjusted(-2,-2,2,2); break;
+        }
+    }
+    if (now.volatility != painted.volatility) {
+        if (style == SpeedometerStyle::DualArc) { r += QRect(8, 8, w-16, 16).adjusted(-2,-2,2,2); r += QRect(0, 0, w, h); } // inner volatility arc spans the dial
+        else if (style != SpeedometerStyle::SegmentBar && style != SpeedometerStyle::Ring) r += QRect(1, 1, w-10, 20).adjusted(-2,-2,2,2);
+        if (showVolOverlay) r += chips;
+    }
+    if (now.volNorm != painted.volNorm && volVis != VolumeVis::Off) {
+        if (volVis == VolumeVis::Sidebar) r += sidebarRect().adjusted(-2,-2,2,2);
+        else if (volVis == VolumeVis::Fuel) { const int sz = std::min(w,h) - 20, inset = std::clamp(int(std::min(w,h)/6), 26, 48); r += QRect((w-sz)/2,(h-sz)/2,sz,sz).adjusted(inset-6, inset-6, 6-inset, 6-inset); }
+        else r += sectorRect(painted.volNorm*100.0, now.volNorm*100.0);
+    }
+    if (now.anomaly != painted.anomaly || now.anomalyLabel != painted.anomalyLabel) r += QRect(4, 4, 44, 50);
+    painted = now;
+    if (!r.isEmpty()) update(r);
+    return r;
+}
+
+QRect DynamicSpeedometerCharts::sectorRect(double from, double to) const {
+    // Angle of a 0..100 value: 45 + 270*v/100 degrees. Needles rotate clockwise on screen while QPainter arcs run
+    // counter-clockwise, so the box covers the sector and its mirror about the horizontal axis.
+    const double cx = width()/2.0, cy = height()/2.0, R = std::min(width(), height())/2.0 + 6;
+    double a0 = 45 + 2.7 * std::clamp(std::min(from,to), 0.0, 100.0), a1 = 45 + 2.7 * std::clamp(std::max(from,to), 0.0, 100.0);
+    double minX = 0, maxX = 0, maxDy = 0;
+    auto add = [&](double deg){ const double rad = qDegreesToRadians(deg); const double x = R*std::cos(rad), y = R*std::sin(rad);
+        minX = std::min(minX, x); maxX = std::max(maxX, x); maxDy = std::max(maxDy, std::abs(y)); };
+    add(a0); add(a1);
+    for (double q = std::ceil(a0/90.0)*90.0; q < a1; q += 90.0) add(q);
+    return QRectF(QPointF(cx+minX, cy-maxDy), QPointF(cx+maxX, cy+maxDy)).toAlignedRect().adjusted(-16,-16,16,16);
+}
+
+QRect DynamicSpeedometerCharts::sidebarRect() const {
+    int marginR = 6;
+    // Width by mode
+    int autoW = std::clamp(int(std::min(width(), height())/24), 6, 14);
+    int barW = autoW;
+    if (sidebarWidthMode==1) barW = std::max(6, autoW-3);
+    else if (sidebarWidthMode==2) barW = autoW; // medium
+    else if (sidebarWidthMode==3) barW = autoW + 4; // wide
+    int topY = providerName.isEmpty()? 6 : 26; // leave room for provider badge
+    // Also leave room for chips if enabled
+    if (showVolOverlay || showChangeOverlay) topY = std::max(topY, 8);
+    int bottomY = height()-8;
+    if (bottomY - topY < 24) { topY = 6; bottomY = height()-6; }
+    return QRect(width()-barW-marginR, topY, barW, bottomY-topY);
+}
 
 void DynamicSpeedometerCharts::setTimeScale(const QString& scale) { if (timeScales.contains(scale)) { currentScale=scale; cacheChartData(); updateChartSeries(); } }
 
 void DynamicSpeedometerCharts::setModeView(const QString& mv) {
-    modeView = mv; bool charts = (modeView!="speedometer"); chartView->setVisible(charts); if (charts) updateChartSeries(); else update();
+    const bool ratioWas = (modeView=="btc_ratio");
+    modeView = mv; bool charts = (modeView!="speedometer");
+    if (ratioWas != (modeView=="btc_ratio")) {
+        // The ratio series exists only while it is shown: drop it on leave, build it on enter
+        btcRatio.release(); ratioDecimator.clear(); ratioIndicators.reset();
+        std::vector<double>().swap(cachedProcessedBtcRatio); std::vector<double>().swap(cachedProcessedBtcRatioTs);
+        if (modeView=="btc_ratio") cacheChartData();
+    }
+    if (charts) { dialCache = QImage(); dialKey.reset(); tileFront = tileBack = QImage(); updateChartSeries(); } else { plot.clear(); update(); } // each view's cache is only kept while shown
 }
 
 void DynamicSpeedometerCharts::setVolumeVisByKey(const QString& key) {
@@ -680,18 +832,11 @@ void DynamicSpeedometerCharts::animateViewSwitch(const QString& nextMode) {
 
     // Делаем небольшой асинхронный снэпшот "to", чтобы точно успела отрисоваться цель
     transitionActive = true;
-    if (logEnabled) qDebug() << "[TRANSITION] active=true timers paused";
-    bool prevChartUpdates = chartView->updatesEnabled();
-    chartView->setUpdatesEnabled(false);
-    // Пауза внутренних таймеров/анимаций на время перехода
-    bool renderWasActive = renderTimer && renderTimer->isActive();
-    bool cacheWasActive  = cacheUpdateTimer && cacheUpdateTimer->isActive();
-    if (renderWasActive) renderTimer->stop();
-    if (cacheWasActive)  cacheUpdateTimer->stop();
-    if (animation) animation->stop();
+    if (logEnabled) qDebug() << "[TRANSITION] active=true frame updates paused";
+    // FrameScheduler пропускает виджет, пока transitionActive; стрелка считается по времени кадра и догонит цель после перехода
 
     QPointer<DynamicSpeedometerCharts> self(this);
-    QTimer::singleShot(16, this, [this, self, from, prevChartUpdates, renderWasActive, cacheWasActive]() mutable {
+    QTimer::singleShot(16, this, [this, self, from]() mutable {
         if (!self) return;
         // Последний шанс обработать отложенные события
         QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
@@ -699,11 +844,8 @@ void DynamicSpeedometerCharts::animateViewSwitch(const QString& nextMode) {
         if (qEnvironmentVariableIsSet("DASH_TRANSITION_LOG")) qDebug() << "[TRANSITION] captured TO pixmap size=" << to.size() << "progress start";
         // Создаём и запускаем оверлей
         activeOverlay = new TransitionOverlay(this, from, to, transitionType, 380);
-        connect(activeOverlay, &QObject::destroyed, this, [this, prevChartUpdates, renderWasActive, cacheWasActive]{
+        connect(activeOverlay, &QObject::destroyed, this, [this]{
             transitionActive = false;
-            chartView->setUpdatesEnabled(prevChartUpdates);
-            if (renderWasActive && renderTimer) renderTimer->start();
-            if (cacheWasActive && cacheUpdateTimer) cacheUpdateTimer->start();
             activeOverlay = nullptr;
             if (qEnvironmentVariableIsSet("DASH_TRANSITION_LOG")) qDebug() << "[TRANSITION] finished cleanup";
             update();
@@ -713,159 +855,233 @@ void DynamicSpeedometerCharts::animateViewSwitch(const QString& nextMode) {
 }
 
 void DynamicSpeedometerCharts::cacheChartData() {
-    cachedProcessedHistory = processHistory(false);
-    cachedProcessedBtcRatio = processHistory(true);
+    cachedProcessedHistory = processHistory(false, &cachedProcessedTs);
+    // Indicators advance only by the new samples (see IndicatorEngine); the ratio series is only needed in btc_ratio view
+    priceIndicators.sync(cachedProcessedTs, cachedProcessedHistory);
+    if (modeView=="btc_ratio") {
+        cachedProcessedBtcRatio = processHistory(true, &cachedProcessedBtcRatioTs);
+        ratioIndicators.sync(cachedProcessedBtcRatioTs, cachedProcessedBtcRatio);
+    }
     dataNeedsRedraw = true;
     // Also evaluate anomalies for speedometer view
     if (showAnomalyBadge) {
         bool oldActive = anomalyActive; QString oldLabel = anomalyLabel;
-        anomalyActive = false; anomalyLabel.clear();
-        const auto& values = cachedProcessedHistory;
-        if (!values.empty()) {
-            switch (anomalyMode) {
-                case AnomalyMode::RSIOverboughtOversold: {
-                    auto rsi = computeRSI(values, 14);
-                    if (!rsi.empty()) { double last=rsi.back(); if (last>=70.0) { anomalyActive=true; anomalyLabel="RSI↑"; } else if (last<=30.0) { anomalyActive=true; anomalyLabel="RSI↓"; } }
-                    break; }
-                case AnomalyMode::MACDCross: {
-                    auto m = computeMACD(values);
-                    if (m.macd.size()>1 && m.signal.size()>1) {
-                        double pd = m.macd[m.macd.size()-2]-m.signal[m.signal.size()-2];
-                        double ld = m.macd.back()-m.signal.back();
-                        if (pd<=0 && ld>0) { anomalyActive=true; anomalyLabel="MACD↑"; }
-                        else if (pd>=0 && ld<0) { anomalyActive=true; anomalyLabel="MACD↓"; }
-                    }
-                    break; }
-                case AnomalyMode::BollingerBreakout: {
-                    auto bb = computeBollinger(values, 20, 2.0);
-                    if (!bb.upper.empty()) { double last=values.back(); if (last>bb.upper.back()) { anomalyActive=true; anomalyLabel="BB↑"; } else if (last<bb.lower.back()) { anomalyActive=true; anomalyLabel="BB↓"; } }
-                    break; }
-                case AnomalyMode::ZScore: {
-                    double zs = computeZScore(values, std::min<int>(50,(int)values.size())); if (std::abs(zs)>=2.0) { anomalyActive=true; anomalyLabel = (zs>0? "Z↑" : "Z↓"); }
-                    break; }
-                case AnomalyMode::VolSpike: {
-                    int N = std::min<int>(50, (int)values.size()-1);
-                    if (N>10) {
-                        std::vector<double> rets; rets.reserve(N);
-                        for (int i=(int)values.size()-N; i<(int)values.size(); ++i) { if (i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev) : 0.0); }
-                        if (rets.size()>5) { std::vector<double> tmp = rets; std::nth_element(tmp.begin(), tmp.begin()+tmp.size()/2, tmp.end()); double med = tmp[tmp.size()/2]; double last = rets.back(); if (last>med*2.5) { anomalyActive=true; anomalyLabel="VOL"; } }
-                    }
-                    break; }
-                case AnomalyMode::Composite: {
-                    // Smarter composite: reduce false positives via multi-signal confirmation + z-score/vol gating
-                    QString lab; int votes = 0;
-                    auto rsi=computeRSI(values,14);
-                    bool rsiExtreme = (!rsi.empty() && (rsi.back()>=75.0 || rsi.back()<=25.0));
-                    if (rsiExtreme) { ++votes; lab = lab.isEmpty()? "RSI" : lab+"+RSI"; }
-                    auto m=computeMACD(values);
-                    bool macdCross=false; if (m.macd.size()>1 && m.signal.size()>1) {
-                        double pd=m.macd[m.macd.size()-2]-m.signal[m.signal.size()-2];
-                        double ld=m.macd.back()-m.signal.back();
-                        macdCross = ((pd<=0&&ld>0)||(pd>=0&&ld<0));
-                    }
-                    if (macdCross) { ++votes; lab = lab.isEmpty()? "MACD" : lab+"+MACD"; }
-                    auto bb=computeBollinger(values,20,2.0);
-                    bool bbBreak=false; if (!bb.upper.empty()) { double last=values.back(); bbBreak = (last>bb.upper.back()||last<bb.lower.back()); }
-                    if (bbBreak) { ++votes; lab = lab.isEmpty()? "BB" : lab+"+BB"; }
-                    // Gating by z-score and recent volatility
-                    double zAbs = std::abs(computeZScore(values, std::min<int>(50,(int)values.size())));
-                    bool volGate=false; {
-                        int N = std::min<int>(40, (int)values.size()-1);
-                        if (N>10) {
-                            std::vector<double> rets; rets.reserve(N);
-                            for (int i=(int)values.size()-N; i<(int)values.size(); ++i) { if (i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev) : 0.0); }
-                            std::vector<double> tmp = rets; std::nth_element(tmp.begin(), tmp.begin()+tmp.size()/2, tmp.end()); double med = tmp[tmp.size()/2];
-                            double last = rets.back(); volGate = (med>1e-9 && last/med >= 1.8);
-                        }
-                    }
-                    bool trigger = (votes>=2) || (votes>=1 && zAbs>=2.0) || (votes>=1 && volGate && zAbs>=1.5);
-                    if (trigger) { anomalyActive=true; anomalyLabel=lab; }
-                    break; }
-                case AnomalyMode::RSIDivergence: {
-                    auto rsi = computeRSI(values, 14);
-                    auto findPeaks = [](const std::vector<double>& v, bool maxPeaks){ std::vector<int> idx; for (int i=1;i+1<(int)v.size();++i){ if (maxPeaks){ if (v[i]>v[i-1] && v[i]>v[i+1]) idx.push_back(i);} else { if (v[i]<v[i-1] && v[i]<v[i+1]) idx.push_back(i);} } return idx; };
-                    if (values.size()>=10 && rsi.size()==values.size()) {
-                        auto maxP = findPeaks(values, true); auto maxR = findPeaks(rsi, true);
-                        if (maxP.size()>=2 && maxR.size()>=2) {
-                            int p2 = maxP.back(), p1 = maxP[maxP.size()-2]; int r2 = maxR.back(), r1 = maxR[maxR.size()-2];
-                            if (values[p2] > values[p1] && rsi[r2] < rsi[r1]) { anomalyActive=true; anomalyLabel = "DIV-"; }
-                        }
-                        auto minP = findPeaks(values, false); auto minR = findPeaks(rsi, false);
-                        if (minP.size()>=2 && minR.size()>=2) {
-                            int p2 = minP.back(), p1 = minP[minP.size()-2]; int r2 = minR.back(), r1 = minR[minR.size()-2];
-                            if (values[p2] < values[p1] && rsi[r2] > rsi[r1]) { anomalyActive=true; anomalyLabel = "DIV+"; }
-                        }
-                    }
-                    break; }
-                case AnomalyMode::MACDHistSurge: {
-                    auto m = computeMACD(values);
-                    if (m.macd.size()>5 && m.signal.size()>5) {
-                        std::vector<double> hist(m.macd.size()); for (size_t i=0;i<hist.size();++i) hist[i]=m.macd[i]-m.signal[i];
-                        int N = std::min<int>(50, (int)hist.size()); if (N>10) {
-                            std::vector<double> window(hist.end()-N, hist.end()); for (auto& x:window) x=std::abs(x);
-                            std::nth_element(window.begin(), window.begin()+window.size()/2, window.end()); double med = window[window.size()/2];
-                            double last = std::abs(hist.back()); if (last > med*2.5) { anomalyActive=true; anomalyLabel="HIST"; }
-                        }
+        evaluateAnomaly(cachedProcessedHistory, priceIndicators);
+        if (modeView=="speedometer" && (oldActive!=anomalyActive || oldLabel!=anomalyLabel)) framePending = true; // badge rect repainted by the next frame
+    }
+}
+
+// Shared by the speedometer badge (cacheChartData) and the chart view (updateChartSeries); reads indicator state from ind
+void DynamicSpeedometerCharts::evaluateAnomaly(const std::vector<double>& values, const IndicatorEngine& ind) {
+    anomalyActive = false; anomalyLabel.clear();
+    if (values.empty()) return;
+    static const std::vector<double> none;
+    const std::vector<double>& rsi = ind.hasRSI() ? ind.rsi() : none;
+    const std::vector<double>& macd = ind.hasMACD() ? ind.macd() : none;
+    const std::vector<double>& signal = ind.hasMACD() ? ind.signal() : none;
+    switch (anomalyMode) {
+        case AnomalyMode::RSIOverboughtOversold: {
+            if (!rsi.empty()) { double last=rsi.back(); if (last>=70.0) { anomalyActive=true; anomalyLabel="RSI↑"; } else if (last<=30.0) { anomalyActive=true; anomalyLabel="RSI↓"; } }
+            break; }
+        case AnomalyMode::MACDCross: {
+            if (macd.size()>1 && signal.size()>1) {
+                double pd = macd[macd.size()-2]-signal[signal.size()-2];
+                double ld = macd.back()-signal.back();
+                if (pd<=0 && ld>0) { anomalyActive=true; anomalyLabel="MACD↑"; }
+                else if (pd>=0 && ld<0) { anomalyActive=true; anomalyLabel="MACD↓"; }
+            }
+            break; }
+        case AnomalyMode::BollingerBreakout: {
+            if (ind.hasBollinger()) { double last=values.back(); if (last>ind.bbUpper().back()) { anomalyActive=true; anomalyLabel="BB↑"; } else if (last<ind.bbLower().back()) { anomalyActive=true; anomalyLabel="BB↓"; } }
+            break; }
+        case AnomalyMode::ZScore: {
+            double zs = computeZScore(values, std::min<int>(50,(int)values.size())); if (std::abs(zs)>=2.0) { anomalyActive=true; anomalyLabel = (zs>0? "Z↑" : "Z↓"); }
+            break; }
+        case AnomalyMode::VolSpike: {
+            int N = std::min<int>(50, (int)values.size()-1);
+            if (N>10) {
+                std::vector<double> rets; rets.reserve(N);
+                for (int i=(int)values.size()-N; i<(int)values.size(); ++i) { if (i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev) : 0.0); }
+                if (rets.size()>5) { std::vector<double> tmp = rets; std::nth_element(tmp.begin(), tmp.begin()+tmp.size()/2, tmp.end()); double med = tmp[tmp.size()/2]; double last = rets.back(); if (last>med*2.5) { anomalyActive=true; anomalyLabel="VOL"; } }
+            }
+            break; }
+        case AnomalyMode::Composite: {
+            QString lab; int votes = 0;
+            bool rsiExtreme = (!rsi.empty() && (rsi.back()>=75.0 || rsi.back()<=25.0));
+            if (rsiExtreme) { ++votes; lab = lab.isEmpty()? "RSI" : lab+"+RSI"; }
+            bool macdCross=false; if (macd.size()>1 && signal.size()>1) {
+                double pd=macd[macd.size()-2]-signal[signal.size()-2];
+                double ld=macd.back()-signal.back();
+                macdCross = ((pd<=0&&ld>0)||(pd>=0&&ld<0));
+            }
+            if (macdCross) { ++votes; lab = lab.isEmpty()? "MACD" : lab+"+MACD"; }
+            bool bbBreak=false; if (ind.hasBollinger()) { double last=values.back(); bbBreak = (last>ind.bbUpper().back()||last<ind.bbLower().back()); }
+            if (bbBreak) { ++votes; lab = lab.isEmpty()? "BB" : lab+"+BB"; }
+            double zAbs = std::abs(computeZScore(values, std::min<int>(50,(int)values.size())));
+            bool volGate=false; {
+                int N = std::min<int>(40, (int)values.size()-1);
+                if (N>10) {
+                    std::vector<double> rets; rets.reserve(N);
+                    for (int i=(int)values.size()-N; i<(int)values.size(); ++i) { if (i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev) : 0.0); }
+                    std::vector<double> tmp = rets; std::nth_element(tmp.begin(), tmp.begin()+tmp.size()/2, tmp.end()); double med = tmp[tmp.size()/2];
+                    double last = rets.back(); volGate = (med>1e-9 && last/med >= 1.8);
+                }
+            }
+            bool trigger = (votes>=2) || (votes>=1 && zAbs>=2.0) || (votes>=1 && volGate && zAbs>=1.5);
+            if (trigger) { anomalyActive=true; anomalyLabel=lab; }
+            break; }
+        case AnomalyMode::RSIDivergence: {
+            // Простая дивергенция: последние 2 локальных экстремума цены и RSI противоположно направлены
+            auto findPeaks = [](const std::vector<double>& v, bool maxPeaks){ std::vector<int> idx; for (int i=1;i+1<(int)v.size();++i){ if (maxPeaks){ if (v[i]>v[i-1] && v[i]>v[i+1]) idx.push_back(i);} else { if (v[i]<v[i-1] && v[i]<v[i+1]) idx.push_back(i);} } return idx; };
+            if (values.size()>=10 && rsi.size()==values.size()) {
+                auto maxP = findPeaks(values, true); auto maxR = findPeaks(rsi, true);
+                if (maxP.size()>=2 && maxR.size()>=2) {
+                    int p2 = maxP.back(), p1 = maxP[maxP.size()-2];
+                    int r2 = maxR.back(), r1 = maxR[maxR.size()-2];
+                    if (p1< p2 && r1< r2) {
+                        // Медвежья дивергенция: цена делает выше максимум, RSI нет
+                        if (values[p2] > values[p1] && rsi[r2] < rsi[r1]) { anomalyActive=true; anomalyLabel = "DIV-"; }
                     }
-                    break; }
-                case AnomalyMode::ClusteredZ: {
-                    auto rsi = computeRSI(values, 14);
-                    auto m = computeMACD(values);
-                    auto zVal = [&](const std::vector<double>& v){ return computeZScore(v, std::min<int>(50,(int)v.size())); };
-                    double z1 = computeZScore(values, std::min<int>(50,(int)values.size()));
-                    double z2 = rsi.empty()? 0.0 : zVal(rsi);
-                    double z3 = 0.0; if (!m.macd.empty()) { z3 = zVal(m.macd); }
-                    double z = (z1 + z2 + z3) / 3.0; if (std::abs(z) >= 2.2) { anomalyActive=true; anomalyLabel = (z>0? "CZ↑" : "CZ↓"); }
-                    break; }
-                case AnomalyMode::VolRegimeShift: {
-                    int N = std::min<int>(120, (int)values.size()-1);
-                    if (N>30) {
-                        std::vector<double> rets; rets.reserve(N); for (int i=(int)values.size()-N;i<(int)values.size();++i){ if(i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev):0.0); }
-                        int half = (int)rets.size()/2; if (half>5) {
-                            auto avg = [](const std::vector<double>& a){ double s=0; for(double x:a) s+=x; return s/(double)a.size(); };
-                            double avgOld = avg(std::vector<double>(rets.begin(), rets.begin()+half));
-                            double avgNew = avg(std::vector<double>(rets.begin()+half, rets.end()));
-                            if (avgOld>1e-12 && (avgNew/avgOld >= 1.8)) { anomalyActive=true; anomalyLabel = "VOL↑"; }
-                            else if (avgNew<1e-12 && avgOld>1e-12) { anomalyActive=true; anomalyLabel = "VOL↓"; }
-                        }
+                }
+                auto minP = findPeaks(values, false); auto minR = findPeaks(rsi, false);
+                if (minP.size()>=2 && minR.size()>=2) {
+                    int p2 = minP.back(), p1 = minP[minP.size()-2];
+                    int r2 = minR.back(), r1 = minR[minR.size()-2];
+                    if (p1< p2 && r1< r2) {
+                        // Бычья дивергенция: цена ниже минимум, RSI нет
+                        if (values[p2] < values[p1] && rsi[r2] > rsi[r1]) { anomalyActive=true; anomalyLabel = "DIV+"; }
                     }
-                    break; }
-                default: break;
+                }
             }
-        }
-        if (modeView=="speedometer" && (oldActive!=anomalyActive || oldLabel!=anomalyLabel)) update();
+            break; }
+        case AnomalyMode::MACDHistSurge: {
+            if (macd.size()>5 && signal.size()>5) {
+                // гистограмма = MACD - signal; surge: |последняя| > медианы×k
+                int N = std::min<int>(50, (int)macd.size()); if (N>10) {
+                    std::vector<double> window; window.reserve(N); for (size_t i=macd.size()-N; i<macd.size(); ++i) window.push_back(std::abs(macd[i]-signal[i]));
+                    const double last = window.back();
+                    std::nth_element(window.begin(), window.begin()+window.size()/2, window.end()); double med = window[window.size()/2];
+                    if (last > med*2.5) { anomalyActive=true; anomalyLabel="HIST"; }
+                }
+            }
+            break; }
+        case AnomalyMode::ClusteredZ: {
+            // Комбинированный Z-Score: средний Z трех нормированных метрик: цена, RSI, MACD
+            auto zVal = [&](const std::vector<double>& v){ return computeZScore(v, std::min<int>(50,(int)v.size())); };
+            double z1 = computeZScore(values, std::min<int>(50,(int)values.size()));
+            double z2 = rsi.empty()? 0.0 : zVal(rsi);
+            double z3 = 0.0; if (!macd.empty()) { z3 = zVal(macd); }
+            double z = (z1 + z2 + z3) / 3.0; if (std::abs(z) >= 2.2) { anomalyActive=true; anomalyLabel = (z>0? "CZ↑" : "CZ↓"); }
+            break; }
+        case AnomalyMode::VolRegimeShift: {
+            // Изменение режима волатильности: скользящее среднее |ретёрнов| пересекло порог (или ratio short/long)
+            int N = std::min<int>(120, (int)values.size()-1);
+            if (N>30) {
+                std::vector<double> rets; rets.reserve(N); for (int i=(int)values.size()-N;i<(int)values.size();++i){ if(i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev):0.0); }
+                int half = (int)rets.size()/2; if (half>5) {
+                    auto avg = [](const std::vector<double>& a){ double s=0; for(double x:a) s+=x; return s/(double)a.size(); };
+                    double avgOld = avg(std::vector<double>(rets.begin(), rets.begin()+half));
+                    double avgNew = avg(std::vector<double>(rets.begin()+half, rets.end()));
+                    if (avgOld>1e-12 && (avgNew/avgOld >= 1.8)) { anomalyActive=true; anomalyLabel = "VOL↑"; }
+                    else if (avgNew<1e-12 && avgOld>1e-12) { anomalyActive=true; anomalyLabel = "VOL↓"; }
+                }
+            }
+            break; }
+        default: break;
     }
 }
 
+void DynamicSpeedometerCharts::resetSeriesState() {
+    volEstimator.reset(); boundsExtremes.reset(); shortExtremes.reset(); mediumExtremes.reset(); longExtremes.reset();
+    priceDecimator.clear(); ratioDecimator.clear(); btcRatio.release(); priceIndicators.reset(); ratioIndicators.reset();
+    cachedMinVal.reset(); cachedMaxVal.reset(); globalMin.reset(); globalMax.reset();
+}
+
+void DynamicSpeedometerCharts::replaceHistory(const QVector<HistoryPoint>& pts) {
+    std::vector<TimeSeriesStore::Point> v; v.reserve(size_t(pts.size()));
+    for (const auto& p : pts) v.push_back({p.ts, p.value, p.seq, HistoryRing::makeTag(p.source, p.provider, p.market)});
+    TimeSeriesStore::instance().replace(symId, v);
+    resetSeriesState();
+    // Recompute cached metrics and redraw
+    { const auto rd = series(); if (!rd.history().empty()) { updateBounds(rd.history().backValue()); updateVolatility(); } }
+    dataNeedsRedraw = true;
+    if (modeView=="speedometer") update(); else updateChartSeries();
+}
+
 QVector<QPair<double,double>> DynamicSpeedometerCharts::historySnapshot() const {
+    const auto rd = series(); const HistoryRing& history = rd.history();
     QVector<QPair<double,double>> out;
     out.reserve(int(history.size()));
-    for (const auto& p : history) out.push_back({p.ts, p.value});
+    history.forEach(0, [&](double ts, double v){ out.push_back({ts, v}); });
     return out;
 }
 
-std::vector<double> DynamicSpeedometerCharts::processHistory(bool useBtcRatio) {
+std::vector<double> DynamicSpeedometerCharts::processHistory(bool useBtcRatio, std::vector<double>* tsOut) {
+    const auto rd = series(); const HistoryRing& history = rd.history(); const TimePyramid& pyramid = rd.pyramid();
     double now = QDateTime::currentMSecsSinceEpoch()/1000.0; double window = timeScales[currentScale]; double cutoff = now - window;
-    const auto& src = useBtcRatio ? btcRatioHistory : history; std::vector<std::pair<double,double>> filtered; filtered.reserve(src.size());
-    for (const auto& pr : src) if (pr.ts >= cutoff) filtered.push_back({pr.ts, pr.value});
-    if (filtered.size() <= static_cast<size_t>(maxPoints)) { std::vector<double> out; out.reserve(filtered.size()); for (auto& kv:filtered) out.push_back(kv.second); return out; }
-    std::vector<double> samples; samples.reserve(maxPoints); size_t step = std::max<size_t>(1, filtered.size()/maxPoints);
-    for (size_t i=0;i<filtered.size();i+=step) {
-        auto start = filtered.begin()+i; auto end = filtered.begin()+std::min(i+step, filtered.size());
-        if (sampleMethod==0) samples.push_back((end-1)->second);
-        else if (sampleMethod==1) { double sum=0.0; size_t c=0; for (auto it=start; it!=end; ++it) { sum+=it->second; ++c; } samples.push_back(c? sum/c : (end-1)->second); }
-        else { double mx=(start!=end)? start->second : 0.0; for (auto it=start; it!=end; ++it) mx=std::max(mx, it->second); samples.push_back(mx); }
+    // Long scales: read the coarsest pyramid level that still fills maxPoints (groups of buckets beyond that), O(maxPoints)
+    const int level = useBtcRatio ? -1 : TimePyramid::pickLevel(window, maxPoints);
+    if (level >= 0) {
+        const int groups = sampleMethod==4 ? std::max(1, maxPoints / 2) : maxPoints; // min/max emits two samples per group
+        const int group = std::max(1, int(std::ceil(window / TimePyramid::levelSeconds(level) / groups)));
+        // Pyramid buckets are already pixel-sized: LTTB reads closes, min/max reads each group's low/high pair
+        std::vector<double> ts, out; pyramid.sample(level, cutoff, group, sampleMethod==3 ? 0 : sampleMethod==4 ? 3 : sampleMethod, ts, out);
+        if (out.size() > static_cast<size_t>(maxPoints)) { const auto extra = std::ptrdiff_t(out.size()) - maxPoints; ts.erase(ts.begin(), ts.begin()+extra); out.erase(out.begin(), out.begin()+extra); }
+        if (tsOut) *tsOut = std::move(ts);
+        return out;
     }
-    if (samples.size() > static_cast<size_t>(maxPoints)) samples.resize(maxPoints); return samples;
+    const HistoryRing& src = useBtcRatio ? syncBtcRatio() : history;
+    if (sampleMethod >= 3) {
+        // One bucket per pixel column of the chart (two points per column for min/max); only points appended since the
+        // last call are fed, so a tick re-decimates just the tail bucket
+        const bool minMax = sampleMethod == 4;
+        const int plotW = std::max(1, plot.plotArea(rect()).width());
+        const int columns = std::max(minMax ? 25 : 50, std::min(minMax ? maxPoints / 2 : maxPoints, plotW));
+        Decimator& dec = useBtcRatio ? ratioDecimator : priceDecimator;
+        dec.configure(minMax ? Decimator::Mode::MinMax : Decimator::Mode::Lttb, window / columns);
+        const quint64 from = std::max<quint64>(dec.fedUntil(), src.firstIndex() + src.lowerBound(cutoff));
+        src.forEach(size_t(from - src.firstIndex()), [&](double ts, double v){ dec.append(ts, v); });
+        dec.setFedUntil(src.endIndex()); dec.dropBefore(cutoff);
+        std::vector<double> ts, out; dec.output(ts, out);
+        if (out.size() > static_cast<size_t>(maxPoints)) { const auto extra = std::ptrdiff_t(out.size()) - maxPoints; ts.erase(ts.begin(), ts.begin()+extra); out.erase(out.begin(), out.begin()+extra); }
+        if (tsOut) *tsOut = std::move(ts);
+        return out;
+    }
+    // Window located by binary search on the ring's timestamps; buckets are read in place (no filtered copy)
+    const HistoryRing::View win = src.window(cutoff);
+    if (tsOut) tsOut->clear();
+    if (win.size() <= static_cast<size_t>(maxPoints)) { std::vector<double> out; out.reserve(win.size()); if (tsOut) tsOut->reserve(win.size()); win.forEach([&](double ts, double v){ out.push_back(v); if (tsOut) tsOut->push_back(ts); }); return out; }
+    // Buckets of `step` points anchored to the ring's absolute index (a partial front bucket is skipped), so a refresh only
+    // restates the open tail bucket and IndicatorEngine / LinePlot extend instead of replaying. The step is kept while it
+    // yields maxPoints/2..maxPoints samples, so a sliding window does not re-bucket every refresh.
+    size_t& step = useBtcRatio ? ratioStep : priceStep; const size_t cap = size_t(maxPoints);
+    if (step == 0 || (win.size() + step - 1) / step > cap || win.size() / step < cap / 2) step = (win.size() + cap - 1) / cap;
+    const quint64 absFrom = src.firstIndex() + src.lowerBound(cutoff); // absolute index of win[0]
+    std::vector<double> samples; samples.reserve(maxPoints);
+    for (size_t i = size_t((step - absFrom % step) % step); i < win.size(); i += step) {
+        const size_t end = std::min(i+step, win.size());
+        if (tsOut) tsOut->push_back(win.ts(i)); // sample time = start of its bucket (stable while the bucket fills)
+        if (sampleMethod==0) samples.push_back(win.value(end-1));
+        else if (sampleMethod==1) { double sum=0.0; win.forEach(i, end, [&](double, double v){ sum+=v; }); samples.push_back(sum/double(end-i)); }
+        else { double mx=win.value(i); win.forEach(i, end, [&](double, double v){ mx=std::max(mx, v); }); samples.push_back(mx); }
+    }
+    return samples;
+}
+
+const HistoryRing& DynamicSpeedometerCharts::syncBtcRatio() {
+    static const SymbolId btcId = SymbolRegistry::instance().intern("BTC");
+    TimeSeriesStore& store = TimeSeriesStore::instance(); const auto rd = series(); const auto btc = store.read(btcId);
+    const HistoryRing& r = btcRatio.sync(rd.history(), RatioSeries::Reference{&btc.history(), &btc.pyramid()}, symId==btcId);
+    if (btcRatio.epoch() != ratioEpoch) { ratioEpoch = btcRatio.epoch(); ratioDecimator.clear(); }
+    return r;
 }
 
 void DynamicSpeedometerCharts::updateVolatility() {
-    if (history.size()<2) { if (!qFuzzyIsNull(volatility)) { volatility=0.0; emit volatilityChanged(volatility); } return; }
-    size_t window = std::min(static_cast<size_t>(volatilityWindow), history.size());
-    std::vector<double> prices; prices.reserve(window); for (auto it = history.end()-window; it!=history.end(); ++it) prices.push_back(it->value);
-    std::vector<double> rets; rets.reserve(prices.size()-1); for (size_t i=1;i<prices.size();++i) rets.push_back(prices[i-1] ? std::abs((prices[i]-prices[i-1])/prices[i-1]) : 0.0);
-    double newVol = rets.empty()? 0.0 : (std::accumulate(rets.begin(), rets.end(), 0.0)/rets.size())*100.0;
-    if (!qFuzzyCompare(volatility, newVol)) { volatility = newVol; emit volatilityChanged(volatility); }
+    const auto rd = series(); const HistoryRing& history = rd.history();
+    if (history.size()<2) { volEstimator.reset(); if (!qFuzzyIsNull(volatility)) { volatility=0.0; emit volatilityChanged(volatility); } return; }
+    const double newVol = volEstimator.update(history, volatilityWindow);
+    // Emit only on a meaningful change (0.1% relative) rather than on every tick's rounding-level drift
+    if (std::abs(newVol - volatility) > std::max(1e-9, std::abs(volatility) * 1e-3)) { volatility = newVol; emit volatilityChanged(volatility); }
 }
 
 QString DynamicSpeedometerCharts::buildComputedTooltip(const QString& token) const {
@@ -882,6 +1098,7 @@ QString DynamicSpeedometerCharts::buildComputedTooltip(const QString& token) con
 }
 
 void DynamicSpeedometerCharts::updateBounds(double price) {
+    const auto rd = series(); const HistoryRing& history = rd.history();
     if (scalingSettings.mode == ScalingMode::Fixed) {
         cachedMinVal = scalingSettings.fixedMin; cachedMaxVal = scalingSettings.fixedMax; return;
     } else if (scalingSettings.mode == ScalingMode::Manual && cachedMinVal && cachedMaxVal) {
@@ -897,13 +1114,10 @@ void DynamicSpeedometerCharts::updateBounds(double price) {
         if (!cachedMinVal || !cachedMaxVal) { cachedMinVal = price * 0.99; cachedMaxVal = price * 1.01; }
         return;
     }
-    double histMin = std::numeric_limits<double>::max();
-    double histMax = std::numeric_limits<double>::lowest();
-    for (int i = (int)history.size() - windowSize; i < (int)history.size(); ++i) {
-        double val = history[size_t(i)].value;
-        histMin = std::min(histMin, val);
-        histMax = std::max(histMax, val);
-    }
+    // Last windowSize points, maintained incrementally (see WindowExtremes)
+    boundsExtremes.sync(history, windowSize);
+    double histMin = boundsExtremes.min();
+    double histMax = boundsExtremes.max();
     double range = histMax - histMin;
     double padding = range * scalingSettings.paddingPct; // configurable padding
     if (range < 1e-10) padding = std::max(1e-10, histMax * 1e-4);
@@ -976,32 +1190,16 @@ void DynamicSpeedometerCharts::updateBounds(double price) {
         if (!globalMin || price < globalMin.value()) globalMin = price;
         if (!globalMax || price > globalMax.value()) globalMax = price;
         
-        // Calculate extremes for different windows
-        int shortStart = std::max(0, (int)history.size() - shortWindowSize);
-        int mediumStart = std::max(0, (int)history.size() - mediumWindowSize);
-        int longStart = std::max(0, (int)history.size() - longWindowSize);
-        
-        // Find min/max for each window
+        // Find min/max for each window (last 50/200/800 points, maintained incrementally) together with the current price
         double shortHistMin = price, shortHistMax = price;
         double mediumHistMin = price, mediumHistMax = price;
         double longHistMin = price, longHistMax = price;
         
-        for (int i = shortStart; i < (int)history.size(); i++) {
-            double val = history[i].value;
-            shortHistMin = std::min(shortHistMin, val);
-            shortHistMax = std::max(shortHistMax, val);
-        }
-        
-        for (int i = mediumStart; i < (int)history.size(); i++) {
-            double val = history[i].value;
-            mediumHistMin = std::min(mediumHistMin, val);
-            mediumHistMax = std::max(mediumHistMax, val);
-        }
-        
-        for (int i = longStart; i < (int)history.size(); i++) {
-            double val = history[i].value;
-            longHistMin = std::min(longHistMin, val);
-            longHistMax = std::max(longHistMax, val);
+        if (!history.empty()) {
+            shortExtremes.sync(history, shortWindowSize); mediumExtremes.sync(history, mediumWindowSize); longExtremes.sync(history, longWindowSize);
+            shortHistMin = std::min(shortHistMin, shortExtremes.min()); shortHistMax = std::max(shortHistMax, shortExtremes.max());
+            mediumHistMin = std::min(mediumHistMin, mediumExtremes.min()); mediumHistMax = std::max(mediumHistMax, mediumExtremes.max());
+            longHistMin = std::min(longHistMin, longExtremes.min()); longHistMax = std::max(longHistMax, longExtremes.max());
         }
         
         // Update sliding extremes with exponential smoothing
@@ -1021,7 +1219,7 @@ void DynamicSpeedometerCharts::updateBounds(double price) {
         // Calculate volatility and adaptive padding
         double volatility = 0.0;
         if (history.size() > 1) {
-            double prev = history[history.size()-2].value;
+            double prev = history.value(history.size()-2);
             volatility = std::abs(price - prev) / std::abs(prev);
         }
         double adaptivePadding = basePadding * price * (1.0 + volatility * 10.0); // amplify volatility effect
@@ -1086,16 +1284,24 @@ void DynamicSpeedometerCharts::updateBounds(double price) {
 }
 
 void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
+    const auto rd = series(); const HistoryRing& history = rd.history();
     int w = width(), h = height(); int size = std::min(w,h) - 20; QRect rect((w-size)/2,(h-size)/2,size,size);
-    
-    // Use theme background
-    painter.fillRect(0,0,w,h,themeColors.background);
+
+    // Static layer: baked once per style/size/theme/thresholds/frame/DPR, then only needle, texts and overlays are drawn
+    const qreal dpr = painter.device()->devicePixelRatioF(); // widget or offscreen tile image
+    const DialKey key{style, QSize(w,h), dpr, thresholds, themeColors, frameStyle};
+    if (!dialKey || !(*dialKey == key)) {
+        dialCache = QImage(QSize(w,h) * dpr, QImage::Format_ARGB32_Premultiplied); dialCache.setDevicePixelRatio(dpr); dialCache.fill(Qt::transparent);
+        QPainter dp(&dialCache); dp.setRenderHint(QPainter::Antialiasing); drawDial(dp, w, h);
+        dialKey = key;
+    }
+    painter.drawImage(0, 0, dialCache);
 
     auto drawCommonTexts = [&](QColor textColor = QColor()){
         // Use theme text color if no override
         if (!textColor.isValid()) textColor = themeColors.text;
         painter.setPen(textColor); painter.setFont(QFont("Arial",21, QFont::Bold)); painter.drawText(QRect(0,h/2-50,w,20), Qt::AlignCenter, currency);
-    if (!history.empty()) { double currentPrice = history.back().value; painter.setFont(QFont("Arial",21, QFont::Bold)); painter.drawText(QRect(0,h/2+20,w,20), Qt::AlignCenter, QLocale().toString(currentPrice,'f',3)); }
+    if (!history.empty()) { double currentPrice = history.backValue(); painter.setFont(QFont("Arial",21, QFont::Bold)); painter.drawText(QRect(0,h/2+20,w,20), Qt::AlignCenter, QLocale().toString(currentPrice,'f',3)); }
         painter.setFont(QFont("Arial",8)); painter.setPen(Qt::yellow); painter.drawText(QRect(1,h-50,w-10,20), Qt::AlignLeft|Qt::AlignBottom, QString("Trades: %1").arg(history.size()));
         painter.setFont(QFont("Arial",6)); painter.setPen(textColor); painter.drawText(QRect(1,1,w-10,20), Qt::AlignLeft|Qt::AlignTop, QString("Volatility: %1%\n").arg(volatility,0,'f',4));
         // market/provider badge top-right (auto-sized narrower)
@@ -1127,12 +1333,7 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
     switch (style) {
         case SpeedometerStyle::Classic: {
             int needleW = std::clamp(int(size/120), 2, 6);
-            painter.setPen(QPen(themeColors.arcBase, std::clamp(int(size/80), 3, 6)));
-            painter.drawArc(rect, 45*16, 270*16);
             int warn = thresholds.warn, danger = thresholds.danger; if (!thresholds.enabled) { warn=70; danger=90; }
-            struct Zone{double s,e; QColor c;}; 
-            std::vector<Zone> zones={{0,double(warn),themeColors.zoneGood},{double(warn),double(danger),themeColors.zoneWarn},{double(danger),100.0,themeColors.zoneDanger}};
-            for (const auto& z:zones) { painter.setPen(QPen(z.c, std::clamp(int(size/60), 5, 10))); double span=(z.e-z.s)*270/100; double za=45+(270*z.s/100); painter.drawArc(rect, int(za*16), int(span*16)); }
             QColor needle = (!thresholds.enabled)? themeColors.needleNormal : (_value>=danger? themeColors.zoneDanger : (_value>=warn? themeColors.zoneWarn : themeColors.needleNormal));
             painter.setPen(QPen(needle, needleW)); painter.translate(w/2,h/2); painter.rotate(angle);
             int tipRx = std::clamp(int(size/10), 10, 26);
@@ -1172,10 +1373,7 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
         }
         case SpeedometerStyle::SegmentBar: {
             // SegmentBar: bold segmented progress along the arc with clear gaps
-            painter.setPen(QPen(themeColors.arcBase, 2));
             QRect base = rect.adjusted(12,12,-12,-12);
-            painter.drawArc(base, 45*16, 270*16);
-
             int warn = thresholds.warn, danger = thresholds.danger; if (!thresholds.enabled) { warn=70; danger=90; }
             QColor indicator = (_value>=danger? themeColors.zoneDanger : (_value>=warn? themeColors.zoneWarn : themeColors.zoneGood));
             painter.setPen(QPen(indicator, 8, Qt::SolidLine, Qt::RoundCap));
@@ -1190,7 +1388,7 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
             // Minimal central label
             painter.setPen(themeColors.text);
             painter.setFont(QFont("Arial", 18, QFont::DemiBold));
-            QString valueText = history.empty() ? QString("0.000") : QLocale().toString(history.back().value, 'f', 3);
+            QString valueText = history.empty() ? QString("0.000") : QLocale().toString(history.backValue(), 'f', 3);
             painter.drawText(QRect(0, h/2-18, w, 24), Qt::AlignCenter, valueText);
             painter.setFont(QFont("Arial", 9));
             painter.setPen(themeColors.text.lighter());
@@ -1202,12 +1400,6 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
             QRect outer = rect.adjusted(6,6,-6,-6);
             QRect inner = rect.adjusted(22,22,-22,-22);
 
-            // Base arcs
-            painter.setPen(QPen(themeColors.arcBase, 2));
-            painter.drawArc(outer, 45*16, 270*16);
-            painter.setPen(QPen(themeColors.arcBase.lighter(130), 2));
-            painter.drawArc(inner, 45*16, 270*16);
-
             // Outer progress (value)
             int warn = thresholds.warn, danger = thresholds.danger; if (!thresholds.enabled) { warn=70; danger=90; }
             QColor outerColor = (_value>=danger? themeColors.zoneDanger : (_value>=warn? themeColors.zoneWarn : themeColors.zoneGood));
@@ -1230,7 +1422,7 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
             painter.setFont(QFont("Arial", 10, QFont::DemiBold));
             painter.drawText(QRect(0, h/2+14, w, 16), Qt::AlignCenter, currency);
             painter.setFont(QFont("Arial", 16, QFont::Bold));
-            QString valStr = history.empty() ? QString("0.000") : QLocale().toString(history.back().value, 'f', 3);
+            QString valStr = history.empty() ? QString("0.000") : QLocale().toString(history.backValue(), 'f', 3);
             painter.drawText(QRect(0, h/2-28, w, 24), Qt::AlignCenter, valStr);
 
             // Volatility tag in corner
@@ -1240,82 +1432,21 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
             break;
         }
         case SpeedometerStyle::NeonGlow: {
-            // Darker background for neon effect, but still use theme tint
-            QColor neonBg = themeColors.background.darker(150);
-            painter.fillRect(0,0,w,h,neonBg);
-            QRadialGradient rg(rect.center(), rect.width()/2.0);
-            rg.setColorAt(0.0, QColor(themeColors.glow.red(), themeColors.glow.green(), themeColors.glow.blue(), 60));
-            rg.setColorAt(0.6, QColor(themeColors.glow.red(), themeColors.glow.green(), themeColors.glow.blue(), 15));
-            rg.setColorAt(1.0, QColor(0,0,0,0));
-            painter.setBrush(rg); painter.setPen(Qt::NoPen); painter.drawEllipse(rect.adjusted(-10,-10,10,10));
             int warn = thresholds.warn, danger = thresholds.danger; if (!thresholds.enabled) { warn=70; danger=90; }
-            auto glowPen = [&](double s,double e,QColor base,int w){ QPen p(QBrush(base), w); p.setCapStyle(Qt::RoundCap); painter.setPen(p); double span=(e-s)*270/100; double za=45+(270*s/100); painter.drawArc(rect, int(za*16), int(span*16)); };
-            glowPen(0, warn, QColor(themeColors.zoneGood.red(), themeColors.zoneGood.green(), themeColors.zoneGood.blue(), 190), 4); 
-            glowPen(warn, danger, QColor(themeColors.zoneWarn.red(), themeColors.zoneWarn.green(), themeColors.zoneWarn.blue(), 190), 4); 
-            glowPen(danger, 100, QColor(themeColors.zoneDanger.red(), themeColors.zoneDanger.green(), themeColors.zoneDanger.blue(), 190), 4);
             QColor needle = (_value>=danger? themeColors.zoneDanger : (_value>=warn? themeColors.zoneWarn : themeColors.glow));
             painter.setPen(QPen(needle, 5, Qt::SolidLine, Qt::RoundCap)); painter.translate(w/2,h/2); painter.rotate(angle); painter.drawLine(0,0,size/2-18,0); painter.resetTransform();
             painter.setPen(themeColors.glow); drawCommonTexts(themeColors.text.lighter());
             break;
         }
         case SpeedometerStyle::Minimal: {
-            painter.setPen(QPen(themeColors.arcBase, 2, Qt::DashLine)); painter.drawArc(rect.adjusted(10,10,-10,-10), 45*16, 270*16);
             QColor needle = (!thresholds.enabled)? themeColors.needleNormal : (_value>=thresholds.danger? themeColors.zoneDanger : (_value>=thresholds.warn? themeColors.zoneWarn : themeColors.needleNormal));
             painter.setPen(QPen(needle, 3)); painter.translate(w/2,h/2); painter.rotate(angle); painter.drawLine(0,0,size/2-10,0); painter.resetTransform();
             drawCommonTexts();
             break;
         }
         case SpeedometerStyle::ModernTicks: {
-            // KiloCode Modern Ticks — multi-layer arcs, variable ticks, outside numerals, gradient needle, volumetric hub
+            // KiloCode Modern Ticks — multi-layer arcs, variable ticks, outside numerals (dial layer), gradient needle, volumetric hub
             painter.save();
-            // Background accent
-            painter.fillRect(rect.adjusted(-6,-6,6,6), themeColors.background);
-            // Outer and inner arcs
-            QRect outer = rect.adjusted(6,6,-6,-6);
-            QRect inner = rect.adjusted(18,18,-18,-18);
-            // Base multi-level arcs with subtle gradients
-            QConicalGradient g1(outer.center(), -45);
-            g1.setColorAt(0.00, themeColors.arcBase.lighter(110));
-            g1.setColorAt(0.25, themeColors.arcBase);
-            g1.setColorAt(0.75, themeColors.arcBase.darker(105));
-            g1.setColorAt(1.00, themeColors.arcBase.lighter(110));
-            painter.setPen(QPen(QBrush(g1), 3, Qt::SolidLine, Qt::RoundCap));
-            painter.drawArc(outer, 45*16, 270*16);
-            painter.setPen(QPen(themeColors.arcBase.lighter(140), 2, Qt::SolidLine, Qt::RoundCap));
-            painter.drawArc(inner, 45*16, 270*16);
-
-            // Subtle auxiliary arc for structure
-            QRect aux = rect.adjusted(28,28,-28,-28);
-            painter.setPen(QPen(themeColors.arcBase.darker(115), 1, Qt::DotLine));
-            painter.drawArc(aux, 45*16, 270*16);
-
-            // Segmented scale with variable-length ticks: long (0/25/50/75/100), medium (x10), short (x5)
-            painter.save(); painter.translate(w/2, h/2);
-            for (int v=0; v<=100; v+=5) {
-                painter.save(); double a = 45 + 270.0*v/100.0; painter.rotate(a);
-                int tOuter = size/2 - 8;
-                int len = 6; int thick = 1; QColor tc = themeColors.text;
-                if (v%25==0) { len = 18; thick = 3; tc = themeColors.text; }
-                else if (v%10==0) { len = 12; thick = 2; tc = themeColors.text.lighter(120); }
-                else { len = 7; thick = 1; tc = themeColors.text.lighter(150); }
-                painter.setPen(QPen(tc, thick, Qt::SolidLine, Qt::RoundCap));
-                painter.drawLine(tOuter-len, 0, tOuter, 0);
-                painter.restore();
-            }
-
-            // Numbers placed just outside the main arc with tiny drop shadow
-            for (int v : {0,25,50,75,100}) {
-                painter.save(); double a = 45 + 270.0*v/100.0; painter.rotate(a);
-                QPoint pos(size/2 - 30, 0);
-                painter.rotate(-a);
-                QFont f("Arial", 9, QFont::DemiBold); painter.setFont(f);
-                // shadow
-                painter.setPen(QPen(QColor(0,0,0,120), 1)); painter.drawText(pos + QPoint(1,1), QString::number(v));
-                painter.setPen(themeColors.text); painter.drawText(pos, QString::number(v));
-                painter.restore();
-            }
-            painter.restore();
-
             // Gradient needle with glow and sharp tip
             painter.save(); painter.translate(w/2, h/2); painter.rotate(angle);
             QLinearGradient ng(QPointF(0,0), QPointF(size/2-16, 0));
@@ -1358,57 +1489,11 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
             break;
         }
     case SpeedometerStyle::Circle: {
-            // Classic Pro: Traditional speedometer with modern refinements
-            // Main arc with subtle gradient
+            // Classic Pro: Traditional speedometer with modern refinements (arc, ticks and zones in the dial layer)
             int needleW = std::clamp(int(size/120), 2, 6);
-            painter.setPen(QPen(themeColors.arcBase, std::clamp(int(size/80), 3, 6))); 
-            painter.drawArc(rect.adjusted(8,8,-8,-8), 45*16, 270*16);
-            
-            // Draw major tick marks (every 20 units)
-            painter.setPen(QPen(themeColors.text, 2));
-            for (int v=0; v<=100; v+=20) {
-                painter.save(); painter.translate(w/2, h/2); 
-                double a = 45 + 270.0*v/100.0; painter.rotate(a);
-                int outer = size/2 - 8, inner = size/2 - 18;
-                painter.drawLine(outer, 0, inner, 0); painter.restore();
-            }
-            
-            // Draw minor tick marks (every 10 units)
-            painter.setPen(QPen(themeColors.text.lighter(), 1));
-            for (int v=10; v<=90; v+=20) {
-                // first minor tick
-                painter.save(); painter.translate(w/2, h/2);
-                double a1 = 45 + 270.0*v/100.0; painter.rotate(a1);
-                { int outer = size/2 - 8, inner = size/2 - 13; painter.drawLine(outer, 0, inner, 0); }
-                painter.restore();
-                // second minor tick (v+10)
-                painter.save(); painter.translate(w/2, h/2);
-                double a2 = 45 + 270.0*(v+10)/100.0; painter.rotate(a2);
-                { int outer = size/2 - 8, inner = size/2 - 13; painter.drawLine(outer, 0, inner, 0); }
-                painter.restore();
-            }
-            
-            // Colored zones with threshold support
             int warn = thresholds.warn, danger = thresholds.danger; 
             if (!thresholds.enabled) { warn=70; danger=90; }
             
-            // Good zone (green)
-            painter.setPen(QPen(themeColors.zoneGood, 8, Qt::SolidLine, Qt::RoundCap));
-            double goodSpan = warn * 270.0 / 100.0;
-            painter.drawArc(rect, 45*16, int(goodSpan*16));
-            
-            // Warning zone (yellow/orange)
-            painter.setPen(QPen(themeColors.zoneWarn, 8, Qt::SolidLine, Qt::RoundCap));
-            double warnStart = 45 + goodSpan;
-            double warnSpan = (danger - warn) * 270.0 / 100.0;
-            painter.drawArc(rect, int(warnStart*16), int(warnSpan*16));
-            
-            // Danger zone (red)
-            painter.setPen(QPen(themeColors.zoneDanger, 8, Qt::SolidLine, Qt::RoundCap));
-            double dangerStart = warnStart + warnSpan;
-            double dangerSpan = (100 - danger) * 270.0 / 100.0;
-            painter.drawArc(rect, int(dangerStart*16), int(dangerSpan*16));
-            
             // Classic needle with red tip
             QColor needleColor = (!thresholds.enabled)? themeColors.needleNormal : 
                 (_value>=danger? themeColors.zoneDanger : (_value>=warn? themeColors.zoneWarn : themeColors.needleNormal));
@@ -1452,18 +1537,8 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
             break;
         }
         case SpeedometerStyle::Gauge: {
-            // Minimalist Gauge: subdued base arc + thin multi-zone accents + refined indicator
-            QColor base = themeColors.arcBase;
-            painter.setPen(QPen(base, 2));
-            QRect r2 = rect.adjusted(10,10,-10,-10);
-            painter.drawArc(r2, 45*16, 270*16);
-
+            // Minimalist Gauge: subdued base arc + thin multi-zone accents + sparse ticks (dial layer) + refined indicator
             int warn = thresholds.warn, danger = thresholds.danger; if (!thresholds.enabled) { warn=70; danger=90; }
-            auto faint = [](QColor c){ c.setAlpha(140); return c; };
-            // Subtle zones
-            painter.setPen(QPen(faint(themeColors.zoneGood), 3)); painter.drawArc(r2, 45*16, int((warn*270.0/100.0)*16));
-            painter.setPen(QPen(faint(themeColors.zoneWarn), 3)); painter.drawArc(r2, int((45 + warn*270.0/100.0)*16), int(((danger-warn)*270.0/100.0)*16));
-            painter.setPen(QPen(faint(themeColors.zoneDanger), 3)); painter.drawArc(r2, int((45 + danger*270.0/100.0)*16), int(((100-danger)*270.0/100.0)*16));
 
             // Slim indicator with soft tip
             QColor indicatorColor = (!thresholds.enabled)? themeColors.text : (_value>=danger? themeColors.zoneDanger : (_value>=warn? themeColors.zoneWarn : themeColors.zoneGood));
@@ -1475,48 +1550,11 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
             painter.setBrush(indicatorColor.lighter()); painter.setPen(Qt::NoPen);
             painter.drawEllipse(QPoint(endR, 0), 4, 4);
             painter.restore();
-
-            // Sparse ticks
-            painter.setPen(QPen(themeColors.text.lighter(), 1));
-            for (int v=0; v<=100; v+=25) {
-                painter.save(); painter.translate(w/2, h/2); double a = 45 + 270.0*v/100.0; painter.rotate(a);
-                int t = size/2 - 8; painter.drawLine(t-3,0,t,0); painter.restore();
-            }
             drawCommonTexts();
             break;
         }
         case SpeedometerStyle::Ring: {
-            // Modern Scale: Contemporary linear-style scale design
-            // Background arc - thin and subtle
-            painter.setPen(QPen(themeColors.arcBase.lighter(), 2)); 
-            painter.drawArc(rect.adjusted(15,15,-15,-15), 45*16, 270*16);
-            
-            // Modern scale marks - clean lines radiating outward
-            painter.setPen(QPen(themeColors.text, 2));
-            for (int v=0; v<=100; v+=10) {
-                painter.save(); painter.translate(w/2, h/2); 
-                double a = 45 + 270.0*v/100.0; painter.rotate(a);
-                
-                // Different lengths for major/minor marks
-                int outer = size/2 - 15;
-                int inner = (v % 20 == 0) ? size/2 - 30 : size/2 - 22; // Major vs minor
-                int thickness = (v % 20 == 0) ? 3 : 1;
-                
-                painter.setPen(QPen(themeColors.text, thickness));
-                painter.drawLine(outer, 0, inner, 0);
-                
-                // Scale numbers for major marks
-                if (v % 20 == 0) {
-                    painter.save();
-                    painter.translate(inner - 15, 0);
-                    painter.rotate(-a); // Counter-rotate text
-                    painter.setFont(QFont("Arial", 8, QFont::Bold));
-                    painter.drawText(-10, -5, 20, 10, Qt::AlignCenter, QString::number(v));
-                    painter.restore();
-                }
-                painter.restore();
-            }
-            
+            // Modern Scale: Contemporary linear-style scale design (arc and scale marks in the dial layer)
             // Progress indicator - modern segmented arc
             int warn = thresholds.warn, danger = thresholds.danger; 
             if (!thresholds.enabled) { warn=70; danger=90; }
@@ -1552,7 +1590,7 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
             painter.setFont(QFont("Arial", 18, QFont::Light));
             QString valueText;
             if (!history.empty()) {
-                double currentPrice = history.back().value;
+                double currentPrice = history.backValue();
                 valueText = QLocale().toString(currentPrice, 'f', 3);
             } else {
                 valueText = "0.000";
@@ -1573,19 +1611,7 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
         double t = std::clamp(volNorm, 0.0, 1.0);
         if (volVis == VolumeVis::Sidebar) {
             // Right-aligned vertical segmented bar from near top to bottom
-            int marginR = 6;
-            // Width by mode
-            int autoW = std::clamp(int(std::min(width(), height())/24), 6, 14);
-            int barW = autoW;
-            if (sidebarWidthMode==1) barW = std::max(6, autoW-3);
-            else if (sidebarWidthMode==2) barW = autoW; // medium
-            else if (sidebarWidthMode==3) barW = autoW + 4; // wide
-            int topY = providerName.isEmpty()? 6 : 26; // leave room for provider badge
-            // Also leave room for chips if enabled
-            if (showVolOverlay || showChangeOverlay) topY = std::max(topY, 8);
-            int bottomY = height()-8;
-            if (bottomY - topY < 24) { topY = 6; bottomY = height()-6; }
-            QRect barRect(width()-barW-marginR, topY, barW, bottomY-topY);
+            const QRect barRect = sidebarRect();
             // Background
             QColor bg = themeColors.arcBase; bg.setAlpha(90);
             // Outline if enabled
@@ -1702,11 +1728,210 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
         QString t = QString::fromUtf8("Δ: %1%").arg(change,0,'f',2);
         drawChip(t, QPoint(x,y), QColor(200,120,60)); y+=26;
     }
+}
+
+void DynamicSpeedometerCharts::drawDial(QPainter& painter, int w, int h) const {
+    int size = std::min(w,h) - 20; QRect rect((w-size)/2,(h-size)/2,size,size);
+    // Use theme background
+    painter.fillRect(0,0,w,h,themeColors.background);
+    int warn = thresholds.warn, danger = thresholds.danger; if (!thresholds.enabled) { warn=70; danger=90; }
+
+    switch (style) {
+        case SpeedometerStyle::Classic: {
+            painter.setPen(QPen(themeColors.arcBase, std::clamp(int(size/80), 3, 6)));
+            painter.drawArc(rect, 45*16, 270*16);
+            struct Zone{double s,e; QColor c;}; 
+            std::vector<Zone> zones={{0,double(warn),themeColors.zoneGood},{double(warn),double(danger),themeColors.zoneWarn},{double(danger),100.0,themeColors.zoneDanger}};
+            for (const auto& z:zones) { painter.setPen(QPen(z.c, std::clamp(int(size/60), 5, 10))); double span=(z.e-z.s)*270/100; double za=45+(270*z.s/100); painter.drawArc(rect, int(za*16), int(span*16)); }
+            break;
+        }
+        case SpeedometerStyle::SegmentBar: {
+            painter.setPen(QPen(themeColors.arcBase, 2));
+            painter.drawArc(rect.adjusted(12,12,-12,-12), 45*16, 270*16);
+            break;
+        }
+        case SpeedometerStyle::DualArc: {
+            // Base arcs
+            painter.setPen(QPen(themeColors.arcBase, 2));
+            painter.drawArc(rect.adjusted(6,6,-6,-6), 45*16, 270*16);
+            painter.setPen(QPen(themeColors.arcBase.lighter(130), 2));
+            painter.drawArc(rect.adjusted(22,22,-22,-22), 45*16, 270*16);
+            break;
+        }
+        case SpeedometerStyle::NeonGlow: {
+            // Darker background for neon effect, but still use theme tint
+            QColor neonBg = themeColors.background.darker(150);
+            painter.fillRect(0,0,w,h,neonBg);
+            QRadialGradient rg(rect.center(), rect.width()/2.0);
+            rg.setColorAt(0.0, QColor(themeColors.glow.red(), themeColors.glow.green(), themeColors.glow.blue(), 60));
+            rg.setColorAt(0.6, QColor(themeColors.glow.red(), themeColors.glow.green(), themeColors.glow.blue(), 15));
+            rg.setColorAt(1.0, QColor(0,0,0,0));
+            painter.setBrush(rg); painter.setPen(Qt::NoPen); painter.drawEllipse(rect.adjusted(-10,-10,10,10));
+            auto glowPen = [&](double s,double e,QColor base,int w){ QPen p(QBrush(base), w); p.setCapStyle(Qt::RoundCap); painter.setPen(p); double span=(e-s)*270/100; double za=45+(270*s/100); painter.drawArc(rect, int(za*16), int(span*16)); };
+            glowPen(0, warn, QColor(themeColors.zoneGood.red(), themeColors.zoneGood.green(), themeColors.zoneGood.blue(), 190), 4); 
+            glowPen(warn, danger, QColor(themeColors.zoneWarn.red(), themeColors.zoneWarn.green(), themeColors.zoneWarn.blue(), 190), 4); 
+            glowPen(danger, 100, QColor(themeColors.zoneDanger.red(), themeColors.zoneDanger.green(), themeColors.zoneDanger.blue(), 190), 4);
+            break;
+        }
+        case SpeedometerStyle::Minimal: {
+            painter.setPen(QPen(themeColors.arcBase, 2, Qt::DashLine)); painter.drawArc(rect.adjusted(10,10,-10,-10), 45*16, 270*16);
+            break;
+        }
+        case SpeedometerStyle::ModernTicks: {
+            // Background accent
+            painter.fillRect(rect.adjusted(-6,-6,6,6), themeColors.background);
+            // Outer and inner arcs
+            QRect outer = rect.adjusted(6,6,-6,-6);
+            QRect inner = rect.adjusted(18,18,-18,-18);
+            // Base multi-level arcs with subtle gradients
+            QConicalGradient g1(outer.center(), -45);
+            g1.setColorAt(0.00, themeColors.arcBase.lighter(110));
+            g1.setColorAt(0.25, themeColors.arcBase);
+            g1.setColorAt(0.75, themeColors.arcBase.darker(105));
+            g1.setColorAt(1.00, themeColors.arcBase.lighter(110));
+            painter.setPen(QPen(QBrush(g1), 3, Qt::SolidLine, Qt::RoundCap));
+            painter.drawArc(outer, 45*16, 270*16);
+            painter.setPen(QPen(themeColors.arcBase.lighter(140), 2, Qt::SolidLine, Qt::RoundCap));
+            painter.drawArc(inner, 45*16, 270*16);
+
+            // Subtle auxiliary arc for structure
+            QRect aux = rect.adjusted(28,28,-28,-28);
+            painter.setPen(QPen(themeColors.arcBase.darker(115), 1, Qt::DotLine));
+            painter.drawArc(aux, 45*16, 270*16);
+
+            // Segmented scale with variable-length ticks: long (0/25/50/75/100), medium (x10), short (x5)
+            painter.save(); painter.translate(w/2, h/2);
+            for (int v=0; v<=100; v+=5) {
+                painter.save(); double a = 45 + 270.0*v/100.0; painter.rotate(a);
+                int tOuter = size/2 - 8;
+                int len = 6; int thick = 1; QColor tc = themeColors.text;
+                if (v%25==0) { len = 18; thick = 3; tc = themeColors.text; }
+                else if (v%10==0) { len = 12; thick = 2; tc = themeColors.text.lighter(120); }
+                else { len = 7; thick = 1; tc = themeColors.text.lighter(150); }
+                painter.setPen(QPen(tc, thick, Qt::SolidLine, Qt::RoundCap));
+                painter.drawLine(tOuter-len, 0, tOuter, 0);
+                painter.restore();
+            }
+
+            // Numbers placed just outside the main arc with tiny drop shadow
+            for (int v : {0,25,50,75,100}) {
+                painter.save(); double a = 45 + 270.0*v/100.0; painter.rotate(a);
+                QPoint pos(size/2 - 30, 0);
+                painter.rotate(-a);
+                QFont f("Arial", 9, QFont::DemiBold); painter.setFont(f);
+                // shadow
+                painter.setPen(QPen(QColor(0,0,0,120), 1)); painter.drawText(pos + QPoint(1,1), QString::number(v));
+                painter.setPen(themeColors.text); painter.drawText(pos, QString::number(v));
+                painter.restore();
+            }
+            painter.restore();
+            break;
+        }
+        case SpeedometerStyle::Circle: {
+            // Main arc with subtle gradient
+            painter.setPen(QPen(themeColors.arcBase, std::clamp(int(size/80), 3, 6))); 
+            painter.drawArc(rect.adjusted(8,8,-8,-8), 45*16, 270*16);
+            
+            // Draw major tick marks (every 20 units)
+            painter.setPen(QPen(themeColors.text, 2));
+            for (int v=0; v<=100; v+=20) {
+                painter.save(); painter.translate(w/2, h/2); 
+                double a = 45 + 270.0*v/100.0; painter.rotate(a);
+                int outer = size/2 - 8, inner = size/2 - 18;
+                painter.drawLine(outer, 0, inner, 0); painter.restore();
+            }
+            
+            // Draw minor tick marks (every 10 units)
+            painter.setPen(QPen(themeColors.text.lighter(), 1));
+            for (int v=10; v<=90; v+=20) {
+                // first minor tick
+                painter.save(); painter.translate(w/2, h/2);
+                double a1 = 45 + 270.0*v/100.0; painter.rotate(a1);
+                { int outer = size/2 - 8, inner = size/2 - 13; painter.drawLine(outer, 0, inner, 0); }
+                painter.restore();
+                // second minor tick (v+10)
+                painter.save(); painter.translate(w/2, h/2);
+                double a2 = 45 + 270.0*(v+10)/100.0; painter.rotate(a2);
+                { int outer = size/2 - 8, inner = size/2 - 13; painter.drawLine(outer, 0, inner, 0); }
+                painter.restore();
+            }
+            
+            // Good zone (green)
+            painter.setPen(QPen(themeColors.zoneGood, 8, Qt::SolidLine, Qt::RoundCap));
+            double goodSpan = warn * 270.0 / 100.0;
+            painter.drawArc(rect, 45*16, int(goodSpan*16));
+            
+            // Warning zone (yellow/orange)
+            painter.setPen(QPen(themeColors.zoneWarn, 8, Qt::SolidLine, Qt::RoundCap));
+            double warnStart = 45 + goodSpan;
+            double warnSpan = (danger - warn) * 270.0 / 100.0;
+            painter.drawArc(rect, int(warnStart*16), int(warnSpan*16));
+            
+            // Danger zone (red)
+            painter.setPen(QPen(themeColors.zoneDanger, 8, Qt::SolidLine, Qt::RoundCap));
+            double dangerStart = warnStart + warnSpan;
+            double dangerSpan = (100 - danger) * 270.0 / 100.0;
+            painter.drawArc(rect, int(dangerStart*16), int(dangerSpan*16));
+            break;
+        }
+        case SpeedometerStyle::Gauge: {
+            QColor base = themeColors.arcBase;
+            painter.setPen(QPen(base, 2));
+            QRect r2 = rect.adjusted(10,10,-10,-10);
+            painter.drawArc(r2, 45*16, 270*16);
+
+            auto faint = [](QColor c){ c.setAlpha(140); return c; };
+            // Subtle zones
+            painter.setPen(QPen(faint(themeColors.zoneGood), 3)); painter.drawArc(r2, 45*16, int((warn*270.0/100.0)*16));
+            painter.setPen(QPen(faint(themeColors.zoneWarn), 3)); painter.drawArc(r2, int((45 + warn*270.0/100.0)*16), int(((danger-warn)*270.0/100.0)*16));
+            painter.setPen(QPen(faint(themeColors.zoneDanger), 3)); painter.drawArc(r2, int((45 + danger*270.0/100.0)*16), int(((100-danger)*270.0/100.0)*16));
+
+            // Sparse ticks
+            painter.setPen(QPen(themeColors.text.lighter(), 1));
+            for (int v=0; v<=100; v+=25) {
+                painter.save(); painter.translate(w/2, h/2); double a = 45 + 270.0*v/100.0; painter.rotate(a);
+                int t = size/2 - 8; painter.drawLine(t-3,0,t,0); painter.restore();
+            }
+            break;
+        }
+        case SpeedometerStyle::Ring: {
+            // Background arc - thin and subtle
+            painter.setPen(QPen(themeColors.arcBase.lighter(), 2)); 
+            painter.drawArc(rect.adjusted(15,15,-15,-15), 45*16, 270*16);
+            
+            // Modern scale marks - clean lines radiating outward
+            painter.setPen(QPen(themeColors.text, 2));
+            for (int v=0; v<=100; v+=10) {
+                painter.save(); painter.translate(w/2, h/2); 
+                double a = 45 + 270.0*v/100.0; painter.rotate(a);
+                
+                // Different lengths for major/minor marks
+                int outer = size/2 - 15;
+                int inner = (v % 20 == 0) ? size/2 - 30 : size/2 - 22; // Major vs minor
+                int thickness = (v % 20 == 0) ? 3 : 1;
+                
+                painter.setPen(QPen(themeColors.text, thickness));
+                painter.drawLine(outer, 0, inner, 0);
+                
+                // Scale numbers for major marks
+                if (v % 20 == 0) {
+                    painter.save();
+                    painter.translate(inner - 15, 0);
+                    painter.rotate(-a); // Counter-rotate text
+                    painter.setFont(QFont("Arial", 8, QFont::Bold));
+                    painter.drawText(-10, -5, 20, 10, Qt::AlignCenter, QString::number(v));
+                    painter.restore();
+                }
+                painter.restore();
+            }
+            break;
+        }
+    }
 
     // Draw widget frame (perimeter border) in minimalistic styles
     if (frameStyle != FrameStyle::None) {
         painter.save();
-        QRect fr = this->rect().adjusted(1,1,-1,-1);
+        QRect fr = QRect(0,0,w,h).adjusted(1,1,-1,-1);
         switch (frameStyle) {
             case FrameStyle::Minimal: {
                 QColor c = themeColors.arcBase.lighter(130); c.setAlpha(180);
@@ -1735,270 +1960,30 @@ void DynamicSpeedometerCharts::drawSpeedometer(QPainter& painter) {
 }
 
 void DynamicSpeedometerCharts::updateChartSeries() {
+    if (modeView=="speedometer") return; // plot buffers are only held while a chart view is shown
     const bool useBtc = (modeView=="btc_ratio");
     auto& values = useBtc ? cachedProcessedBtcRatio : cachedProcessedHistory;
-    seriesNormal->setVisible(!useBtc); seriesRatio->setVisible(useBtc);
-    QLineSeries* s = useBtc? seriesRatio : seriesNormal;
-    QVector<QPointF> pts; pts.reserve(int(values.size()));
-    for (int i=0;i<int(values.size());++i) pts.append(QPointF(i, values[size_t(i)]));
-    s->replace(pts);
+    if (useBtc) ratioIndicators.sync(cachedProcessedBtcRatioTs, cachedProcessedBtcRatio); // no-op when already current
+    const IndicatorEngine& ind = useBtc ? ratioIndicators : priceIndicators;
+    // LinePlot copies only what differs from the last call (dropped front, restated last sample, new tail); axes, grid
+    // and pens are derived at paint time instead of being re-set on QtCharts objects every update
+    plot.setTrace(LinePlot::Price, values);
+    plot.setTitle(useBtc ? QString("%1/BTC | %2").arg(currency, currentScale) : QString("%1 | %2").arg(currency, currentScale));
+    // Price / ratio line colours = the first two QtCharts default series colours used before
+    plot.setStyle({themeColors.background, themeColors.arcBase, themeColors.text, useBtc ? QColor(153,202,83) : QColor(32,159,223), showGrid, showAxisLabels});
     if (!values.empty()) {
-        auto minmax = std::minmax_element(values.begin(), values.end());
-        double minY = *minmax.first, maxY = *minmax.second; if (qFuzzyCompare(minY, maxY)) maxY += useBtc ? 1e-8 : 1e-4;
-        axisX->setRange(0, std::max<int>(1, int(values.size()-1)));
-        axisY->setRange(minY, maxY);
-        chart->setTitle(useBtc ? QString("%1/BTC | %2").arg(currency, currentScale) : QString("%1 | %2").arg(currency, currentScale));
-        // Apply chart options
-        axisX->setGridLineVisible(showGrid);
-        axisY->setGridLineVisible(showGrid);
-        axisX->setVisible(showAxisLabels);
-        axisY->setVisible(showAxisLabels);
-        axisRSI->setGridLineVisible(showGrid);
-        axisMACD->setGridLineVisible(showGrid);
-        // Keep background aligned to theme
-        chart->setBackgroundBrush(themeColors.background);
-        QPen gridPen(themeColors.arcBase);
-        gridPen.setStyle(Qt::DotLine);
-        gridPen.setWidth(1);
-        axisX->setGridLinePen(gridPen);
-        axisY->setGridLinePen(gridPen);
-        axisRSI->setGridLinePen(gridPen);
-        axisMACD->setGridLinePen(gridPen);
-        // Lines appearance
-        s->setPointsVisible(false);
-        s->setUseOpenGL(false);
-    // Indicators update: hide axes by default
-        axisRSI->setVisible(false);
-        axisMACD->setVisible(false);
-    // Default no anomaly until evaluated
-    anomalyActive = false; anomalyLabel.clear();
-
-        // RSI
-        if (showRSI) {
-            auto rsi = computeRSI(values, 14);
-            QVector<QPointF> rpts; rpts.reserve(int(rsi.size()));
-            for (int i=0;i<int(rsi.size());++i) rpts.append(QPointF(i, rsi[size_t(i)]));
-            rsiSeries->replace(rpts);
-            rsiSeries->setVisible(true);
-            axisRSI->setRange(0, 100);
-            axisRSI->setVisible(showAxisLabels);
-        } else {
-            rsiSeries->setVisible(false);
-        }
-
-        // MACD
-        if (showMACD) {
-            auto macd = computeMACD(values);
-            QVector<QPointF> mp, sp; mp.reserve(int(macd.macd.size())); sp.reserve(int(macd.signal.size()));
-            for (int i=0;i<int(macd.macd.size());++i) mp.append(QPointF(i, macd.macd[size_t(i)]));
-            for (int i=0;i<int(macd.signal.size());++i) sp.append(QPointF(i, macd.signal[size_t(i)]));
-            macdSeries->replace(mp); macdSignalSeries->replace(sp);
-            macdSeries->setVisible(true); macdSignalSeries->setVisible(true);
-            double mn = 0.0, mx = 0.0;
-            if (!macd.macd.empty()) { auto mm = std::minmax_element(macd.macd.begin(), macd.macd.end()); mn = *mm.first; mx = *mm.second; }
-            if (!macd.signal.empty()) { auto mm2 = std::minmax_element(macd.signal.begin(), macd.signal.end()); mn = std::min(mn, *mm2.first); mx = std::max(mx, *mm2.second); }
-            if (qFuzzyCompare(mn, mx)) { mx += 1e-6; }
-            axisMACD->setRange(mn, mx);
-            axisMACD->setVisible(showAxisLabels);
-        } else {
-            macdSeries->setVisible(false); macdSignalSeries->setVisible(false);
-        }
-
-        // Bollinger Bands
-        if (showBB) {
-            auto bb = computeBollinger(values, 20, 2.0);
-            QVector<QPointF> up, lo; up.reserve(int(bb.upper.size())); lo.reserve(int(bb.lower.size()));
-            for (int i=0;i<int(bb.upper.size());++i) { up.append(QPointF(i, bb.upper[size_t(i)])); lo.append(QPointF(i, bb.lower[size_t(i)])); }
-            bbUpperSeries->replace(up); bbLowerSeries->replace(lo);
-            bbUpperSeries->setVisible(true); bbLowerSeries->setVisible(true);
-        } else {
-            bbUpperSeries->setVisible(false); bbLowerSeries->setVisible(false);
-        }
+        // Default no anomaly until evaluated
+        anomalyActive = false; anomalyLabel.clear();
+        if (showRSI && ind.hasRSI()) plot.setTrace(LinePlot::Rsi, ind.rsi()); else plot.hide(LinePlot::Rsi);
+        if (showMACD && ind.hasMACD()) { plot.setTrace(LinePlot::Macd, ind.macd()); plot.setTrace(LinePlot::Signal, ind.signal()); }
+        else { plot.hide(LinePlot::Macd); plot.hide(LinePlot::Signal); }
+        if (showBB && ind.hasBollinger()) { plot.setTrace(LinePlot::BbUpper, ind.bbUpper()); plot.setTrace(LinePlot::BbLower, ind.bbLower()); }
+        else { plot.hide(LinePlot::BbUpper); plot.hide(LinePlot::BbLower); }
 
         // Evaluate anomalies after indicators prepared
-        if (showAnomalyBadge && !values.empty()) {
-            switch (anomalyMode) {
-                case AnomalyMode::RSIOverboughtOversold: {
-                    auto rsi = computeRSI(values, 14);
-                    if (!rsi.empty()) { double last=rsi.back(); if (last>=70.0) { anomalyActive=true; anomalyLabel="RSI↑"; } else if (last<=30.0) { anomalyActive=true; anomalyLabel="RSI↓"; } }
-                    break; }
-                case AnomalyMode::MACDCross: {
-                    auto m = computeMACD(values);
-                    if (m.macd.size()>1 && m.signal.size()>1) {
-                        double pd = m.macd[m.macd.size()-2]-m.signal[m.signal.size()-2];
-                        double ld = m.macd.back()-m.signal.back();
-                        if (pd<=0 && ld>0) { anomalyActive=true; anomalyLabel="MACD↑"; }
-                        else if (pd>=0 && ld<0) { anomalyActive=true; anomalyLabel="MACD↓"; }
-                    }
-                    break; }
-                case AnomalyMode::BollingerBreakout: {
-                    auto bb = computeBollinger(values, 20, 2.0);
-                    if (!bb.upper.empty()) { double last=values.back(); if (last>bb.upper.back()) { anomalyActive=true; anomalyLabel="BB↑"; } else if (last<bb.lower.back()) { anomalyActive=true; anomalyLabel="BB↓"; } }
-                    break; }
-                case AnomalyMode::ZScore: {
-                    double zs = computeZScore(values, std::min<int>(50,(int)values.size())); if (std::abs(zs)>=2.0) { anomalyActive=true; anomalyLabel = (zs>0? "Z↑" : "Z↓"); }
-                    break; }
-                case AnomalyMode::VolSpike: {
-                    int N = std::min<int>(50, (int)values.size()-1);
-                    if (N>10) {
-                        std::vector<double> rets; rets.reserve(N);
-                        for (int i=(int)values.size()-N; i<(int)values.size(); ++i) { if (i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev) : 0.0); }
-                        if (rets.size()>5) { std::vector<double> tmp = rets; std::nth_element(tmp.begin(), tmp.begin()+tmp.size()/2, tmp.end()); double med = tmp[tmp.size()/2]; double last = rets.back(); if (last>med*2.5) { anomalyActive=true; anomalyLabel="VOL"; } }
-                    }
-                    break; }
-                case AnomalyMode::Composite: {
-                    QString lab; int votes = 0;
-                    auto rsi=computeRSI(values,14);
-                    bool rsiExtreme = (!rsi.empty() && (rsi.back()>=75.0 || rsi.back()<=25.0));
-                    if (rsiExtreme) { ++votes; lab = lab.isEmpty()? "RSI" : lab+"+RSI"; }
-                    auto m=computeMACD(values);
-                    bool macdCross=false; if (m.macd.size()>1 && m.signal.size()>1) {
-                        double pd=m.macd[m.macd.size()-2]-m.signal[m.signal.size()-2];
-                        double ld=m.macd.back()-m.signal.back();
-                        macdCross = ((pd<=0&&ld>0)||(pd>=0&&ld<0));
-                    }
-                    if (macdCross) { ++votes; lab = lab.isEmpty()? "MACD" : lab+"+MACD"; }
-                    auto bb=computeBollinger(values,20,2.0);
-                    bool bbBreak=false; if (!bb.upper.empty()) { double last=values.back(); bbBreak = (last>bb.upper.back()||last<bb.lower.back()); }
-                    if (bbBreak) { ++votes; lab = lab.isEmpty()? "BB" : lab+"+BB"; }
-                    double zAbs = std::abs(computeZScore(values, std::min<int>(50,(int)values.size())));
-                    bool volGate=false; {
-                        int N = std::min<int>(40, (int)values.size()-1);
-                        if (N>10) {
-                            std::vector<double> rets; rets.reserve(N);
-                            for (int i=(int)values.size()-N; i<(int)values.size(); ++i) { if (i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev) : 0.0); }
-                            std::vector<double> tmp = rets; std::nth_element(tmp.begin(), tmp.begin()+tmp.size()/2, tmp.end()); double med = tmp[tmp.size()/2];
-                            double last = rets.back(); volGate = (med>1e-9 && last/med >= 1.8);
-                        }
-                    }
-                    bool trigger = (votes>=2) || (votes>=1 && zAbs>=2.0) || (votes>=1 && volGate && zAbs>=1.5);
-                    if (trigger) { anomalyActive=true; anomalyLabel=lab; }
-                    break; }
-                case AnomalyMode::RSIDivergence: {
-                    auto rsi = computeRSI(values, 14);
-                    // Простая дивергенция: последние 2 локальных экстремума цены и RSI противоположно направлены
-                    auto findPeaks = [](const std::vector<double>& v, bool maxPeaks){ std::vector<int> idx; for (int i=1;i+1<(int)v.size();++i){ if (maxPeaks){ if (v[i]>v[i-1] && v[i]>v[i+1]) idx.push_back(i);} else { if (v[i]<v[i-1] && v[i]<v[i+1]) idx.push_back(i);} } return idx; };
-                    if (values.size()>=10 && rsi.size()==values.size()) {
-                        auto maxP = findPeaks(values, true); auto maxR = findPeaks(rsi, true);
-                        if (maxP.size()>=2 && maxR.size()>=2) {
-                            int p2 = maxP.back(), p1 = maxP[maxP.size()-2];
-                            int r2 = maxR.back(), r1 = maxR[maxR.size()-2];
-                            if (p1< p2 && r1< r2) {
-                                // Медвежья дивергенция: цена делает выше максимум, RSI нет
-                                if (values[p2] > values[p1] && rsi[r2] < rsi[r1]) { anomalyActive=true; anomalyLabel = "DIV-"; }
-                            }
-                        }
-                        auto minP = findPeaks(values, false); auto minR = findPeaks(rsi, false);
-                        if (minP.size()>=2 && minR.size()>=2) {
-                            int p2 = minP.back(), p1 = minP[minP.size()-2];
-                            int r2 = minR.back(), r1 = minR[minR.size()-2];
-                            if (p1< p2 && r1< r2) {
-                                // Бычья дивергенция: цена ниже минимум, RSI нет
-                                if (values[p2] < values[p1] && rsi[r2] > rsi[r1]) { anomalyActive=true; anomalyLabel = "DIV+"; }
-                            }
-                        }
-                    }
-                    break; }
-                case AnomalyMode::MACDHistSurge: {
-                    auto m = computeMACD(values);
-                    if (m.macd.size()>5 && m.signal.size()>5) {
-                        // гистограмма = MACD - signal; surge: |последняя| > медианы×k
-                        std::vector<double> hist(m.macd.size()); for (size_t i=0;i<hist.size();++i) hist[i]=m.macd[i]-m.signal[i];
-                        int N = std::min<int>(50, (int)hist.size()); if (N>10) {
-                            std::vector<double> window(hist.end()-N, hist.end()); for (auto& x:window) x=std::abs(x);
-                            std::nth_element(window.begin(), window.begin()+window.size()/2, window.end()); double med = window[window.size()/2];
-                            double last = std::abs(hist.back()); if (last > med*2.5) { anomalyActive=true; anomalyLabel="HIST"; }
-                        }
-                    }
-                    break; }
-                case AnomalyMode::ClusteredZ: {
-                    // Комбинированный Z-Score: средний Z трех нормированных метрик: цена, RSI, MACD
-                    auto rsi = computeRSI(values, 14);
-                    auto m = computeMACD(values);
-                    auto zVal = [&](const std::vector<double>& v){ return computeZScore(v, std::min<int>(50,(int)v.size())); };
-                    double z1 = computeZScore(values, std::min<int>(50,(int)values.size()));
-                    double z2 = rsi.empty()? 0.0 : zVal(rsi);
-                    double z3 = 0.0; if (!m.macd.empty()) { z3 = zVal(m.macd); }
-                    double z = (z1 + z2 + z3) / 3.0; if (std::abs(z) >= 2.2) { anomalyActive=true; anomalyLabel = (z>0? "CZ↑" : "CZ↓"); }
-                    break; }
-                case AnomalyMode::VolRegimeShift: {
-                    // Изменение режима волатильности: скользящее среднее |ретёрнов| пересекло порог (или ratio short/long)
-                    int N = std::min<int>(120, (int)values.size()-1);
-                    if (N>30) {
-                        std::vector<double> rets; rets.reserve(N); for (int i=(int)values.size()-N;i<(int)values.size();++i){ if(i==0) continue; double prev=values[size_t(i-1)], cur=values[size_t(i)]; rets.push_back(prev? std::abs((cur-prev)/prev):0.0); }
-                        int half = (int)rets.size()/2; if (half>5) {
-                            auto avg = [](const std::vector<double>& a){ double s=0; for(double x:a) s+=x; return s/(double)a.size(); };
-                            double avgOld = avg(std::vector<double>(rets.begin(), rets.begin()+half));
-                            double avgNew = avg(std::vector<double>(rets.begin()+half, rets.end()));
-                            if (avgOld>1e-12 && (avgNew/avgOld >= 1.8)) { anomalyActive=true; anomalyLabel = "VOL↑"; }
-                            else if (avgNew<1e-12 && avgOld>1e-12) { anomalyActive=true; anomalyLabel = "VOL↓"; }
-                        }
-                    }
-                    break; }
-                default: break;
-            }
-        }
-    }
-}
-
-// ===== Indicator implementations =====
-static inline double emaStep(double prev, double val, double alpha) { return prev + alpha*(val - prev); }
-
-std::vector<double> DynamicSpeedometerCharts::computeRSI(const std::vector<double>& v, int period) {
-    if (period <= 0 || (int)v.size() < period+1) return {};
-    std::vector<double> rsi(v.size(), 50.0);
-    double gain=0.0, loss=0.0;
-    // Seed with first period
-    for (int i=1; i<=period; ++i) {
-        double diff = v[size_t(i)] - v[size_t(i-1)];
-        if (diff >= 0) gain += diff; else loss -= diff;
-    }
-    gain /= period; loss /= period;
-    for (size_t i=period+1; i<v.size(); ++i) {
-        double diff = v[i] - v[i-1];
-        double g = diff > 0 ? diff : 0.0;
-        double l = diff < 0 ? -diff : 0.0;
-        gain = (gain*(period-1) + g) / period;
-        loss = (loss*(period-1) + l) / period;
-        double rs = (loss == 0.0) ? 0.0 : (gain / loss);
-        double val = (loss==0.0 && gain==0.0) ? 50.0 : (100.0 - (100.0/(1.0+rs)));
-        rsi[i] = val;
-    }
-    return rsi;
-}
-
-DynamicSpeedometerCharts::MACDOut DynamicSpeedometerCharts::computeMACD(const std::vector<double>& v, int fast, int slow, int signal) {
-    MACDOut out; if (fast<=0 || slow<=0 || signal<=0 || (int)v.size() < slow+signal+2) return out;
-    std::vector<double> emaFast(v.size()), emaSlow(v.size());
-    double aF = 2.0/(fast+1), aS = 2.0/(slow+1);
-    emaFast[0] = v[0]; emaSlow[0] = v[0];
-    for (size_t i=1;i<v.size();++i) { emaFast[i] = emaStep(emaFast[i-1], v[i], aF); emaSlow[i] = emaStep(emaSlow[i-1], v[i], aS); }
-    out.macd.resize(v.size()); for (size_t i=0;i<v.size();++i) out.macd[i] = emaFast[i] - emaSlow[i];
-    out.signal.resize(v.size()); double aSig = 2.0/(signal+1); out.signal[0] = out.macd[0];
-    for (size_t i=1;i<out.macd.size();++i) out.signal[i] = emaStep(out.signal[i-1], out.macd[i], aSig);
-    return out;
-}
-
-DynamicSpeedometerCharts::BBOut DynamicSpeedometerCharts::computeBollinger(const std::vector<double>& v, int period, double k) {
-    BBOut out; if (period<=0 || (int)v.size() < period) return out; size_t n = v.size();
-    out.upper.resize(n); out.lower.resize(n);
-    std::vector<double> sum(n,0.0), sumsq(n,0.0);
-    for (size_t i=0;i<n;++i) {
-        sum[i] = v[i] + (i? sum[i-1] : 0.0);
-        sumsq[i] = v[i]*v[i] + (i? sumsq[i-1] : 0.0);
-        if (i+1 >= size_t(period)) {
-            size_t j = i+1 - period;
-            double s = sum[i] - (j? sum[j-1] : 0.0);
-            double s2 = sumsq[i] - (j? sumsq[j-1] : 0.0);
-            double m = s / period;
-            double var = std::max(0.0, (s2/period - m*m));
-            double sd = std::sqrt(var);
-            out.upper[i] = m + k*sd; out.lower[i] = m - k*sd;
-        } else {
-            out.upper[i] = v[i]; out.lower[i] = v[i];
-        }
+        if (showAnomalyBadge) evaluateAnomaly(values, ind);
     }
-    return out;
+    update();
 }
 
 // ===== Extra helpers =====
@@ -0,0 +1,67 @@
+#include "FrameCapture.h"
+#include "Profiler.h"
+#include <QDateTime>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+static const char kMagic[8] = { 'M','D','C','A','P','0','0','1' };
+static constexpr int kRecordHeader = 8 + 8 + 1 + 1 + 4;
+static constexpr int kFlushBytes = 64 * 1024;
+
+FrameRecorder::FrameRecorder(const QString& path) : file(path) {
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) { qDebug() << "[FrameRecorder] cannot open" << path << file.errorString(); return; }
+    if (file.size() == 0) file.write(kMagic, sizeof(kMagic));
+    buf.reserve(kFlushBytes + 4096);
+    qDebug() << "[FrameRecorder] recording to" << path;
+}
+
+FrameRecorder::~FrameRecorder() {
+    flush();
+    if (file.isOpen()) qDebug() << "[FrameRecorder] closed" << file.fileName() << "," << frames << "frames";
+}
+
+void FrameRecorder::append(DataProvider provider, StreamMode mode, const QString& text) {
+    const qint64 recvMs = QDateTime::currentMSecsSinceEpoch(), recvNs = Profiler::nowNs();
+    const QByteArray payload = text.toUtf8();
+    QMutexLocker lock(&mutex); writeLocked(recvMs, recvNs, provider, mode, payload);
+}
+
+void FrameRecorder::append(const CapturedFrame& f) {
+    QMutexLocker lock(&mutex); writeLocked(f.recvMs, f.recvNs, f.provider, f.mode, f.payload);
+}
+
+void FrameRecorder::writeLocked(qint64 recvMs, qint64 recvNs, DataProvider provider, StreamMode mode, const QByteArray& payload) {
+    if (!file.isOpen()) return;
+    char h[kRecordHeader];
+    qToLittleEndian<qint64>(recvMs, h); qToLittleEndian<qint64>(recvNs, h + 8);
+    h[16] = char(provider==DataProvider::Bybit ? 1 : 0); h[17] = char(mode==StreamMode::Ticker ? 1 : 0);
+    qToLittleEndian<quint32>(quint32(payload.size()), h + 18);
+    buf.append(h, kRecordHeader); buf.append(payload); ++frames;
+    if (buf.size() >= kFlushBytes) { file.write(buf); buf.clear(); }
+}
+
+void FrameRecorder::flush() {
+    QMutexLocker lock(&mutex);
+    if (!file.isOpen()) return;
+    if (!buf.isEmpty()) { file.write(buf); buf.clear(); }
+    file.flush();
+}
+
+FrameReader::FrameReader(const QString& path) : file(path) {
+    if (!file.open(QIODevice::ReadOnly)) { error = file.errorString(); return; }
+    char m[sizeof(kMagic)];
+    if (file.read(m, sizeof(m)) != qint64(sizeof(m)) || memcmp(m, kMagic, sizeof(kMagic)) != 0) { error = QStringLiteral("not a frame capture (bad magic)"); file.close(); return; }
+    ok = true;
+}
+
+bool FrameReader::next(CapturedFrame& out) {
+    if (!ok) return false;
+    char h[kRecordHeader];
+    if (file.read(h, kRecordHeader) != kRecordHeader) return false;
+    out.recvMs = qFromLittleEndian<qint64>(h); out.recvNs = qFromLittleEndian<qint64>(h + 8);
+    out.provider = h[16] ? DataProvider::Bybit : DataProvider::Binance; out.mode = h[17] ? StreamMode::Ticker : StreamMode::Trade;
+    const quint32 len = qFromLittleEndian<quint32>(h + 18);
+    out.payload.resize(qsizetype(len));
+    return file.read(out.payload.data(), qint64(len)) == qint64(len);
+}
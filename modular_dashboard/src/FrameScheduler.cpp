@@ -0,0 +1,73 @@
+#include "FrameScheduler.h"
+#include "DynamicSpeedometerCharts.h"
+#include "Profiler.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSemaphore>
+#include <algorithm>
+#include <atomic>
+
+FrameScheduler& FrameScheduler::instance() { static FrameScheduler s; return s; }
+
+FrameScheduler::FrameScheduler() {
+    frameNs = Profiler::nowNs(); timer.setTimerType(Qt::PreciseTimer); timer.setInterval(16);
+    connect(&timer, &QTimer::timeout, this, &FrameScheduler::onFrame); timer.start();
+    if (auto* app = QCoreApplication::instance()) connect(app, &QCoreApplication::aboutToQuit, &timer, &QTimer::stop); // outlives the app
+}
+
+void FrameScheduler::add(DynamicSpeedometerCharts* w) {
+    if (!w || std::any_of(entries.begin(), entries.end(), [w](const Entry& e){ return e.w == w; })) return;
+    entries.push_back({w, 0});
+}
+
+void FrameScheduler::remove(DynamicSpeedometerCharts* w) {
+    auto it = std::find_if(entries.begin(), entries.end(), [w](const Entry& e){ return e.w == w; });
+    if (it == entries.end()) return;
+    const size_t i = size_t(it - entries.begin()); entries.erase(it);
+    if (cursor > i) --cursor;
+    if (cursor >= entries.size()) cursor = 0;
+}
+
+void FrameScheduler::configure(int frameMs, int cacheMs, int rasterThreads) {
+    frameMs = std::max(1, frameMs); timer.setInterval(frameMs);
+    cacheNs = qint64(std::max(10, cacheMs)) * 1000000LL;
+    budgetNs = qint64(frameMs) * 1000000LL / 4;
+    rasterN = std::clamp(rasterThreads, 0, 64);
+    if (rasterN > 0) pool.setMaxThreadCount(rasterN);
+    qDebug() << "[FrameScheduler] frame" << frameMs << "ms, cache" << cacheMs << "ms, raster threads" << rasterN;
+}
+
+void FrameScheduler::onFrame() {
+    Profiler::Scope prof("FrameScheduler::frame");
+    frameNs = Profiler::nowNs();
+    emit frameStarted();
+    const qint64 start = Profiler::nowNs(); int refreshed = 0;
+    const size_t n = entries.size();
+    for (size_t k=0; k<n; ++k) {
+        const qint64 now = Profiler::nowNs();
+        if (refreshed > 0 && now - start >= budgetNs) break;
+        const size_t i = (cursor + k) % n; Entry& e = entries[i];
+        if (now - e.cachedAtNs < cacheNs || e.w->transitionActive) continue;
+        e.w->cacheChartData(); e.cachedAtNs = now; ++refreshed;
+        cursor = (i + 1) % n;
+    }
+    if (rasterN > 0) presentOffscreen();
+    else for (const Entry& e : entries) e.w->presentFrame();
+    Profiler::sample("FrameScheduler::cacheRefreshes", refreshed);
+}
+
+void FrameScheduler::presentOffscreen() {
+    jobs.clear();
+    for (const Entry& e : entries) { if (e.w->prepareOffscreen()) jobs.push_back(e.w); else e.w->presentFrame(); }
+    if (jobs.empty()) return;
+    Profiler::Scope prof("FrameScheduler::raster");
+    // Tiles are claimed one at a time, so a slow style does not hold up a fixed share; the GUI thread works too and then
+    // waits for the helpers, so no widget state changes while they read it and no image is blitted half drawn
+    std::atomic<size_t> next{0}; QSemaphore done;
+    auto work = [this, &next]{ for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < jobs.size(); ) jobs[i]->renderOffscreen(); };
+    const int helpers = std::min(rasterN, int(jobs.size()) - 1);
+    for (int k=0; k<helpers; ++k) pool.start([&work, &done]{ work(); done.release(); });
+    work(); done.acquire(helpers);
+    for (DynamicSpeedometerCharts* w : jobs) w->finishOffscreen();
+    Profiler::sample("FrameScheduler::rasterTiles", double(jobs.size()));
+}
@@ -0,0 +1,96 @@
+#include "HistoryRing.h"
+#include <QHash>
+#include <QVector>
+#include <algorithm>
+
+namespace {
+struct LabelTable { QHash<QString, quint8> ids; QVector<QString> names{QString()}; };
+LabelTable& labels() { static LabelTable t; return t; }
+}
+
+quint8 HistoryRing::intern(const QString& label) {
+    if (label.isEmpty()) return 0;
+    LabelTable& t = labels();
+    auto it = t.ids.constFind(label); if (it != t.ids.constEnd()) return it.value();
+    if (t.names.size() >= 256) return 0;
+    const quint8 id = quint8(t.names.size()); t.names << label; t.ids.insert(label, id);
+    return id;
+}
+
+QString HistoryRing::label(quint8 id) { const LabelTable& t = labels(); return id < t.names.size() ? t.names[id] : QString(); }
+
+void HistoryRing::linearize() {
+    if (head == 0) return;
+    std::rotate(tsv.begin(), tsv.begin() + qptrdiff(head), tsv.end());
+    std::rotate(val.begin(), val.begin() + qptrdiff(head), val.end());
+    std::rotate(seqv.begin(), seqv.begin() + qptrdiff(head), seqv.end());
+    head = 0;
+}
+
+void HistoryRing::push(double ts, double value, quint64 seq, const Tag& tag) {
+    if (runs.empty() || runs.back().tag != tag) runs.push_back(Run{next, tag});
+    if (count == tsv.size() && tsv.size() < cap) {
+        // Grow: storage is full but below capacity; append at the physical end (rotating once if wrapped)
+        if (head != 0) linearize();
+        if (tsv.size() == tsv.capacity()) { // double as push_back would, but never past the cap (a full ring is exactly cap points)
+            const size_t n = std::min(cap, std::max<size_t>(16, 2 * tsv.size())); tsv.reserve(n); val.reserve(n); seqv.reserve(n);
+        }
+        tsv.push_back(ts); val.push_back(value); seqv.push_back(seq); ++count;
+    } else if (count < tsv.size()) {
+        const size_t p = phys(count); tsv[p] = ts; val[p] = value; seqv[p] = seq; ++count;
+    } else {
+        tsv[head] = ts; val[head] = value; seqv[head] = seq; // full: overwrite the oldest
+        head = (head + 1 == tsv.size()) ? 0 : head + 1; ++first;
+    }
+    ++next;
+    while (runs.size() > 1 && runs[1].start <= first) runs.pop_front();
+}
+
+size_t HistoryRing::lowerBound(double t) const {
+    if (count == 0) return 0;
+    // [head, head + n1) is the older contiguous segment, [0, count - n1) the wrapped newer one
+    const size_t n1 = std::min(count, tsv.size() - head);
+    const auto seg1 = tsv.begin() + qptrdiff(head);
+    if (n1 == count || t <= seg1[qptrdiff(n1 - 1)]) return size_t(std::lower_bound(seg1, seg1 + qptrdiff(n1), t) - seg1);
+    return n1 + size_t(std::lower_bound(tsv.begin(), tsv.begin() + qptrdiff(count - n1), t) - tsv.begin());
+}
+
+void HistoryRing::popFront(size_t n) {
+    n = std::min(n, count); if (n == 0) return;
+    head = tsv.empty() ? 0 : (head + n) % tsv.size(); count -= n; first += n;
+    if (count == 0) { clear(); return; }
+    while (runs.size() > 1 && runs[1].start <= first) runs.pop_front();
+}
+
+HistoryRing::Tag HistoryRing::tag(size_t i) const {
+    const quint64 abs = first + i;
+    auto it = std::upper_bound(runs.begin(), runs.end(), abs, [](quint64 a, const Run& r){ return a < r.start; });
+    return it == runs.begin() ? Tag{} : std::prev(it)->tag;
+}
+
+void HistoryRing::setCapacity(int capacity) {
+    const size_t c = size_t(std::max(1, capacity));
+    if (c == cap) return;
+    if (count > c) popFront(count - c);
+    linearize();
+    // Physical storage may be larger than the new capacity: compact to the live points
+    if (tsv.size() > c) { tsv.resize(count); val.resize(count); seqv.resize(count); tsv.shrink_to_fit(); val.shrink_to_fit(); seqv.shrink_to_fit(); }
+    cap = c;
+}
+
+void WindowExtremes::sync(const HistoryRing& h, int n) {
+    const quint64 hEnd = h.endIndex();
+    const quint64 from = (n <= 0 || hEnd - h.firstIndex() <= quint64(n)) ? h.firstIndex() : hEnd - quint64(n);
+    if (from < validFrom || end > hEnd) { mins.clear(); maxs.clear(); validFrom = end = from; }
+    if (end < from) end = from;
+    quint64 i = end;
+    h.forEach(size_t(end - h.firstIndex()), [&](double, double v){
+        while (!mins.empty() && mins.back().v >= v) mins.pop_back();
+        while (!maxs.empty() && maxs.back().v <= v) maxs.pop_back();
+        mins.push_back(E{i, v}); maxs.push_back(E{i, v}); ++i;
+    });
+    end = hEnd;
+    while (!mins.empty() && mins.front().i < from) mins.pop_front();
+    while (!maxs.empty() && maxs.front().i < from) maxs.pop_front();
+    validFrom = from;
+}
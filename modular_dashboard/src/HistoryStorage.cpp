@@ -1,4 +1,5 @@
 #include "HistoryStorage.h"
+#include "TimeSeriesStore.h"
 #include <QFile>
 #include <QJsonObject>
 #include <QJsonDocument>
@@ -11,16 +12,18 @@
 
 HistoryStorage::HistoryStorage(QObject* parent) : QObject(parent) {}
 
-QVector<HistoryBundle> HistoryStorage::collect(const QMap<QString, DynamicSpeedometerCharts*>& widgets) {
-    QVector<HistoryBundle> out; out.reserve(widgets.size());
-    for (auto it = widgets.begin(); it != widgets.end(); ++it) {
-        auto* w = it.value(); if (!w) continue;
-        HistoryBundle b; b.symbol = it.key();
-        b.provider = w->property("providerName").toString();
-        b.market = w->property("marketName").toString();
-        b.source = w->property("sourceKind").toString();
-        for (const auto& p : w->historySnapshotEx()) {
-            HistoryRecord r; r.symbol = b.symbol; r.provider=b.provider; r.market=b.market; r.source=p.source; r.seq=p.seq; r.ts=p.ts; r.value=p.value; b.points.push_back(r);
+QVector<HistoryBundle> HistoryStorage::collect() {
+    const TimeSeriesStore& store = TimeSeriesStore::instance();
+    const QVector<SymbolId> ids = store.symbols();
+    QVector<HistoryBundle> out; out.reserve(ids.size());
+    for (SymbolId id : ids) {
+        const auto rd = store.read(id); const HistoryRing& h = rd.history(); if (h.empty()) continue;
+        HistoryBundle b; b.symbol = SymbolRegistry::instance().name(id);
+        const HistoryRing::Tag last = h.tag(h.size() - 1);
+        b.provider = HistoryRing::label(last.provider); b.market = HistoryRing::label(last.market); b.source = HistoryRing::label(last.source);
+        b.points.reserve(int(h.size()));
+        for (size_t i=0; i<h.size(); ++i) {
+            HistoryRecord r; r.symbol = b.symbol; r.provider=b.provider; r.market=b.market; r.source=HistoryRing::label(h.tag(i).source); r.seq=h.seq(i); r.ts=h.ts(i); r.value=h.value(i); b.points.push_back(r);
         }
         out.push_back(b);
     }
@@ -0,0 +1,75 @@
+#include "IndicatorEngine.h"
+#include <algorithm>
+#include <cmath>
+
+void IndicatorEngine::reset() {
+    tsv.clear(); val.clear(); rsiOut.clear(); macdOut.clear(); signalOut.clear(); upperOut.clear(); lowerOut.clear();
+    st = State{}; canRestate = false;
+    bbWin.assign(size_t(kBbPeriod), 0.0);
+}
+
+void IndicatorEngine::dropFront(size_t k) {
+    if (k == 0) return;
+    for (auto* v : { &tsv, &val, &rsiOut, &macdOut, &signalOut, &upperOut, &lowerOut }) v->erase(v->begin(), v->begin() + std::ptrdiff_t(std::min(k, v->size())));
+}
+
+void IndicatorEngine::step(double t, double v) {
+    beforeLast = st; bbReplaced = bbWin[st.bbPos]; canRestate = true;
+    // RSI (Wilder): seed with the mean gain/loss of the first period diffs, then smooth; 50 until seeded
+    double r = 50.0;
+    if (st.fed > 0) {
+        const double diff = v - st.prevV;
+        if (st.fed <= size_t(kRsiPeriod)) {
+            if (diff >= 0) st.gain += diff; else st.loss -= diff;
+            if (st.fed == size_t(kRsiPeriod)) { st.gain /= kRsiPeriod; st.loss /= kRsiPeriod; }
+        } else {
+            const double g = diff > 0 ? diff : 0.0, l = diff < 0 ? -diff : 0.0;
+            st.gain = (st.gain*(kRsiPeriod-1) + g) / kRsiPeriod; st.loss = (st.loss*(kRsiPeriod-1) + l) / kRsiPeriod;
+            const double rs = (st.loss == 0.0) ? 0.0 : (st.gain / st.loss);
+            r = (st.loss==0.0 && st.gain==0.0) ? 50.0 : (100.0 - (100.0/(1.0+rs)));
+        }
+    }
+    // MACD: EMAs seeded with the first sample
+    if (st.fed == 0) { st.emaFast = st.emaSlow = v; }
+    else { st.emaFast += (2.0/(kMacdFast+1)) * (v - st.emaFast); st.emaSlow += (2.0/(kMacdSlow+1)) * (v - st.emaSlow); }
+    const double m = st.emaFast - st.emaSlow;
+    st.emaSignal = (st.fed == 0) ? m : st.emaSignal + (2.0/(kMacdSignal+1)) * (m - st.emaSignal);
+    // Bollinger: rolling sum / sum of squares over the last period samples
+    const double old = bbWin[st.bbPos]; bbWin[st.bbPos] = v; st.bbPos = (st.bbPos + 1) % bbWin.size();
+    st.bbSum += v; st.bbSumSq += v*v; if (st.fed >= size_t(kBbPeriod)) { st.bbSum -= old; st.bbSumSq -= old*old; }
+    double up = v, lo = v;
+    if (st.fed + 1 >= size_t(kBbPeriod)) {
+        const double mean = st.bbSum / kBbPeriod; const double sd = std::sqrt(std::max(0.0, st.bbSumSq/kBbPeriod - mean*mean));
+        up = mean + kBbK*sd; lo = mean - kBbK*sd;
+    }
+    tsv.push_back(t); val.push_back(v); rsiOut.push_back(r); macdOut.push_back(m); signalOut.push_back(st.emaSignal); upperOut.push_back(up); lowerOut.push_back(lo);
+    st.prevV = v; ++st.fed;
+}
+
+bool IndicatorEngine::sync(const std::vector<double>& ts, const std::vector<double>& values) {
+    const size_t n = std::min(ts.size(), values.size());
+    // Find where the new series starts inside the stored one, then check the overlap matches sample by sample
+    size_t k = 0; bool extend = false;
+    if (n > 0 && !val.empty()) {
+        while (k < tsv.size() && (tsv[k] < ts[0] || (tsv[k] == ts[0] && val[k] != values[0]))) ++k;
+        const size_t overlap = tsv.size() - k;
+        extend = k < tsv.size() && overlap <= n;
+        for (size_t j=0; extend && j+1<overlap; ++j) extend = (tsv[k+j] == ts[j] && val[k+j] == values[j]);
+        // Last stored sample: identical, or restated (same timestamp, new value) -> undo its step
+        bool restate = false;
+        if (extend) { const size_t j = overlap - 1; restate = tsv[k+j] == ts[j] && val[k+j] != values[j] && canRestate; extend = restate || (tsv[k+j] == ts[j] && val[k+j] == values[j]); }
+        if (extend) {
+            if (restate) {
+                st = beforeLast; bbWin[st.bbPos] = bbReplaced; canRestate = false;
+                for (auto* v : { &tsv, &val, &rsiOut, &macdOut, &signalOut, &upperOut, &lowerOut }) v->pop_back();
+                step(ts[overlap-1], values[overlap-1]);
+            }
+            dropFront(k);
+            for (size_t j=overlap; j<n; ++j) step(ts[j], values[j]);
+            return false;
+        }
+    }
+    reset();
+    for (size_t j=0; j<n; ++j) step(ts[j], values[j]);
+    return true;
+}
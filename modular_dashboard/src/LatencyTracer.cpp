@@ -0,0 +1,108 @@
+#include "LatencyTracer.h"
+#include "DataWorker.h"
+#include "Profiler.h"
+#include <QDateTime>
+#include <algorithm>
+#include <cmath>
+
+static const double kLogStep = std::log(1.08);
+
+static int bucketOf(double ms) {
+    const double us = ms * 1000.0;
+    if (!(us >= 1.0)) return 0; // also catches NaN / negative (clock skew on the Network stage)
+    return std::min(LatencyHistogram::Buckets - 1, 1 + int(std::log(us) / kLogStep));
+}
+static double upperMs(int b) { return std::exp(b * kLogStep) / 1000.0; }
+
+void LatencyHistogram::add(double ms) {
+    ++counts[size_t(bucketOf(ms))]; ++n;
+    if (ms > maxMs) maxMs = ms;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& o) {
+    for (int i=0; i<Buckets; ++i) counts[size_t(i)] += o.counts[size_t(i)];
+    n += o.n; maxMs = std::max(maxMs, o.maxMs);
+}
+
+double LatencyHistogram::quantile(double q) const {
+    if (n == 0) return 0.0;
+    const quint64 target = std::max<quint64>(1, quint64(std::ceil(q * double(n))));
+    quint64 seen = 0;
+    for (int i=0; i<Buckets; ++i) { seen += counts[size_t(i)]; if (seen >= target) return std::min(upperMs(i), maxMs); }
+    return maxMs;
+}
+
+LatencyTracer& LatencyTracer::instance() { static LatencyTracer t; return t; }
+
+const char* LatencyTracer::stageName(int stage) {
+    static const char* names[StageCount] = { "network", "parse", "dispatch", "paint", "e2e" };
+    return (stage >= 0 && stage < StageCount) ? names[stage] : "?";
+}
+
+void LatencyTracer::setEnabled(bool on) {
+    enabled = on;
+    if (!on) perSymbol.forEachMutable([](SymbolId, PerSymbol& s){ s.pendingNs = 0; });
+}
+
+void LatencyTracer::onTickApplied(const TickRecord& t) {
+    if (!enabled || t.symbol == InvalidSymbol) return;
+    const qint64 nowNs = Profiler::nowNs(); const double exchangeMs = t.timestamp * 1000.0;
+    PerSymbol& s = perSymbol[t.symbol];
+    auto add = [&](Stage st, double ms){ s.h[st].add(ms); total[st].add(ms); };
+    if (t.recvNs > 0) {
+        const double recvWallMs = double(QDateTime::currentMSecsSinceEpoch()) - (nowNs - t.recvNs) / 1e6;
+        if (exchangeMs > 0) add(Network, recvWallMs - exchangeMs);
+        if (t.bufferedNs >= t.recvNs) add(Parse, (t.bufferedNs - t.recvNs) / 1e6);
+    }
+    if (t.bufferedNs > 0) add(Dispatch, (nowNs - t.bufferedNs) / 1e6);
+    if (s.pendingNs == 0) s.pendingNs = nowNs;
+    s.shownExchangeMs = exchangeMs;
+}
+
+void LatencyTracer::onPaint(SymbolId id) {
+    if (!enabled || !perSymbol.contains(id)) return;
+    PerSymbol& s = perSymbol[id];
+    if (s.pendingNs == 0) return; // repaint without a new value (hover, resize, animation frame)
+    const double paintMs = (Profiler::nowNs() - s.pendingNs) / 1e6; s.pendingNs = 0;
+    s.h[Paint].add(paintMs); total[Paint].add(paintMs);
+    if (s.shownExchangeMs > 0) { const double e2e = double(QDateTime::currentMSecsSinceEpoch()) - s.shownExchangeMs; s.h[EndToEnd].add(e2e); total[EndToEnd].add(e2e); }
+}
+
+LatencyTracer::Summary LatencyTracer::summarize(const LatencyHistogram& h) {
+    Summary out; out.count = h.count(); out.p50 = h.quantile(0.50); out.p99 = h.quantile(0.99); out.max = h.max();
+    return out;
+}
+
+LatencyTracer::Summary LatencyTracer::summary(int stage, SymbolId id) const {
+    if (stage < 0 || stage >= StageCount) return {};
+    if (id == InvalidSymbol) return summarize(total[size_t(stage)]);
+    const PerSymbol* s = perSymbol.find(id);
+    return s ? summarize(s->h[size_t(stage)]) : Summary();
+}
+
+QVector<SymbolId> LatencyTracer::symbols() const {
+    QVector<SymbolId> out; perSymbol.forEach([&](SymbolId id, const PerSymbol&){ out << id; });
+    return out;
+}
+
+void LatencyTracer::reset() {
+    perSymbol.clear();
+    for (auto& h : total) h.reset();
+}
+
+void LatencyTracer::sampleToProfiler() {
+    if (!enabled || !Profiler::isEnabled()) return;
+    if (sampleClock.isValid() && sampleClock.elapsed() < 5000) return;
+    sampleClock.start();
+    for (int st=0; st<StageCount; ++st) {
+        const Summary s = summarize(total[size_t(st)]); if (s.count == 0) continue;
+        const QByteArray key = QByteArray("latency/") + stageName(st);
+        Profiler::sample((key + "/p50_ms").constData(), s.p50);
+        Profiler::sample((key + "/p99_ms").constData(), s.p99);
+        Profiler::sample((key + "/max_ms").constData(), s.max);
+    }
+    perSymbol.forEach([](SymbolId id, const PerSymbol& s){
+        if (s.h[EndToEnd].count() == 0) return;
+        Profiler::sample(("latency/e2e/" + SymbolRegistry::instance().name(id).toUtf8() + "/p99_ms").constData(), s.h[EndToEnd].quantile(0.99));
+    });
+}
@@ -0,0 +1,57 @@
+#include "LatencyWindow.h"
+#include "LatencyTracer.h"
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QTimer>
+#include <QSettings>
+#include <algorithm>
+
+LatencyWindow::LatencyWindow(QWidget* parent) : QMainWindow(parent) {
+    setWindowTitle(tr("Задержки тиков")); resize(820, 420);
+    auto* central = new QWidget(this); setCentralWidget(central);
+    auto* v = new QVBoxLayout(central);
+    auto* top = new QHBoxLayout();
+    chkEnabled = new QCheckBox(tr("Трассировка включена"), central); chkEnabled->setChecked(LatencyTracer::instance().isEnabled());
+    auto* btnReset = new QPushButton(tr("Сброс"), central);
+    top->addWidget(chkEnabled); top->addStretch(); top->addWidget(btnReset);
+    v->addLayout(top);
+    v->addWidget(new QLabel(tr("мс, p50 / p99 / max. network и e2e включают расхождение часов биржи и локальных"), central));
+    table = new QTableWidget(0, 1 + LatencyTracer::StageCount, central);
+    QStringList headers{tr("Символ")}; for (int s=0; s<LatencyTracer::StageCount; ++s) headers << QString::fromLatin1(LatencyTracer::stageName(s));
+    table->setHorizontalHeaderLabels(headers); table->verticalHeader()->setVisible(false);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers); table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    v->addWidget(table, 1);
+
+    refreshTimer = new QTimer(this); refreshTimer->setInterval(1000);
+    connect(refreshTimer, &QTimer::timeout, this, &LatencyWindow::refresh);
+    connect(chkEnabled, &QCheckBox::toggled, this, [](bool on){
+        LatencyTracer::instance().setEnabled(on);
+        QSettings st("alel12", "modular_dashboard"); st.setValue("perf/latencyTrace", on); st.sync();
+    });
+    connect(btnReset, &QPushButton::clicked, this, [this](){ LatencyTracer::instance().reset(); refresh(); });
+}
+
+void LatencyWindow::showEvent(QShowEvent* e) { QMainWindow::showEvent(e); refresh(); refreshTimer->start(); }
+void LatencyWindow::hideEvent(QHideEvent* e) { refreshTimer->stop(); QMainWindow::hideEvent(e); }
+
+void LatencyWindow::refresh() {
+    const LatencyTracer& tracer = LatencyTracer::instance();
+    QVector<SymbolId> ids = tracer.symbols();
+    std::sort(ids.begin(), ids.end(), [](SymbolId a, SymbolId b){ return SymbolRegistry::instance().name(a) < SymbolRegistry::instance().name(b); });
+    ids.prepend(InvalidSymbol);
+    table->setRowCount(int(ids.size()));
+    auto cell = [this](int r, int c, const QString& text){ auto* it = table->item(r, c); if (!it) { it = new QTableWidgetItem(); table->setItem(r, c, it); } it->setText(text); };
+    for (int r=0; r<ids.size(); ++r) {
+        const SymbolId id = ids[r];
+        cell(r, 0, id == InvalidSymbol ? QStringLiteral("ALL") : SymbolRegistry::instance().name(id));
+        for (int s=0; s<LatencyTracer::StageCount; ++s) {
+            const auto sum = tracer.summary(s, id);
+            cell(r, 1 + s, sum.count == 0 ? QStringLiteral("—") : QString("%1 / %2 / %3").arg(sum.p50, 0, 'f', 2).arg(sum.p99, 0, 'f', 2).arg(sum.max, 0, 'f', 1));
+        }
+    }
+}
@@ -0,0 +1,112 @@
+#include "LinePlot.h"
+#include <QPainter>
+#include <QFont>
+#include <QTransform>
+#include <algorithm>
+#include <cmath>
+
+void LinePlot::setTrace(Trace t, const std::vector<double>& v) {
+    TraceData& d = traces[t]; d.visible = true;
+    // Where v continues the previous samples: v[head..] matches d.y[drop..] except for at most kTail trailing samples of the
+    // overlap. head = 1 when only the first sample was restated (LTTB's first bucket shows its first point)
+    const size_t old = d.y.size(); size_t drop = old, keep = 0, head = 0;
+    for (size_t h=0; h<std::min<size_t>(2, v.size()) && drop == old; ++h) {
+        for (size_t k=0; k<old; ++k) {
+            if (d.y[k] != v[h]) continue;
+            const size_t n = std::min(old - k, v.size() - h);
+            const auto yk = d.y.begin() + std::ptrdiff_t(k);
+            const size_t same = size_t(std::mismatch(yk, yk + std::ptrdiff_t(n), v.begin() + std::ptrdiff_t(h)).first - yk);
+            if (same + kTail >= n) { drop = k; keep = same; head = h; break; }
+        }
+    }
+    d.y.erase(d.y.begin(), d.y.begin() + std::ptrdiff_t(drop));
+    d.px.remove(0, std::min(d.px.size(), qsizetype(drop)));
+    d.base = (drop == old) ? 0.0 : d.base + double(drop) - double(head);
+    d.y.resize(keep); d.y.insert(d.y.begin(), v.begin(), v.begin() + std::ptrdiff_t(head));
+    d.y.insert(d.y.end(), v.begin() + std::ptrdiff_t(head + keep), v.end());
+    d.px.resize(std::min(d.px.size(), qsizetype(keep)));
+    if (head && !d.px.isEmpty()) { d.px.insert(0, qsizetype(head), QPointF()); d.pxStale = int(head); } // mapped by paint()
+}
+
+void LinePlot::hide(Trace t) { traces[t] = TraceData(); }
+
+void LinePlot::clear() { for (TraceData& d : traces) d = TraceData(); }
+
+LinePlot::Range LinePlot::rangeOf(Axis a) const {
+    if (a == AxisRsi) return {0.0, 100.0};
+    Range r; bool any = false;
+    auto scan = [&](const TraceData& d) {
+        if (!d.visible || d.y.empty()) return;
+        const auto mm = std::minmax_element(d.y.begin(), d.y.end());
+        r.lo = any ? std::min(r.lo, *mm.first) : *mm.first; r.hi = any ? std::max(r.hi, *mm.second) : *mm.second; any = true;
+    };
+    if (a == AxisPrice) scan(traces[Price]); else { scan(traces[Macd]); scan(traces[Signal]); }
+    if (!any) return {0.0, 1.0};
+    if (r.hi - r.lo <= std::abs(r.hi) * 1e-12) r.hi = r.lo + std::max(std::abs(r.lo) * 1e-6, 1e-12); // flat series
+    return r;
+}
+
+QRect LinePlot::plotArea(const QRect& r) const {
+    const int left = style.axisLabels ? 58 : 8;
+    const int right = 8 + (style.axisLabels ? (traces[Rsi].visible ? 28 : 0) + (traces[Macd].visible ? 52 : 0) : 0);
+    const int top = title.isEmpty() ? 8 : 26, bottom = style.axisLabels ? 22 : 8;
+    return r.adjusted(left, top, -right, -bottom);
+}
+
+void LinePlot::paint(QPainter& p, const QRect& widgetRect) {
+    p.fillRect(widgetRect, style.background);
+    const QRect area = plotArea(widgetRect);
+    if (area.width() < 2 || area.height() < 2) return;
+    const Range ranges[AxisCount] = {rangeOf(AxisPrice), rangeOf(AxisRsi), rangeOf(AxisMacd)};
+    const size_t n = traces[Price].y.size(); const double dx = double(area.width() - 1) / double(n > 1 ? n - 1 : 1);
+    // Grid and labels: 5 rows per value axis, both ends of the sample axis (the QValueAxis defaults used before)
+    constexpr int kRows = 4;
+    auto rowY = [&](int i) { return area.top() + int(std::lround((area.height() - 1) * double(i) / kRows)); };
+    QFont f = p.font(); f.setPointSizeF(8); p.setFont(f);
+    if (style.gridLines) {
+        p.setPen(QPen(style.grid, 1, Qt::DotLine));
+        for (int i=0; i<=kRows; ++i) p.drawLine(area.left(), rowY(i), area.right(), rowY(i));
+        p.drawLine(area.topLeft(), area.bottomLeft()); p.drawLine(area.topRight(), area.bottomRight());
+    }
+    if (style.axisLabels) {
+        p.setPen(style.text);
+        auto labels = [&](const Range& r, int x, int w, Qt::Alignment al, int prec) {
+            for (int i=0; i<=kRows; ++i) p.drawText(QRect(x, rowY(i) - 8, w, 16), al | Qt::AlignVCenter, QString::number(r.hi - (r.hi - r.lo) * i / kRows, 'f', prec));
+        };
+        labels(ranges[AxisPrice], widgetRect.left() + 2, area.left() - widgetRect.left() - 6, Qt::AlignRight, 2);
+        int x = area.right() + 4;
+        if (traces[Rsi].visible) { labels(ranges[AxisRsi], x, 24, Qt::AlignLeft, 0); x += 28; }
+        if (traces[Macd].visible) labels(ranges[AxisMacd], x, 48, Qt::AlignLeft, 2);
+        p.drawText(QRect(area.left() - 20, area.bottom() + 4, 40, 16), Qt::AlignCenter, "0");
+        p.drawText(QRect(area.right() - 30, area.bottom() + 4, 60, 16), Qt::AlignCenter, QString::number(n > 0 ? n - 1 : 0));
+    }
+    if (!title.isEmpty()) {
+        QFont tf = f; tf.setPointSizeF(10); tf.setBold(true); p.setFont(tf); p.setPen(style.text);
+        p.drawText(QRect(widgetRect.left(), widgetRect.top() + 4, widgetRect.width(), 20), Qt::AlignCenter, title);
+    }
+
+    // Traces: pixel y cached per point, x in sample units scaled by the painter (cosmetic pens keep their width)
+    static const QColor colors[TraceCount] = {QColor(), QColor(120,200,255), QColor(120,200,255), QColor(180,120,255), QColor(255,90,90), QColor(255,190,120)};
+    p.save(); p.setClipRect(area); p.setBrush(Qt::NoBrush);
+    const QTransform world = p.worldTransform();
+    for (Trace t : {BbUpper, BbLower, Rsi, Macd, Signal, Price}) { // price on top
+        TraceData& d = traces[t]; if (!d.visible || d.y.empty()) continue;
+        const Range& r = ranges[axisOf(t)];
+        if (d.area != area || !(d.range == r)) { d.px.clear(); d.area = area; d.range = r; d.pxStale = 0; }
+        const double sy = double(area.height() - 1) / (r.hi - r.lo);
+        for (int i=0; i<d.pxStale && i<d.px.size(); ++i) d.px[i] = QPointF(d.base + double(i), area.bottom() - (d.y[size_t(i)] - r.lo) * sy);
+        d.pxStale = 0;
+        d.px.reserve(qsizetype(d.y.size()));
+        for (size_t i = size_t(d.px.size()); i < d.y.size(); ++i) d.px.append(QPointF(d.base + double(i), area.bottom() - (d.y[i] - r.lo) * sy));
+        QPen pen(t == Price ? style.line : colors[t], t == Price ? 1.6 : 1.2); pen.setCosmetic(true); p.setPen(pen);
+        p.setWorldTransform(QTransform(dx, 0, 0, 1, area.left() - d.base * dx, 0) * world);
+        p.drawPolyline(d.px);
+    }
+    p.restore();
+}
+
+size_t LinePlot::memoryBytes() const {
+    size_t n = sizeof(*this);
+    for (const TraceData& d : traces) n += d.y.capacity() * sizeof(double) + size_t(d.px.capacity()) * sizeof(QPointF);
+    return n;
+}
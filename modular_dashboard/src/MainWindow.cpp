@@ -1,7 +1,12 @@
 #include "MainWindow.h"
 #include "MarketOverviewWindow.h"
 #include "MultiCompareWindow.h"
+#include "LatencyWindow.h"
+#include "LatencyTracer.h"
 #include "HistoryStorage.h"
+#include "FrameScheduler.h"
+#include "Profiler.h"
+#include "TimeSeriesStore.h"
 #include <QGridLayout>
 #include <QThread>
 #include <QMenuBar>
@@ -10,8 +15,12 @@
 #include <QFormLayout>
 #include <QSpinBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QTimer>
 #include <QDialogButtonBox>
 #include <QInputDialog>
+#include <QLineEdit>
 #include <QSettings>
 #include <QApplication>
 #include <QMessageBox>
@@ -35,7 +44,8 @@ class PerformanceConfigDialog : public QDialog {
     Q_OBJECT
 public:
     PerformanceConfigDialog(QWidget* parent,
-                            int animMsInit,int renderMsInit,int cacheMsInit,int volWindowInit,int maxPtsInit,int rawCacheInit,
+                            int animMsInit,int renderMsInit,int cacheMsInit,int volWindowInit,int maxPtsInit,int rawCacheInit,int batchMsInit,
+                            bool tickRingInit, int ringPolicyInit, bool conflateInit, int shardsInit, int shardThreadsInit, int rasterThreadsInit,
                             double pyInitSpanPctInit, double pyMinCompressInit, double pyMaxCompressInit, double pyMinWidthPctInit,
                             int scalingWindowSizeInit, double scalingPaddingPctInit)
                             : QDialog(parent) {
@@ -47,6 +57,13 @@ public:
         volWindow = new QSpinBox(); volWindow->setRange(10,20000); volWindow->setValue(volWindowInit);
         maxPts = new QSpinBox(); maxPts->setRange(100,20000); maxPts->setValue(maxPtsInit);
         rawCache = new QSpinBox(); rawCache->setRange(1000,500000); rawCache->setValue(rawCacheInit);
+        batchMs = new QSpinBox(); batchMs->setRange(0,100); batchMs->setValue(batchMsInit);
+        tickRing = new QCheckBox(); tickRing->setChecked(tickRingInit);
+        ringPolicy = new QComboBox(); ringPolicy->addItems({"Drop oldest", "Conflate per symbol", "Block producer"}); ringPolicy->setCurrentIndex(std::clamp(ringPolicyInit, 0, 2));
+        conflate = new QCheckBox(); conflate->setChecked(conflateInit);
+        shards = new QSpinBox(); shards->setRange(0, DataWorkerPool::MaxShards); shards->setValue(shardsInit);
+        shardThreads = new QSpinBox(); shardThreads->setRange(1, DataWorkerPool::MaxShards); shardThreads->setValue(shardThreadsInit);
+        rasterThreads = new QSpinBox(); rasterThreads->setRange(0, 64); rasterThreads->setValue(rasterThreadsInit);
         // Python-like scaling controls
         pyInitSpanPct = new QDoubleSpinBox(); pyInitSpanPct->setRange(0.000001, 0.5); pyInitSpanPct->setDecimals(6); pyInitSpanPct->setSingleStep(0.0005); pyInitSpanPct->setValue(pyInitSpanPctInit);
         pyMinCompress = new QDoubleSpinBox(); pyMinCompress->setRange(1.0, 1.01); pyMinCompress->setDecimals(6); pyMinCompress->setSingleStep(0.000001); pyMinCompress->setValue(pyMinCompressInit);
@@ -55,12 +72,19 @@ public:
         // Scaling controls
         scalingWindowSize = new QSpinBox(); scalingWindowSize->setRange(0, 20000); scalingWindowSize->setValue(scalingWindowSizeInit);
         scalingPaddingPct = new QDoubleSpinBox(); scalingPaddingPct->setRange(0.0, 0.5); scalingPaddingPct->setDecimals(4); scalingPaddingPct->setSingleStep(0.001); scalingPaddingPct->setValue(scalingPaddingPctInit);
-        layout->addRow("Animation (ms)", animMs);
-        layout->addRow("Render interval (ms)", renderMs);
-        layout->addRow("Cache update (ms)", cacheMs);
+        layout->addRow("Needle settle (ms)", animMs);
+        layout->addRow("Frame interval (ms, all widgets)", renderMs);
+        layout->addRow("Chart cache refresh (ms, per widget)", cacheMs);
+        layout->addRow("Tile render threads (0=GUI thread)", rasterThreads);
         layout->addRow("Volatility window", volWindow);
         layout->addRow("Max chart points", maxPts);
         layout->addRow("Raw cache size", rawCache);
+        layout->addRow("Tick batch interval (ms, 0=off)", batchMs);
+        layout->addRow("SPSC ring handoff (overrides batching)", tickRing);
+        layout->addRow("Ring overflow policy", ringPolicy);
+        layout->addRow("Conflate ticks per frame (last price, OHLC/volume kept)", conflate);
+        layout->addRow("Connections per feed (0=auto)", shards);
+        layout->addRow("Ingest threads", shardThreads);
         layout->addRow("Python init span (±pct)", pyInitSpanPct);
         layout->addRow("Python min compress (×)", pyMinCompress);
         layout->addRow("Python max compress (×)", pyMaxCompress);
@@ -78,6 +102,13 @@ public:
     int volatilityWindowSize() const { return volWindow->value(); }
     int maxPointsCount() const { return maxPts->value(); }
     int rawCacheSize() const { return rawCache->value(); }
+    int batchIntervalMs() const { return batchMs->value(); }
+    bool tickRingEnabled() const { return tickRing->isChecked(); }
+    int ringPolicyIndex() const { return ringPolicy->currentIndex(); }
+    bool conflateEnabled() const { return conflate->isChecked(); }
+    int shardCount() const { return shards->value(); }
+    int shardThreadCount() const { return shardThreads->value(); }
+    int rasterThreadCount() const { return rasterThreads->value(); }
     double pyInitSpanPctVal() const { return pyInitSpanPct->value(); }
     double pyMinCompressVal() const { return pyMinCompress->value(); }
     double pyMaxCompressVal() const { return pyMaxCompress->value(); }
@@ -85,12 +116,14 @@ public:
     int scalingWindowSizeVal() const { return scalingWindowSize->value(); }
     double scalingPaddingPctVal() const { return scalingPaddingPct->value(); }
 private:
-    QSpinBox *animMs, *renderMs, *cacheMs, *volWindow, *maxPts, *rawCache, *scalingWindowSize;
+    QSpinBox *animMs, *renderMs, *cacheMs, *volWindow, *maxPts, *rawCache, *batchMs, *shards, *shardThreads, *rasterThreads, *scalingWindowSize;
     QDoubleSpinBox *pyInitSpanPct, *pyMinCompress, *pyMaxCompress, *pyMinWidthPct, *scalingPaddingPct;
+    QCheckBox* tickRing; QComboBox* ringPolicy; QCheckBox* conflate;
 };
 
 MainWindow::MainWindow() {
     themeManager = new ThemeManager(this);
+    btcId = SymbolRegistry::instance().intern("BTC");
     QWidget* central = new QWidget(this); setCentralWidget(central); gridLayout = new QGridLayout(central); gridLayout->setSpacing(10);
     // Load saved currencies; fall back to defaults only if nothing saved
     currentCurrencies = readCurrenciesSettings();
@@ -126,7 +159,7 @@ MainWindow::MainWindow() {
                 }
                 saveCurrenciesSettings(currentCurrencies);
                 widgets[newTicker]->setUnsupportedReason(""); widgets[currentTicker]->setUnsupportedReason("");
-                QMetaObject::invokeMethod(dataWorker, [this](){ dataWorker->setCurrencies(realSymbolsFrom(currentCurrencies)); }, Qt::QueuedConnection);
+                dataPool->setCurrencies(realSymbolsFrom(currentCurrencies));
                 refreshCompareSubscriptions();
                 reflowGrid();
             }, Qt::QueuedConnection);
@@ -164,17 +197,11 @@ MainWindow::MainWindow() {
     }
     connect(provBinance, &QAction::triggered, this, [this](){
         QSettings st("alel12", "modular_dashboard"); st.setValue("stream/provider", "Binance"); st.sync();
-        if (dataWorker) {
-            QMetaObject::invokeMethod(dataWorker, "stop", Qt::QueuedConnection);
-            QMetaObject::invokeMethod(dataWorker, [this](){ dataWorker->setProvider(DataProvider::Binance); dataWorker->setMode(streamMode); dataWorker->start(); }, Qt::QueuedConnection);
-        }
+        if (dataPool) { dataPool->stop(); dataPool->setProvider(DataProvider::Binance); dataPool->setMode(streamMode); dataPool->start(); }
     });
     connect(provBybit, &QAction::triggered, this, [this](){
         QSettings st("alel12", "modular_dashboard"); st.setValue("stream/provider", "Bybit"); st.sync();
-        if (dataWorker) {
-            QMetaObject::invokeMethod(dataWorker, "stop", Qt::QueuedConnection);
-            QMetaObject::invokeMethod(dataWorker, [this](){ dataWorker->setProvider(DataProvider::Bybit); dataWorker->setMode(streamMode); dataWorker->start(); }, Qt::QueuedConnection);
-        }
+        if (dataPool) { dataPool->stop(); dataPool->setProvider(DataProvider::Bybit); dataPool->setMode(streamMode); dataPool->start(); }
     });
 
     auto* settingsMenu = menuBar()->addMenu("Settings");
@@ -281,9 +308,7 @@ MainWindow::MainWindow() {
     }
     auto applyBybitPref = [this](bool linearFirst){
         QSettings st("alel12", "modular_dashboard"); st.setValue("bybit/preference", linearFirst?"LinearFirst":"SpotFirst"); st.sync();
-        if (dataWorker) {
-            QMetaObject::invokeMethod(dataWorker, [this,linearFirst](){ dataWorker->setBybitPreference(linearFirst?BybitPreference::LinearFirst:BybitPreference::SpotFirst); dataWorker->stop(); dataWorker->start(); }, Qt::QueuedConnection);
-        }
+        if (dataPool) { dataPool->setBybitPreference(linearFirst?BybitPreference::LinearFirst:BybitPreference::SpotFirst); dataPool->restart(); }
         // Update badges for all widgets
         for (auto* w : widgets) w->setMarketBadge("Bybit", linearFirst?"Linear":"Spot");
     };
@@ -562,7 +587,7 @@ MainWindow::MainWindow() {
         if (useSql) path = QFileDialog::getSaveFileName(this, QString::fromUtf8("Сохранить SQLite"), QDir::homePath()+"/history.sqlite", "SQLite DB (*.sqlite *.db)");
         else path = QFileDialog::getSaveFileName(this, QString::fromUtf8("Сохранить JSONL"), QDir::homePath()+"/history.jsonl", "JSON Lines (*.jsonl)");
         if (path.isEmpty()) return;
-        auto bundles = HistoryStorage::collect(widgets);
+        auto bundles = HistoryStorage::collect();
         QString err; bool ok = history->save(bundles, path, &err);
         if (ok) QMessageBox::information(this, QString::fromUtf8("Сохранение"), QString::fromUtf8("История сохранена: %1").arg(path));
         else QMessageBox::critical(this, QString::fromUtf8("Ошибка"), QString::fromUtf8("Не удалось сохранить: %1").arg(err));
@@ -586,9 +611,14 @@ MainWindow::MainWindow() {
                 prevT = r.ts;
             }
         }
-        // Apply: if widget exists for symbol, replace its history and badges
+        // Apply: the store gets every symbol; a widget showing it also resets its badges and derived state
         int applied=0; for (const auto& b : bundles) {
-            if (!widgets.contains(b.symbol)) continue;
+            if (!widgets.contains(b.symbol)) {
+                std::vector<TimeSeriesStore::Point> pts; pts.reserve(size_t(b.points.size()));
+                for (const auto& r : b.points) pts.push_back({r.ts, r.value, r.seq, HistoryRing::makeTag(r.source, r.provider, r.market)});
+                TimeSeriesStore::instance().replace(SymbolRegistry::instance().intern(b.symbol.toUpper()), pts);
+                ++applied; continue;
+            }
             auto* w = widgets[b.symbol];
             QVector<DynamicSpeedometerCharts::HistoryPoint> pts; pts.reserve(b.points.size());
             for (const auto& r : b.points) { DynamicSpeedometerCharts::HistoryPoint hp; hp.ts=r.ts; hp.value=r.value; hp.provider=r.provider; hp.market=r.market; hp.source=r.source; hp.seq=r.seq; pts.push_back(hp); }
@@ -627,7 +657,7 @@ MainWindow::MainWindow() {
         QDir().mkpath(base);
         const bool useSql = history->backend()==HistoryStorage::Backend::SQLite;
         QString path = base + (useSql? "/autosave.sqlite" : "/autosave.jsonl");
-        auto bundles = HistoryStorage::collect(widgets); QString err; if (!history->save(bundles, path, &err)) {
+        auto bundles = HistoryStorage::collect(); QString err; if (!history->save(bundles, path, &err)) {
             // Silent log via message box only if first time? keep it simple:
             QMessageBox::warning(this, "History", QString::fromUtf8("Автосохранение не удалось: %1").arg(err));
         }
@@ -657,6 +687,53 @@ MainWindow::MainWindow() {
         compareWindow->setSources(widgets);
         compareWindow->show(); compareWindow->raise(); compareWindow->activateWindow();
     });
+    // End-to-end tick latency (exchange -> parse -> widget -> paint)
+    QAction* openLatency = toolsMenu->addAction(QString::fromUtf8("Задержки тиков"));
+    connect(openLatency, &QAction::triggered, this, [this](){
+        if (!latencyWindow) {
+            latencyWindow = new LatencyWindow(this);
+            latencyWindow->setAttribute(Qt::WA_DeleteOnClose, true);
+            connect(latencyWindow, &QObject::destroyed, this, [this](){ latencyWindow=nullptr; });
+        }
+        latencyWindow->show(); latencyWindow->raise(); latencyWindow->activateWindow();
+    });
+    // Raw frame capture / offline replay of the main feed
+    toolsMenu->addSeparator();
+    QAction* actRecord = toolsMenu->addAction(QString::fromUtf8("Запись сырых фреймов...")); actRecord->setCheckable(true);
+    QAction* actReplay = toolsMenu->addAction(QString::fromUtf8("Воспроизвести запись..."));
+    QAction* actLive = toolsMenu->addAction(QString::fromUtf8("Вернуться к живому потоку")); actLive->setEnabled(false);
+    connect(actRecord, &QAction::toggled, this, [this,actRecord](bool on){
+        if (!dataPool) return;
+        if (!on) { dataPool->setRecording(QString()); return; }
+        QSettings st("alel12", "modular_dashboard");
+        const QString path = QFileDialog::getSaveFileName(this, QString::fromUtf8("Файл записи"), st.value("stream/capturePath", QDir::homePath()+"/session.mdcap").toString(), "Frame capture (*.mdcap)");
+        if (path.isEmpty() || !dataPool->setRecording(path)) {
+            if (!path.isEmpty()) QMessageBox::warning(this, "Capture", QString::fromUtf8("Не удалось открыть %1").arg(path));
+            QSignalBlocker b(actRecord); actRecord->setChecked(false); return;
+        }
+        st.setValue("stream/capturePath", path); st.sync();
+    });
+    connect(actReplay, &QAction::triggered, this, [this,actLive](){
+        if (!dataPool) return;
+        QSettings st("alel12", "modular_dashboard");
+        const QString path = QFileDialog::getOpenFileName(this, QString::fromUtf8("Воспроизвести запись"), st.value("stream/capturePath", QDir::homePath()).toString(), "Frame capture (*.mdcap)");
+        if (path.isEmpty()) return;
+        bool ok=false; const double speed = QInputDialog::getDouble(this, "Replay", QString::fromUtf8("Скорость (1 = реальная, 0 = максимальная):"), st.value("stream/replaySpeed", 1.0).toDouble(), 0.0, 1000.0, 2, &ok);
+        if (!ok) return;
+        st.setValue("stream/capturePath", path); st.setValue("stream/replaySpeed", speed); st.sync();
+        dataPool->setReplay(path, speed); actLive->setEnabled(true);
+    });
+    connect(actLive, &QAction::triggered, this, [this,actLive](){ if (dataPool) dataPool->setReplay(QString(), 1.0); actLive->setEnabled(false); });
+    // Endpoint override for load tests against tools/synthetic_exchange (one base for both providers; empty = official)
+    QAction* actEndpoint = toolsMenu->addAction(QString::fromUtf8("Адрес биржи (тест)..."));
+    connect(actEndpoint, &QAction::triggered, this, [this](){
+        if (!dataPool) return;
+        QSettings st("alel12", "modular_dashboard");
+        bool ok=false; const QString base = QInputDialog::getText(this, "Endpoint", QString::fromUtf8("Базовый URL, напр. ws://127.0.0.1:9443 (пусто = официальные):"), QLineEdit::Normal, st.value("stream/binanceUrl").toString(), &ok).trimmed();
+        if (!ok) return;
+        st.setValue("stream/binanceUrl", base); st.setValue("stream/bybitUrl", base); st.sync();
+        dataPool->setBaseUrls(base, base);
+    });
 
     // Data worker thread (default to TICKER mode by settings)
     // Read default stream mode
@@ -672,36 +749,37 @@ MainWindow::MainWindow() {
         const QString srcKindInit = (streamMode==StreamMode::Trade? "TRADE" : "TICKER");
         for (auto* w : widgets) w->setSourceKind(srcKindInit);
     }
-    dataWorker = new DataWorker(); dataWorker->setMode(streamMode);
+    dataPool = new DataWorkerPool(this); dataPool->setMode(streamMode);
     // Apply saved provider before starting
     {
         QSettings st("alel12", "modular_dashboard");
         QString p = st.value("stream/provider", "Binance").toString();
         auto provBybit = (p.compare("Bybit", Qt::CaseInsensitive)==0);
-        dataWorker->setProvider(provBybit ? DataProvider::Bybit : DataProvider::Binance);
+        dataPool->setProvider(provBybit ? DataProvider::Bybit : DataProvider::Binance);
         // Apply saved Bybit preference
         QString pref = st.value("bybit/preference", "LinearFirst").toString();
-        dataWorker->setBybitPreference(pref=="LinearFirst"? BybitPreference::LinearFirst : BybitPreference::SpotFirst);
+        dataPool->setBybitPreference(pref=="LinearFirst"? BybitPreference::LinearFirst : BybitPreference::SpotFirst);
+        dataPool->setBaseUrls(st.value("stream/binanceUrl").toString(), st.value("stream/bybitUrl").toString());
         // seed badges
         const QString initMarket = provBybit ? (pref=="LinearFirst"?"Linear":"Spot") : "";
         for (auto* w : widgets) w->setMarketBadge(provBybit?"Bybit":"Binance", initMarket);
     }
-    workerThread = new QThread(this); dataWorker->moveToThread(workerThread);
-    connect(workerThread, &QThread::started, dataWorker, &DataWorker::start);
-    connect(dataWorker, &DataWorker::dataUpdated, this, &MainWindow::handleData);
-    connect(dataWorker, &DataWorker::dataTick, this, [this](const QString& cur,double price,double ts,const QString& prov,const QString& market){
+    connect(dataPool, &DataWorkerPool::dataUpdated, this, &MainWindow::handleData);
+    connect(dataPool, &DataWorkerPool::dataTick, this, [this](const QString& cur,double price,double ts,const QString& prov,const QString& market){
         if (widgets.contains(cur)) widgets[cur]->setMarketBadge(prov, market);
     });
-    connect(dataWorker, &DataWorker::volumeTick, this, [this](const QString& cur,double volBase,double volQuote,double volIncr,double ts){
+    connect(dataPool, &DataWorkerPool::volumeTick, this, [this](const QString& cur,double volBase,double volQuote,double volIncr,double ts){
         if (widgets.contains(cur)) widgets[cur]->updateVolume(volBase, volQuote, volIncr, ts);
     });
-    connect(dataWorker, &DataWorker::unsupportedSymbol, this, [this](const QString& cur,const QString& reason){
+    connect(dataPool, &DataWorkerPool::unsupportedSymbol, this, [this](const QString& cur,const QString& reason){
         if (widgets.contains(cur)) widgets[cur]->setUnsupportedReason(reason);
     });
-    connect(workerThread, &QThread::finished, dataWorker, &QObject::deleteLater);
-    // push currencies to worker after moving to thread
-    QMetaObject::invokeMethod(dataWorker, [this](){ dataWorker->setCurrencies(realSymbolsFrom(currentCurrencies)); }, Qt::QueuedConnection);
-    workerThread->start();
+    connect(dataPool, &DataWorkerPool::ticksReady, this, &MainWindow::handleTickBatch);
+    { const auto ps = readPerfSettings(); dataPool->setBatchInterval(ps.batchMs); dataPool->configure(ps.shards, ps.shardThreads); }
+    LatencyTracer::instance().setEnabled(QSettings("alel12", "modular_dashboard").value("perf/latencyTrace", false).toBool());
+    // Shards (connections + threads) are created for the initial list and started right away
+    dataPool->start();
+    dataPool->setCurrencies(realSymbolsFrom(currentCurrencies));
 
     // Load all persistent settings
     loadSettingsAndApply();
@@ -746,12 +824,56 @@ MainWindow::MainWindow() {
     connect(cmpBinanceThread, &QThread::started, cmpBinance, &DataWorker::start);
     connect(cmpBybitLinearThread, &QThread::started, cmpBybitLinear, &DataWorker::start);
     connect(cmpBybitSpotThread, &QThread::started, cmpBybitSpot, &DataWorker::start);
-    connect(cmpBinance, &DataWorker::dataUpdated, this, [this](const QString& cur, double price, double){ binancePrice[cur]=price; recomputePseudoTickers(); });
-    connect(cmpBybitLinear, &DataWorker::dataUpdated, this, [this](const QString& cur, double price, double){ bybitLinearPrice[cur]=price; recomputePseudoTickers(); });
-    connect(cmpBybitSpot, &DataWorker::dataUpdated, this, [this](const QString& cur, double price, double){ bybitSpotPrice[cur]=price; recomputePseudoTickers(); });
+    connect(cmpBinance, &DataWorker::dataUpdated, this, [this](const QString& cur, double price, double){ binancePrice[SymbolRegistry::instance().intern(cur)]=price; recomputePseudoTickers(); });
+    connect(cmpBybitLinear, &DataWorker::dataUpdated, this, [this](const QString& cur, double price, double){ bybitLinearPrice[SymbolRegistry::instance().intern(cur)]=price; recomputePseudoTickers(); });
+    connect(cmpBybitSpot, &DataWorker::dataUpdated, this, [this](const QString& cur, double price, double){ bybitSpotPrice[SymbolRegistry::instance().intern(cur)]=price; recomputePseudoTickers(); });
     connect(cmpBinanceThread, &QThread::finished, cmpBinance, &QObject::deleteLater);
     connect(cmpBybitLinearThread, &QThread::finished, cmpBybitLinear, &QObject::deleteLater);
     connect(cmpBybitSpotThread, &QThread::finished, cmpBybitSpot, &QObject::deleteLater);
+
+    // Ring handoff: one SPSC ring per worker, drained on the GUI frame tick
+    cmpBinanceRing.reset(new TickRing(1024)); cmpBybitLinearRing.reset(new TickRing(1024)); cmpBybitSpotRing.reset(new TickRing(1024));
+    applyTickRingSettings(readPerfSettings());
+    connect(&FrameScheduler::instance(), &FrameScheduler::frameStarted, this, &MainWindow::drainTickRings);
+}
+
+void MainWindow::applyTickRingSettings(const PerfSettings& s) {
+    const TickRing::Policy policy = (s.ringPolicy==1) ? TickRing::Policy::Conflate : (s.ringPolicy==2 ? TickRing::Policy::Block : TickRing::Policy::DropOldest);
+    if (dataPool) dataPool->setTickRing(s.tickRing, policy);
+    const std::pair<DataWorker*, TickRing*> pairs[] = { {cmpBinance, cmpBinanceRing.get()}, {cmpBybitLinear, cmpBybitLinearRing.get()}, {cmpBybitSpot, cmpBybitSpotRing.get()} };
+    for (const auto& p : pairs) {
+        if (!p.first || !p.second) continue;
+        p.second->setPolicy(policy);
+        DataWorker* worker = p.first; TickRing* ring = s.tickRing ? p.second : nullptr;
+        QMetaObject::invokeMethod(worker, [worker,ring](){ worker->setTickRing(ring); }, Qt::QueuedConnection);
+    }
+    conflateTicks = s.conflate;
+}
+
+// GUI frame tick: drain every worker ring in one pass (main worker feeds widgets, compare workers feed @DIFF prices)
+void MainWindow::drainTickRings() {
+    Profiler::Scope prof("MainWindow::drainTickRings");
+    bool touched = false;
+    drainBuf.clear();
+    if (dataPool && dataPool->drain(drainBuf) > 0) touched |= applyTicks(drainBuf);
+    auto drainCompare = [&](TickRing* ring, SymbolVector<double>& prices) {
+        if (!ring) return; drainBuf.clear(); ring->drain(drainBuf);
+        for (const TickRecord& t : drainBuf) { if (t.symbol == InvalidSymbol) continue; prices[t.symbol] = t.price; touched = true; }
+    };
+    drainCompare(cmpBinanceRing.get(), binancePrice);
+    drainCompare(cmpBybitLinearRing.get(), bybitLinearPrice);
+    drainCompare(cmpBybitSpotRing.get(), bybitSpotPrice);
+    if (touched) recomputePseudoTickers();
+    auto sampleStats = [](TickRing* ring, const char* hwmKey, const char* dropKey, const char* conflKey) {
+        if (!ring) return; const auto st = ring->stats();
+        Profiler::sample(hwmKey, double(st.highWater)); Profiler::sample(dropKey, double(st.dropped)); Profiler::sample(conflKey, double(st.conflated));
+    };
+    if (dataPool) dataPool->sampleRingStats();
+    LatencyTracer::instance().sampleToProfiler();
+    if (conflateTicks) { Profiler::sample("conflate/in_total", double(conflator.inTotal())); Profiler::sample("conflate/conflated_total", double(conflator.conflatedTotal())); }
+    sampleStats(cmpBinanceRing.get(), "ring/cmpBinance/high_water", "ring/cmpBinance/dropped_total", "ring/cmpBinance/conflated_total");
+    sampleStats(cmpBybitLinearRing.get(), "ring/cmpBybitLinear/high_water", "ring/cmpBybitLinear/dropped_total", "ring/cmpBybitLinear/conflated_total");
+    sampleStats(cmpBybitSpotRing.get(), "ring/cmpBybitSpot/high_water", "ring/cmpBybitSpot/dropped_total", "ring/cmpBybitSpot/conflated_total");
 }
 
 #include "MainWindow.moc"
@@ -759,10 +881,11 @@ MainWindow::MainWindow() {
 void MainWindow::closeEvent(QCloseEvent* e) {
     // Flush any pending UI state changes
     saveCurrenciesSettings(currentCurrencies);
-    // Gracefully stop main worker (avoid Blocking to prevent deadlocks during app quit)
-    if (dataWorker && workerThread && workerThread->isRunning()) {
-        QMetaObject::invokeMethod(dataWorker, "stop", Qt::QueuedConnection);
-    }
+    // Release producers waiting on a full ring (Block policy) so worker threads can process stop()
+    if (dataPool) dataPool->closeRings();
+    for (TickRing* r : {cmpBinanceRing.get(), cmpBybitLinearRing.get(), cmpBybitSpotRing.get()}) if (r) r->close();
+    // Gracefully stop main feed shards (queued stop, then join their threads)
+    if (dataPool) dataPool->shutdown();
     // Stop compare workers
     if (cmpBinance && cmpBinanceThread && cmpBinanceThread->isRunning()) {
         QMetaObject::invokeMethod(cmpBinance, "stop", Qt::BlockingQueuedConnection);
@@ -775,7 +898,6 @@ void MainWindow::closeEvent(QCloseEvent* e) {
     }
     // Quit threads
     auto quitAndWait = [](QThread* t){ if (!t) return; t->quit(); if (!t->wait(2500)) { t->quit(); t->wait(1000); } };
-    quitAndWait(workerThread);
     quitAndWait(cmpBinanceThread);
     quitAndWait(cmpBybitLinearThread);
     quitAndWait(cmpBybitSpotThread);
@@ -784,10 +906,9 @@ void MainWindow::closeEvent(QCloseEvent* e) {
 }
 
 MainWindow::~MainWindow() {
-    if (dataWorker && workerThread && workerThread->isRunning()) {
-        QMetaObject::invokeMethod(dataWorker, "stop", Qt::QueuedConnection);
-    }
-    if (workerThread) { workerThread->quit(); workerThread->wait(2500); }
+    if (dataPool) dataPool->closeRings();
+    for (TickRing* r : {cmpBinanceRing.get(), cmpBybitLinearRing.get(), cmpBybitSpotRing.get()}) if (r) r->close();
+    if (dataPool) dataPool->shutdown();
     // Stop compare workers
     if (cmpBinance && cmpBinanceThread && cmpBinanceThread->isRunning()) QMetaObject::invokeMethod(cmpBinance, "stop", Qt::BlockingQueuedConnection);
     if (cmpBybitLinear && cmpBybitLinearThread && cmpBybitLinearThread->isRunning()) QMetaObject::invokeMethod(cmpBybitLinear, "stop", Qt::BlockingQueuedConnection);
@@ -799,7 +920,7 @@ MainWindow::~MainWindow() {
 
 void MainWindow::switchMode(StreamMode m) {
     streamMode = m;
-    QMetaObject::invokeMethod(dataWorker, [this,m](){ dataWorker->stop(); dataWorker->setMode(m); dataWorker->start(); }, Qt::QueuedConnection);
+    dataPool->stop(); dataPool->setMode(m); dataPool->start();
     setWindowTitle(QString("Modular Crypto Dashboard — %1").arg(m==StreamMode::Trade?"TRADE":"TICKER"));
     // Persist choice
     QSettings st("alel12", "modular_dashboard"); st.setValue("stream/mode", m==StreamMode::Ticker?"TICKER":"TRADE"); st.sync();
@@ -822,10 +943,10 @@ void MainWindow::openPerformanceDialog() {
     double scalingPadding = st.value("scaling/paddingPct", 0.01).toDouble();
     // Get current scaling settings from first widget
     auto currentScaling = widgets.isEmpty() ? DynamicSpeedometerCharts::ScalingSettings{} : widgets.first()->scaling();
-    PerformanceConfigDialog dlg(this, s.animMs, s.renderMs, s.cacheMs, s.volWindow, s.maxPts, s.rawCache,
+    PerformanceConfigDialog dlg(this, s.animMs, s.renderMs, s.cacheMs, s.volWindow, s.maxPts, s.rawCache, s.batchMs, s.tickRing, s.ringPolicy, s.conflate, s.shards, s.shardThreads, s.rasterThreads,
                                 pyInitSpan, pyMinComp, pyMaxComp, pyMinWidth, currentScaling.windowSize, currentScaling.paddingPct);
     if (dlg.exec()==QDialog::Accepted) {
-        PerfSettings ns{dlg.animationMs(), dlg.renderIntervalMs(), dlg.cacheIntervalMs(), dlg.volatilityWindowSize(), dlg.maxPointsCount(), dlg.rawCacheSize()};
+        PerfSettings ns{dlg.animationMs(), dlg.renderIntervalMs(), dlg.cacheIntervalMs(), dlg.volatilityWindowSize(), dlg.maxPointsCount(), dlg.rawCacheSize(), dlg.batchIntervalMs(), dlg.tickRingEnabled(), dlg.ringPolicyIndex(), dlg.shardCount(), dlg.shardThreadCount(), dlg.conflateEnabled(), dlg.rasterThreadCount()};
         writePerfSettings(ns);
         // Save python-like params
         st.setValue("perf/pyInitSpanPct", dlg.pyInitSpanPctVal());
@@ -835,7 +956,10 @@ void MainWindow::openPerformanceDialog() {
         st.setValue("scaling/windowSize", dlg.scalingWindowSizeVal());
         st.setValue("scaling/paddingPct", dlg.scalingPaddingPctVal());
         st.sync();
-        for (auto* w : widgets) w->applyPerformance(ns.animMs, ns.renderMs, ns.cacheMs, ns.volWindow, ns.maxPts, ns.rawCache);
+        FrameScheduler::instance().configure(ns.renderMs, ns.cacheMs, ns.rasterThreads);
+        for (auto* w : widgets) w->applyPerformance(ns.animMs, ns.volWindow, ns.maxPts, ns.rawCache);
+        if (dataPool) { dataPool->setBatchInterval(ns.batchMs); dataPool->configure(ns.shards, ns.shardThreads); }
+        applyTickRingSettings(ns);
         // Apply python-like params live
         for (auto* w : widgets) w->setPythonScalingParams(dlg.pyInitSpanPctVal(), dlg.pyMinCompressVal(), dlg.pyMaxCompressVal(), dlg.pyMinWidthPctVal());
         // Apply scaling params live
@@ -855,19 +979,67 @@ void MainWindow::openThemeDialog() {
 }
 
 void MainWindow::handleData(const QString& currency, double price, double timestamp) {
-    if (widgets.contains(currency)) { if (currency=="BTC") btcPrice=price; QMetaObject::invokeMethod(this, [this,currency,price,timestamp](){ widgets[currency]->updateData(price, timestamp, btcPrice); }, Qt::QueuedConnection); }
-    // Track normalized value when widget is a real symbol
-    if (!isPseudo(currency) && widgets.contains(currency)) {
-        // Ask widget for current normalized value via property 'value'
-        bool ok=false; double v = widgets[currency]->property("value").toDouble(&ok); if (!ok) v = 0.0;
-        normalizedBySymbol[currency] = std::clamp(v, 0.0, 100.0);
+    if (!widgets.contains(currency)) return;
+    QMetaObject::invokeMethod(this, [this,currency,price,timestamp](){
+        auto* w = widgets.value(currency); if (!w) return;
+        const SymbolId id = w->symbolId();
+        TimeSeriesStore::instance().append(id, timestamp, price, w->historyTag()); w->updateData(price, timestamp);
+        if (isPseudo(currency)) return;
+        // Track the normalized value of this point (the needle's target, not its animated position)
+        const double v = w->targetValue();
+        normalizedById[id] = std::clamp(v, 0.0, 100.0);
         recomputePseudoTickers();
         // Feed analyzer with latest normalized value and volatility if known
-        if (marketAnalyzer) {
-            double vol = volBySymbol.value(currency, 0.0);
-            marketAnalyzer->updateSymbol(currency, timestamp, v, vol);
-        }
+        if (marketAnalyzer) marketAnalyzer->updateSymbol(id, timestamp, v, volById.value(id, 0.0));
+    }, Qt::QueuedConnection);
+}
+
+// Batched counterpart of handleData + volumeTick/dataTick handlers: one pass per batch, pseudo tickers recomputed once
+void MainWindow::handleTickBatch(const TickBatch& batch) {
+    Profiler::Scope prof("MainWindow::handleTickBatch");
+    if (batch.ticks.isEmpty()) return;
+    const qint64 now = Profiler::nowNs();
+    Profiler::sample("batch/size", batch.ticks.size());
+    Profiler::sample("batch/queue_ms", (now - batch.publishedNs) / 1e6);
+    Profiler::sample("batch/oldest_tick_ms", (now - batch.ticks.first().bufferedNs) / 1e6);
+    if (applyTicks(batch.ticks)) recomputePseudoTickers();
+}
+
+// Applies ticks to widgets/analyzer; returns true when a real symbol changed (caller recomputes pseudo tickers once)
+bool MainWindow::applyTicks(const QVector<TickRecord>& ticks) {
+    static const QString kBinance("Binance"), kBybit("Bybit"), kLinear("Linear"), kSpot("Spot"), kNone;
+    LatencyTracer& tracer = LatencyTracer::instance(); const bool tracing = tracer.isEnabled();
+    bool touched = false;
+    const QVector<TickRecord>* src = &ticks;
+    if (conflateTicks) { conflator.fold(ticks, conflateBuf); src = &conflateBuf; }
+    // Ingest: every tick lands in TimeSeriesStore (tagged source / provider / market; a folded record's open/high/low and trade
+    // count go to the pyramid buckets), then its widget, if any, reacts
+    TimeSeriesStore& store = TimeSeriesStore::instance();
+    const QString srcKind = streamMode==StreamMode::Trade ? "TRADE" : "TICKER";
+    HistoryRing::Tag tags[2][3]; // [provider][TickMarket]
+    for (int p=0; p<2; ++p) for (int m=0; m<3; ++m) tags[p][m] = HistoryRing::makeTag(srcKind, p ? kBybit : kBinance, m==int(TickMarket::Linear) ? kLinear : (m==int(TickMarket::Spot) ? kSpot : kNone));
+    for (const TickRecord& t : *src) {
+        store.append(t.symbol, t.timestamp, TimePyramid::Ohlc{t.open, t.high, t.low, t.price, t.ticks}, tags[t.provider==DataProvider::Binance ? 0 : 1][std::min(int(t.market), 2)]);
+        auto* w = widgetFor(t.symbol); if (!w) continue;
+        w->updateData(t.price, t.timestamp, t.high, t.low);
+        if (tracing) tracer.onTickApplied(t);
+        w->updateVolume(t.volBase, t.volQuote, t.volIncr, t.timestamp);
+        w->setMarketBadge(t.provider==DataProvider::Binance ? kBinance : kBybit, t.market==TickMarket::Linear ? kLinear : (t.market==TickMarket::Spot ? kSpot : kNone));
+        if (isPseudo(w->currencyName())) continue;
+        const double v = w->targetValue(); // this tick's normalized value; the needle position lags it by the spring
+        normalizedById[t.symbol] = std::clamp(v, 0.0, 100.0); touched = true;
+        if (marketAnalyzer) marketAnalyzer->updateSymbol(t.symbol, t.timestamp, v, volById.value(t.symbol, 0.0));
     }
+    return touched;
+}
+
+DynamicSpeedometerCharts* MainWindow::widgetFor(SymbolId id) {
+    if (id == InvalidSymbol) return nullptr;
+    if (id < widgetById.size()) { DynamicSpeedometerCharts* w = widgetById[id]; if (w && w->symbolId() == id) return w; }
+    // Miss or stale (widget renamed/removed): resolve once by name and cache
+    auto* w = widgets.value(SymbolRegistry::instance().name(id), nullptr);
+    if (id >= widgetById.size()) widgetById.resize(id + 1);
+    widgetById[id] = w; return w;
 }
 
 void MainWindow::onRequestRename(const QString& currentTicker) {
@@ -909,24 +1081,31 @@ void MainWindow::onRequestRename(const QString& currentTicker) {
     // Clear unsupported banner on both involved widgets (fresh start after rename)
     widgets[newTicker]->setUnsupportedReason("");
     widgets[currentTicker]->setUnsupportedReason("");
-    QMetaObject::invokeMethod(dataWorker, [this](){ dataWorker->setCurrencies(realSymbolsFrom(currentCurrencies)); }, Qt::QueuedConnection);
+    dataPool->setCurrencies(realSymbolsFrom(currentCurrencies));
     refreshCompareSubscriptions();
 }
 
 MainWindow::PerfSettings MainWindow::readPerfSettings() {
     QSettings st("alel12", "modular_dashboard"); PerfSettings s;
     s.animMs = st.value("perf/animMs", 400).toInt(); s.renderMs = st.value("perf/renderMs", 16).toInt(); s.cacheMs = st.value("perf/cacheMs", 300).toInt();
-    s.volWindow = st.value("perf/volWindow", 800).toInt(); s.maxPts = st.value("perf/maxPts", 800).toInt(); s.rawCache = st.value("perf/rawCache", 20000).toInt(); return s;
+    s.volWindow = st.value("perf/volWindow", 800).toInt(); s.maxPts = st.value("perf/maxPts", 800).toInt(); s.rawCache = st.value("perf/rawCache", 20000).toInt();
+    s.batchMs = st.value("perf/batchMs", 8).toInt();
+    s.tickRing = st.value("perf/tickRing", true).toBool(); s.ringPolicy = st.value("perf/ringPolicy", 0).toInt();
+    s.shards = st.value("perf/shards", 1).toInt(); s.shardThreads = st.value("perf/shardThreads", 1).toInt();
+    s.conflate = st.value("perf/conflate", true).toBool(); s.rasterThreads = st.value("perf/rasterThreads", 0).toInt(); return s;
 }
 
 void MainWindow::writePerfSettings(const PerfSettings& s) {
     QSettings st("alel12", "modular_dashboard");
     st.setValue("perf/animMs", s.animMs); st.setValue("perf/renderMs", s.renderMs); st.setValue("perf/cacheMs", s.cacheMs);
-    st.setValue("perf/volWindow", s.volWindow); st.setValue("perf/maxPts", s.maxPts); st.setValue("perf/rawCache", s.rawCache); st.sync();
+    st.setValue("perf/volWindow", s.volWindow); st.setValue("perf/maxPts", s.maxPts); st.setValue("perf/rawCache", s.rawCache); st.setValue("perf/batchMs", s.batchMs);
+    st.setValue("perf/tickRing", s.tickRing); st.setValue("perf/ringPolicy", s.ringPolicy);
+    st.setValue("perf/shards", s.shards); st.setValue("perf/shardThreads", s.shardThreads); st.setValue("perf/conflate", s.conflate); st.setValue("perf/rasterThreads", s.rasterThreads); st.sync();
 }
 
 void MainWindow::loadSettingsAndApply() {
-    auto s = readPerfSettings(); for (auto* w : widgets) w->applyPerformance(s.animMs, s.renderMs, s.cacheMs, s.volWindow, s.maxPts, s.rawCache);
+    auto s = readPerfSettings(); FrameScheduler::instance().configure(s.renderMs, s.cacheMs, s.rasterThreads);
+    for (auto* w : widgets) w->applyPerformance(s.animMs, s.volWindow, s.maxPts, s.rawCache);
     
     // Initialize theme settings
     QSettings st("alel12", "modular_dashboard");
@@ -1047,7 +1226,7 @@ void MainWindow::reflowGrid() {
             }
             saveCurrenciesSettings(currentCurrencies);
             widgets[newTicker]->setUnsupportedReason(""); widgets[currentTicker]->setUnsupportedReason("");
-            QMetaObject::invokeMethod(dataWorker, [this](){ dataWorker->setCurrencies(realSymbolsFrom(currentCurrencies)); }, Qt::QueuedConnection);
+            dataPool->setCurrencies(realSymbolsFrom(currentCurrencies));
             refreshCompareSubscriptions();
             reflowGrid();
         }, Qt::QueuedConnection); });
@@ -1074,7 +1253,7 @@ void MainWindow::reflowGrid() {
 
     // Persist the new list and update state
     currentCurrencies = newList; saveCurrenciesSettings(currentCurrencies);
-    if (dataWorker) QMetaObject::invokeMethod(dataWorker, [this](){ dataWorker->setCurrencies(realSymbolsFrom(currentCurrencies)); }, Qt::QueuedConnection);
+    if (dataPool) dataPool->setCurrencies(realSymbolsFrom(currentCurrencies));
     refreshCompareSubscriptions();
 
     // Rebuild layout grid with current list
@@ -1129,8 +1308,8 @@ MainWindow::PseudoKind MainWindow::classifyPseudo(const QString& name, DiffSpec*
 
 void MainWindow::connectRealWidgetSignals(const QString& symbol, DynamicSpeedometerCharts* w) {
     if (isPseudo(symbol)) return;
-    connect(w, &DynamicSpeedometerCharts::valueChanged, this, [this, symbol](double v){ normalizedBySymbol[symbol] = std::clamp(v, 0.0, 100.0); recomputePseudoTickers(); });
-    connect(w, &DynamicSpeedometerCharts::volatilityChanged, this, [this, symbol](double vol){ volBySymbol[symbol] = std::max(0.0, vol); });
+    const SymbolId id = SymbolRegistry::instance().intern(symbol);
+    connect(w, &DynamicSpeedometerCharts::volatilityChanged, this, [this, id](double vol){ volById[id] = std::max(0.0, vol); });
 }
 
 QStringList MainWindow::realSymbolsFrom(const QStringList& list) const {
@@ -1142,17 +1321,18 @@ QStringList MainWindow::realSymbolsFrom(const QStringList& list) const {
 void MainWindow::recomputePseudoTickers() {
     const auto now = QDateTime::currentMSecsSinceEpoch()/1000.0;
     // Pre-collect real normalized values
-    QVector<double> vals; vals.reserve(normalizedBySymbol.size());
-    for (auto it = normalizedBySymbol.begin(); it != normalizedBySymbol.end(); ++it) vals.push_back(it.value());
+    QVector<double> vals; vals.reserve(normalizedById.count());
+    normalizedById.forEach([&](SymbolId, double v){ vals.push_back(v); });
     std::sort(vals.begin(), vals.end());
     auto computeMedian = [&](){ if (vals.isEmpty()) return 0.0; int n=vals.size(); if (n%2==1) return double(vals[n/2]); else return 0.5*(vals[n/2-1]+vals[n/2]); };
     auto computeAvg = [&](){ if (vals.isEmpty()) return 0.0; double s=std::accumulate(vals.begin(), vals.end(), 0.0); return s/vals.size(); };
-    auto computeAltAvg = [&](){ QVector<double> v2; v2.reserve(vals.size()); for (auto it = normalizedBySymbol.begin(); it!=normalizedBySymbol.end(); ++it) if (it.key()!="BTC") v2.push_back(it.value()); if (v2.isEmpty()) return 0.0; double s=std::accumulate(v2.begin(), v2.end(), 0.0); return s/v2.size(); };
+    auto computeAltAvg = [&](){ QVector<double> v2; v2.reserve(vals.size()); normalizedById.forEach([&](SymbolId id, double x){ if (id!=btcId) v2.push_back(x); }); if (v2.isEmpty()) return 0.0; double s=std::accumulate(v2.begin(), v2.end(), 0.0); return s/v2.size(); };
     auto computeSpread = [&](){ if (vals.isEmpty()) return 0.0; return vals.last() - vals.first(); };
-    auto computeTop10Avg = [&](){ QVector<double> v; v.reserve(10); for (const auto& sym : TOP50.mid(0,10)) if (normalizedBySymbol.contains(sym)) v.push_back(normalizedBySymbol.value(sym)); if (v.isEmpty()) return 0.0; double s=std::accumulate(v.begin(), v.end(), 0.0); return s/v.size(); };
-    auto computeVolAvg = [&](){ if (volBySymbol.isEmpty()) return 0.0; double s=0.0; int n=0; for (auto it=volBySymbol.begin(); it!=volBySymbol.end(); ++it){ s+=it.value(); ++n; } return n? s/n : 0.0; };
+    static const QVector<SymbolId> top10Ids = [](){ QVector<SymbolId> ids; for (const auto& sym : TOP50.mid(0,10)) ids << SymbolRegistry::instance().intern(sym); return ids; }();
+    auto computeTop10Avg = [&](){ QVector<double> v; v.reserve(10); for (SymbolId id : top10Ids) if (normalizedById.contains(id)) v.push_back(normalizedById.value(id)); if (v.isEmpty()) return 0.0; double s=std::accumulate(v.begin(), v.end(), 0.0); return s/v.size(); };
+    auto computeVolAvg = [&](){ if (volById.isEmpty()) return 0.0; double s=0.0; int n=0; volById.forEach([&](SymbolId, double x){ s+=x; ++n; }); return n? s/n : 0.0; };
     auto computeBtcDom = [&](){ // dominance proxy: BTC value vs average of basket
-        double btc = normalizedBySymbol.value("BTC", 50.0); double avg = computeAvg(); if (avg<=0) return 100.0; double dom = btc/avg*100.0; return std::clamp(dom, 0.0, 200.0); };
+        double btc = normalizedById.value(btcId, 50.0); double avg = computeAvg(); if (avg<=0) return 100.0; double dom = btc/avg*100.0; return std::clamp(dom, 0.0, 200.0); };
 
     for (auto it = widgets.begin(); it != widgets.end(); ++it) {
         const QString& name = it.key(); auto* w = it.value(); DiffSpec ds; auto kind = classifyPseudo(name, &ds);
@@ -1173,7 +1353,7 @@ void MainWindow::recomputePseudoTickers() {
             case PseudoKind::ZScore: {
                 // Format: @Z_SCORE:SYMBOL
                 QString sym = name.mid(QString("@Z_SCORE:").length()).trimmed().toUpper();
-                double v = normalizedBySymbol.value(sym, 50.0);
+                double v = normalizedById.value(SymbolRegistry::instance().find(sym), 50.0);
                 // Use global basket stats as proxy
                 double mean = computeAvg(); double sd = 0.0; 
                 if (vals.size()>1) {
@@ -1186,8 +1366,9 @@ void MainWindow::recomputePseudoTickers() {
                 break; }
             case PseudoKind::Diff: {
                 if (!ds.valid) { agg = 0.0; w->setMarketBadge("Computed", "DIFF"); break; }
-                double b = binancePrice.value(ds.symbol, 0.0);
-                double y = (ds.market==BybitMarket::Linear? bybitLinearPrice.value(ds.symbol, 0.0) : bybitSpotPrice.value(ds.symbol, 0.0));
+                const SymbolId dsId = SymbolRegistry::instance().find(ds.symbol);
+                double b = binancePrice.value(dsId, 0.0);
+                double y = (ds.market==BybitMarket::Linear? bybitLinearPrice.value(dsId, 0.0) : bybitSpotPrice.value(dsId, 0.0));
                 double diffPct = 0.0; if (b>0 && y>0) diffPct = (y - b) / b * 100.0; // percent difference Bybit vs Binance
                 // Map percent diff to 0..100 center at 50 (=0%) with +/- 10% window → 0..100
                 double center=50.0; double scale=5.0; // 10% => 50 +/- 50 → scale=5 (since 10% * 5 = 50)
@@ -1198,7 +1379,7 @@ void MainWindow::recomputePseudoTickers() {
             default: break;
         }
         w->applyScaling({DynamicSpeedometerCharts::ScalingMode::Fixed, 0.0, 100.0});
-        w->updateData(agg, now, btcPrice);
+        TimeSeriesStore::instance().append(w->symbolId(), now, agg, w->historyTag()); w->updateData(agg, now);
     }
 }
 
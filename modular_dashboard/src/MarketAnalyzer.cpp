@@ -3,10 +3,13 @@
 #include <cmath>
 #include <algorithm>
 
-MarketAnalyzer::MarketAnalyzer(QObject* parent) : QObject(parent) {}
+MarketAnalyzer::MarketAnalyzer(QObject* parent) : QObject(parent) {
+    btcId = SymbolRegistry::instance().intern("BTC");
+}
 
 void MarketAnalyzer::setConfig(const Config& c) {
     cfg = c;
+    excludedIds.clear(); for (const QString& s : cfg.excluded) excludedIds.insert(SymbolRegistry::instance().intern(s.toUpper()));
     computeAndEmit();
 }
 
@@ -16,16 +19,20 @@ void MarketAnalyzer::reset() {
 }
 
 void MarketAnalyzer::updateSymbol(const QString& sym, double ts, double normalized01_100, double volatilityPct) {
-    QString key = sym.toUpper();
-    if (!cfg.includeBTC && key=="BTC") return;
-    if (cfg.excluded.contains(key)) return;
-    auto& s = series[key];
+    updateSymbol(SymbolRegistry::instance().intern(sym.toUpper()), ts, normalized01_100, volatilityPct);
+}
+
+void MarketAnalyzer::updateSymbol(SymbolId id, double ts, double normalized01_100, double volatilityPct) {
+    if (id == InvalidSymbol) return;
+    if (!cfg.includeBTC && id==btcId) return;
+    if (excludedIds.contains(id)) return;
+    auto& s = series[id];
     s.lastTs = ts; s.lastV = normalized01_100; s.lastVolatility = std::max(0.0, volatilityPct);
-    s.points.push_back({ts, normalized01_100});
+    s.points.push(ts, normalized01_100, 0, HistoryRing::Tag{});
     trimOld(s.points, ts, cfg.windowSeconds);
     // Update EMA of slope per series for uncertainty estimation
     if (s.points.size() >= 4) {
-        double slope = regressionSlope(s.points); // in units per second of normalized value
+        double slope = regressionSlope(s.points.view()); // in units per second of normalized value
         double alpha = 0.2; // responsiveness
         if (!s.seeded) { s.emaSlope = slope; s.emaVar = 0.0; s.seeded = true; }
         else {
@@ -39,23 +46,23 @@ void MarketAnalyzer::updateSymbol(const QString& sym, double ts, double normaliz
     computeAndEmit();
 }
 
-double MarketAnalyzer::regressionSlope(const std::deque<Sample>& pts) {
+double MarketAnalyzer::regressionSlope(const HistoryRing::View& pts) {
     int n = int(pts.size()); if (n < 2) return 0.0;
     // Normalize time to start at 0 to improve numeric stability
-    double t0 = pts.front().t;
+    double t0 = pts.frontTs();
     double sumT=0.0, sumV=0.0, sumTT=0.0, sumTV=0.0;
-    for (const auto& p : pts) {
-        double dt = p.t - t0; // seconds
-        sumT += dt; sumV += p.v; sumTT += dt*dt; sumTV += dt*p.v;
-    }
+    pts.forEach([&](double t, double v) {
+        double dt = t - t0; // seconds
+        sumT += dt; sumV += v; sumTT += dt*dt; sumTV += dt*v;
+    });
     double denom = n*sumTT - sumT*sumT; if (std::abs(denom) < 1e-9) return 0.0;
     double slope = (n*sumTV - sumT*sumV) / denom; // units per second
     // Convert to per-minute to be more interpretable
     return slope * 60.0;
 }
 
-void MarketAnalyzer::trimOld(std::deque<Sample>& pts, double now, int windowSec) {
-    while (!pts.empty() && (now - pts.front().t) > windowSec) pts.pop_front();
+void MarketAnalyzer::trimOld(HistoryRing& pts, double now, int windowSec) {
+    pts.popFront(pts.lowerBound(now - windowSec));
 }
 
 void MarketAnalyzer::computeAndEmit() {
@@ -66,10 +73,9 @@ void MarketAnalyzer::computeAndEmit() {
     int agreeCount = 0, total=0;
     double meanAbsSlope = 0.0;
     // Use center at 50 to estimate direction if few points
-    for (auto it = series.begin(); it != series.end(); ++it) {
-        const auto& s = it.value();
-        if (s.points.size() < 3) continue;
-        double slope = regressionSlope(s.points); // per minute
+    series.forEach([&](SymbolId, const Series& s) {
+        if (s.points.size() < 3) return;
+        double slope = regressionSlope(s.points.view()); // per minute
         double w = 1.0;
         if (cfg.weighting == Weighting::InverseVolatility) {
             // more weight to calmer assets
@@ -79,7 +85,7 @@ void MarketAnalyzer::computeAndEmit() {
         weightSum += w;
         meanAbsSlope += std::abs(slope);
         ++total;
-    }
+    });
     if (weightSum <= 0.0 || total==0) { emit snapshotUpdated({0.0,0.0,0.0, QObject::tr("недостаточно данных")}); return; }
     double aggSlope = weightedSlopeSum / weightSum; // per minute
     meanAbsSlope /= total;
@@ -88,17 +94,17 @@ void MarketAnalyzer::computeAndEmit() {
     double index = std::clamp(aggSlope / scale, -1.5, 1.5);
     index = std::clamp(index, -1.0, 1.0);
     // Consensus: count series whose sign matches aggregate
-    for (auto it = series.begin(); it != series.end(); ++it) {
-        const auto& s = it.value(); if (s.points.size()<3) continue;
-        double slope = regressionSlope(s.points);
+    series.forEach([&](SymbolId, const Series& s) {
+        if (s.points.size()<3) return;
+        double slope = regressionSlope(s.points.view());
         if ((aggSlope>=0 && slope>=0) || (aggSlope<0 && slope<0)) ++agreeCount;
-    }
+    });
     double consensus = double(agreeCount) / double(std::max(1,total));
     // Strength derived from meanAbsSlope
     double strength = std::clamp(meanAbsSlope/scale, 0.0, 1.0);
     // Confidence combines consensus and inverse dispersion via slope variance
     double disp = 0.0; int nvar=0;
-    for (auto it = series.begin(); it != series.end(); ++it) { if (it.value().seeded) { disp += it.value().emaVar; ++nvar; } }
+    series.forEach([&](SymbolId, const Series& s) { if (s.seeded) { disp += s.emaVar; ++nvar; } });
     double avgVar = (nvar>0? disp/nvar : 0.0);
     // Map variance to [0,1] low variance -> 1
     double varScore = 1.0 / (1.0 + avgVar*20.0);
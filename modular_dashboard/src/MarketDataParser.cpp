@@ -0,0 +1,242 @@
+#include "MarketDataParser.h"
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QVariant>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+
+template<typename Ch> inline unsigned code(Ch ch) { return static_cast<unsigned>(static_cast<std::make_unsigned_t<Ch>>(ch)); }
+
+template<typename Ch>
+struct Span {
+    const Ch* b = nullptr; const Ch* e = nullptr;
+    bool empty() const { return b == e; }
+    bool is(const char* lit) const {
+        const qsizetype n = qsizetype(std::strlen(lit)); if (e - b != n) return false;
+        for (qsizetype i=0; i<n; ++i) if (code(b[i]) != static_cast<unsigned char>(lit[i])) return false;
+        return true;
+    }
+};
+
+template<typename Ch>
+struct Cursor {
+    const Ch* p; const Ch* end;
+    void ws() { while (p < end && (*p==Ch(' ') || *p==Ch('\n') || *p==Ch('\r') || *p==Ch('\t'))) ++p; }
+    bool peek(char ch) { ws(); return p < end && *p == Ch(ch); }
+    bool eat(char ch) { if (!peek(ch)) return false; ++p; return true; }
+};
+
+template<typename Ch> inline bool isDelim(Ch ch) { return ch==Ch(',') || ch==Ch('}') || ch==Ch(']') || ch==Ch(' ') || ch==Ch('\n') || ch==Ch('\r') || ch==Ch('\t'); }
+
+// Strings are returned as raw spans between the quotes; escapes are skipped, never decoded (the fields we read never contain them)
+template<typename Ch>
+bool readString(Cursor<Ch>& c, Span<Ch>& s) {
+    if (!c.eat('"')) return false;
+    s.b = c.p;
+    while (c.p < c.end) {
+        if (*c.p == Ch('\\')) { if (c.p + 1 >= c.end) return false; c.p += 2; continue; } // a trailing backslash is truncated input
+        if (*c.p == Ch('"')) { s.e = c.p; ++c.p; return true; }
+        ++c.p;
+    }
+    return false;
+}
+
+template<typename Ch>
+bool skipValue(Cursor<Ch>& c) {
+    c.ws(); if (c.p >= c.end) return false;
+    if (*c.p == Ch('"')) { Span<Ch> s; return readString(c, s); }
+    if (*c.p == Ch('{') || *c.p == Ch('[')) {
+        int depth = 0;
+        while (c.p < c.end) {
+            const Ch ch = *c.p;
+            if (ch == Ch('"')) { Span<Ch> s; if (!readString(c, s)) return false; continue; }
+            if (ch == Ch('{') || ch == Ch('[')) ++depth;
+            else if (ch == Ch('}') || ch == Ch(']')) { if (--depth == 0) { ++c.p; return true; } }
+            ++c.p;
+        }
+        return false;
+    }
+    const Ch* b = c.p; while (c.p < c.end && !isDelim(*c.p)) ++c.p;
+    return c.p > b;
+}
+
+// Locale-independent decimal conversion; std::from_chars where the standard library provides the floating-point overload
+bool toDouble(const char* b, const char* e, double& out) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto r = std::from_chars(b, e, out); return r.ec == std::errc() && r.ptr == e;
+#else
+    bool neg = false; if (b < e && (*b=='-' || *b=='+')) { neg = (*b=='-'); ++b; }
+    quint64 mant = 0; int digits = 0, exp10 = 0; bool any = false;
+    for (; b < e && *b>='0' && *b<='9'; ++b) { any = true; if (digits < 19) { mant = mant*10 + quint64(*b-'0'); if (mant) ++digits; } else ++exp10; }
+    if (b < e && *b=='.') { ++b; for (; b < e && *b>='0' && *b<='9'; ++b) { any = true; if (digits < 19) { mant = mant*10 + quint64(*b-'0'); if (mant) ++digits; --exp10; } } }
+    if (!any) return false;
+    if (b < e && (*b=='e' || *b=='E')) {
+        ++b; bool eneg = false; if (b < e && (*b=='-' || *b=='+')) { eneg = (*b=='-'); ++b; }
+        int ev = 0; bool anyE = false; for (; b < e && *b>='0' && *b<='9'; ++b) { anyE = true; if (ev < 10000) ev = ev*10 + (*b-'0'); }
+        if (!anyE) return false; exp10 += eneg ? -ev : ev;
+    }
+    if (b != e) return false;
+    double v = double(mant); if (exp10 < 0) v /= std::pow(10.0, -exp10); else if (exp10 > 0) v *= std::pow(10.0, exp10);
+    out = neg ? -v : v; return true;
+#endif
+}
+
+// Numbers arrive either bare (123.4) or quoted ("123.4"); anything unparsable reads as 0 like jsonToDouble
+template<typename Ch>
+bool readNumber(Cursor<Ch>& c, double& out) {
+    Span<Ch> s; c.ws(); if (c.p >= c.end) return false;
+    if (*c.p == Ch('"')) { if (!readString(c, s)) return false; }
+    else { s.b = c.p; while (c.p < c.end && !isDelim(*c.p)) ++c.p; s.e = c.p; if (s.empty()) return false; }
+    char buf[64]; const qsizetype n = s.e - s.b; out = 0.0;
+    if (n <= 0 || n >= qsizetype(sizeof(buf))) return true;
+    for (qsizetype i=0; i<n; ++i) { const unsigned u = code(s.b[i]); if (u > 127) return true; buf[i] = char(u); }
+    double v = 0.0; if (toDouble(buf, buf + n, v)) out = v;
+    return true;
+}
+
+template<typename Ch, typename F>
+bool forEachMember(Cursor<Ch>& c, F&& onMember) {
+    if (!c.eat('{')) return false;
+    if (c.eat('}')) return true;
+    do {
+        Span<Ch> key; if (!readString(c, key) || !c.eat(':')) return false;
+        if (!onMember(key)) return false;
+    } while (c.eat(','));
+    return c.eat('}');
+}
+
+template<typename Ch, typename F>
+bool forEachElement(Cursor<Ch>& c, F&& onElement) {
+    if (!c.eat('[')) return false;
+    if (c.eat(']')) return true;
+    do { if (!onElement()) return false; } while (c.eat(','));
+    return c.eat(']');
+}
+
+template<typename Ch>
+bool setSymbol(MarketTick& out, const Span<Ch>& s) {
+    const qsizetype n = s.e - s.b; if (n <= 0 || n >= qsizetype(sizeof(out.symbol))) return false;
+    for (qsizetype i=0; i<n; ++i) { const unsigned u = code(s.b[i]); if (u > 127) return false; out.symbol[i] = char(u); }
+    out.symbol[n] = '\0'; out.symbolLen = int(n); return true;
+}
+
+template<typename Ch>
+MarketDataParser::Result scanBinance(Cursor<Ch> c, StreamMode mode, MarketTick& out) {
+    using R = MarketDataParser::Result;
+    const bool trade = (mode == StreamMode::Trade);
+    bool haveData = false; Span<Ch> sym; double ts = 0.0;
+    auto onData = [&](const Span<Ch>& k) -> bool {
+        if (k.is("s")) return readString(c, sym);
+        if (trade) { if (k.is("p")) return readNumber(c, out.price); if (k.is("T")) return readNumber(c, ts); if (k.is("q")) return readNumber(c, out.volIncr); }
+        else { if (k.is("c")) return readNumber(c, out.price); if (k.is("E")) return readNumber(c, ts); if (k.is("v")) return readNumber(c, out.volBase); if (k.is("q")) return readNumber(c, out.volQuote); }
+        return skipValue(c);
+    };
+    auto onRoot = [&](const Span<Ch>& k) -> bool {
+        if (!k.is("data")) return skipValue(c);
+        haveData = true; return c.peek('{') ? forEachMember(c, onData) : skipValue(c);
+    };
+    if (!forEachMember(c, onRoot) || !haveData) return R::Fallback;
+    if (sym.empty()) return R::Skip;
+    if (!setSymbol(out, sym)) return R::Fallback;
+    out.timestamp = ts / 1000.0;
+    return R::Tick;
+}
+
+template<typename Ch>
+MarketDataParser::Result scanBybit(Cursor<Ch> c, StreamMode mode, MarketTick& out) {
+    using R = MarketDataParser::Result;
+    const bool trade = (mode == StreamMode::Trade);
+    struct Entry { Span<Ch> symbol, s; double p=0, T=0, v=0, lastPrice=0, lp=0, ts=0, turnover=0, volume=0; bool hasLastPrice=false; } e;
+    bool haveData = false, sawOp = false; Span<Ch> topic; double rootTs = 0.0;
+    auto onEntry = [&](const Span<Ch>& k) -> bool {
+        if (k.is("symbol")) return readString(c, e.symbol);
+        if (k.is("s")) return readString(c, e.s);
+        if (trade) { if (k.is("p")) return readNumber(c, e.p); if (k.is("T")) return readNumber(c, e.T); if (k.is("v")) return readNumber(c, e.v); }
+        else {
+            if (k.is("lastPrice")) { e.hasLastPrice = true; return readNumber(c, e.lastPrice); }
+            if (k.is("lp")) return readNumber(c, e.lp);
+            if (k.is("ts")) return readNumber(c, e.ts);
+            if (k.is("turnover24h")) return readNumber(c, e.turnover);
+            if (k.is("volume24h")) return readNumber(c, e.volume);
+        }
+        return skipValue(c);
+    };
+    // Trade batches: every entry is folded (count, summed size "v", high/low); the last entry supplies price and time.
+    // Entries of one publicTrade frame share the topic's symbol. Ticker arrays keep the last entry.
+    int trades = 0; double open = 0, high = 0, low = 0, vol = 0;
+    auto fold = [&]() { if (!trade || e.p <= 0) return; if (trades++ == 0) open = high = low = e.p; else { high = std::max(high, e.p); low = std::min(low, e.p); } vol += e.v; };
+    auto onElement = [&]() -> bool { e = Entry{}; if (!(c.peek('{') ? forEachMember(c, onEntry) : skipValue(c))) return false; fold(); return true; };
+    auto onRoot = [&](const Span<Ch>& k) -> bool {
+        if (k.is("op")) { sawOp = true; return skipValue(c); }
+        if (k.is("topic")) return c.peek('"') ? readString(c, topic) : skipValue(c);
+        if (k.is("ts")) return readNumber(c, rootTs);
+        if (!k.is("data")) return skipValue(c);
+        haveData = true;
+        if (c.peek('[')) return forEachElement(c, onElement);
+        if (c.peek('{')) { if (!forEachMember(c, onEntry)) return false; fold(); return true; }
+        return skipValue(c);
+    };
+    if (!forEachMember(c, onRoot) || sawOp || !haveData) return R::Fallback;
+    Span<Ch> sym = !e.symbol.empty() ? e.symbol : e.s;
+    if (sym.empty() && !topic.empty()) { for (const Ch* p = topic.e; p > topic.b; --p) if (*(p-1) == Ch('.')) { sym.b = p; sym.e = topic.e; break; } }
+    if (sym.empty()) return R::Skip;
+    if (!setSymbol(out, sym)) return R::Fallback;
+    if (trade) { out.price = e.p; out.timestamp = e.T / 1000.0; out.volIncr = vol; if (trades > 1) { out.open = open; out.high = high; out.low = low; out.trades = trades; } }
+    else { out.price = e.hasLastPrice ? e.lastPrice : e.lp; out.timestamp = (rootTs > 0 ? rootTs : e.ts) / 1000.0; out.volBase = e.turnover; out.volQuote = e.volume; }
+    return R::Tick;
+}
+
+template<typename Ch>
+MarketDataParser::Result scanImpl(const Ch* b, const Ch* e, DataProvider provider, StreamMode mode, MarketTick& out) {
+    out = MarketTick{};
+    Cursor<Ch> c{b, e};
+    return (provider == DataProvider::Binance) ? scanBinance(c, mode, out) : scanBybit(c, mode, out);
+}
+
+double jsonToDouble(const QJsonValue& v) {
+    if (v.isDouble()) return v.toDouble();
+    if (v.isString()) return v.toString().toDouble();
+    if (v.isNull() || v.isUndefined()) return 0.0;
+    auto var = v.toVariant();
+    bool ok=false; double d = var.toString().toDouble(&ok); if (ok) return d;
+    return var.toDouble();
+}
+
+} // namespace
+
+MarketDataParser::Result MarketDataParser::scan(QByteArrayView utf8, DataProvider provider, StreamMode mode, MarketTick& out) {
+    return scanImpl(utf8.data(), utf8.data() + utf8.size(), provider, mode, out);
+}
+
+MarketDataParser::Result MarketDataParser::scan(QStringView text, DataProvider provider, StreamMode mode, MarketTick& out) {
+    return scanImpl(text.utf16(), text.utf16() + text.size(), provider, mode, out);
+}
+
+MarketDataParser::Result MarketDataParser::fromJson(const QJsonObject& root, DataProvider provider, StreamMode mode, MarketTick& out) {
+    out = MarketTick{};
+    double price=0.0, timestamp=0.0, volBase=0.0, volQuote=0.0, volIncr=0.0; QString symbol;
+    if (provider == DataProvider::Binance) {
+        if (!root.contains("data")) return Result::Skip; QJsonObject data = root["data"].toObject(); symbol = data.value("s").toString(); if (symbol.isEmpty()) return Result::Skip; if (mode==StreamMode::Trade) { price = jsonToDouble(data.value("p")); timestamp = jsonToDouble(data.value("T"))/1000.0; volIncr = jsonToDouble(data.value("q")); } else { price = jsonToDouble(data.value("c")); timestamp = jsonToDouble(data.value("E"))/1000.0; volBase = jsonToDouble(data.value("v")); volQuote = jsonToDouble(data.value("q")); }
+    } else {
+        QString topic = root.value("topic").toString(); QJsonValue dataVal = root.value("data"); QJsonArray arr; QJsonObject obj; if (dataVal.isArray()) arr = dataVal.toArray(); else if (dataVal.isObject()) obj = dataVal.toObject();
+        if (!arr.isEmpty()) obj = arr.last().toObject();
+        // Trade batches: fold every entry (see scanBybit)
+        if (mode==StreamMode::Trade) {
+            const QJsonArray entries = arr.isEmpty() ? QJsonArray{obj} : arr; int trades = 0;
+            for (const QJsonValue& v : entries) { const QJsonObject t = v.toObject(); const double p = jsonToDouble(t.value("p")); if (p <= 0) continue; if (trades++ == 0) out.open = out.high = out.low = p; else { out.high = std::max(out.high, p); out.low = std::min(out.low, p); } volIncr += jsonToDouble(t.value("v")); }
+            if (trades > 1) out.trades = trades; else out.open = out.high = out.low = 0.0;
+        }
+        if (!obj.isEmpty()) { symbol = obj.value("symbol").toString(); if (symbol.isEmpty()) symbol = obj.value("s").toString(); if (mode==StreamMode::Trade) { price = jsonToDouble(obj.value("p")); timestamp = jsonToDouble(obj.value("T"))/1000.0; } else { price = obj.contains("lastPrice") ? jsonToDouble(obj.value("lastPrice")) : jsonToDouble(obj.value("lp")); double tsRoot = jsonToDouble(root.value("ts")); double tsData = jsonToDouble(obj.value("ts")); timestamp = ((tsRoot>0? tsRoot : tsData))/1000.0; volBase = jsonToDouble(obj.value("turnover24h")); volQuote = jsonToDouble(obj.value("volume24h")); } }
+        if (symbol.isEmpty() && !topic.isEmpty()) { auto parts = topic.split('.'); if (parts.size()>=2) symbol = parts.last(); }
+        if (symbol.isEmpty()) return Result::Skip;
+    }
+    const QByteArray raw = symbol.toLatin1(); out.symbolLen = int(qMin<qsizetype>(raw.size(), qsizetype(sizeof(out.symbol)) - 1)); std::memcpy(out.symbol, raw.constData(), size_t(out.symbolLen)); out.symbol[out.symbolLen] = '\0';
+    out.price = price; out.timestamp = timestamp; out.volBase = volBase; out.volQuote = volQuote; out.volIncr = volIncr;
+    return Result::Tick;
+}
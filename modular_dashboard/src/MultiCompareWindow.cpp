@@ -1,4 +1,5 @@
 #include "MultiCompareWindow.h"
+#include "TimeSeriesStore.h"
 #include <QListWidget>
 #include <QComboBox>
 #include <QCheckBox>
@@ -161,13 +162,16 @@ void MultiCompareWindow::refreshChart() {
 
     // Determine global time window across selected
     double tMax = 0.0; double nowRef = 0.0;
-    QMap<QString, QVector<QPair<double,double>>> snaps;
+    // Views into TimeSeriesStore (no copies; the readers hold each symbol's read lock for this pass)
+    std::vector<TimeSeriesStore::Reader> readers; readers.reserve(size_t(sel.size()));
+    QMap<QString, HistoryRing::View> snaps;
     for (const auto& s : sel) {
-        if (!sources.contains(s) || !sources[s]) continue;
-        auto vec = sources[s]->historySnapshot();
-        if (vec.isEmpty()) continue;
+        const SymbolId id = SymbolRegistry::instance().find(s); if (id == InvalidSymbol) continue;
+        readers.push_back(TimeSeriesStore::instance().read(id));
+        const HistoryRing::View vec = readers.back().history().view();
+        if (vec.empty()) continue;
         snaps[s] = vec;
-        tMax = std::max(tMax, vec.back().first);
+        tMax = std::max(tMax, vec.backTs());
     }
     if (tMax <= 0.0) return;
     nowRef = tMax; double tMin = nowRef - windowSec;
@@ -187,21 +191,23 @@ void MultiCompareWindow::refreshChart() {
     // Effective step: if 'Auto', choose based on window to target ~2.5k points max
     int effectiveStep = (step <= 0 ? pickStep(windowSec) : step);
     // Helper to resample per step seconds using selected interpolation
-    auto resample = [&](const QString& key, const QVector<QPair<double,double>>& series) {
+    auto resample = [&](const QString& key, const HistoryRing::View& series) {
         QVector<QPointF> out; out.reserve(windowSec/effectiveStep + 4);
         // Apply lag offset if enabled
         double lag = lagOffsetBySource.value(key, 0.0);
-        int i=0; double lastV = NAN; double lastT = NAN;
+        // Binary-search the window start, keeping the last point before it as the as-of value at tMin
+        const size_t first = series.lowerBound(tMin - lag);
+        size_t i = first ? first - 1 : 0; double lastV = NAN; double lastT = NAN;
         const bool linear = (cmbInterp->currentData().toInt()==1);
         for (double t=tMin; t<=nowRef; t+=effectiveStep) {
             double tt = t - lag; // sample original series at shifted time
-            while (i < series.size() && series[i].first <= tt) { lastT = series[i].first; lastV = series[i].second; ++i; }
+            while (i < series.size() && series.ts(i) <= tt) { lastT = series.ts(i); lastV = series.value(i); ++i; }
             if (std::isnan(lastV)) continue; // no data yet
             double y = lastV;
             if (linear) {
                 // interpolate to next known point if exists and within step*2
                 if (i < series.size()) {
-                    double t2 = series[i].first; double v2 = series[i].second;
+                    double t2 = series.ts(i); double v2 = series.value(i);
                     if (t2 > lastT && std::isfinite(lastT)) {
                         double u = std::clamp((tt - lastT) / (t2 - lastT), 0.0, 1.0);
                         y = lastV + (v2 - lastV) * u;
@@ -0,0 +1,32 @@
+#include "NeedleModel.h"
+#include <algorithm>
+#include <cmath>
+
+void NeedleModel::setSettleMs(int ms) { omega = 6.64 / (std::max(10, ms) / 1000.0); }
+
+void NeedleModel::setTarget(double target, qint64 nowNs) {
+    advance(nowNs);
+    if (rest && target == tgt) return;
+    tgt = target; rest = false;
+}
+
+// Critically damped: e(t) = (e0 + (v0 + w e0) t) exp(-w t), v(t) = (v0 - w (v0 + w e0) t) exp(-w t), e = x - target
+void NeedleModel::solve(double w, double t, double& e, double& v) {
+    const double c = v + w * e, k = std::exp(-w * t);
+    e = (e + c * t) * k; v = (v - w * c * t) * k;
+}
+
+double NeedleModel::value(qint64 nowNs) const {
+    if (rest || nowNs <= t0) return x;
+    double e = x - tgt, v = vel; solve(omega, (nowNs - t0) / 1e9, e, v);
+    return tgt + e;
+}
+
+void NeedleModel::advance(qint64 nowNs) {
+    const qint64 dtNs = nowNs - t0;
+    if (dtNs <= 0) return;
+    t0 = nowNs;
+    if (rest) return;
+    double e = x - tgt; solve(omega, dtNs / 1e9, e, vel); x = tgt + e;
+    if (std::abs(e) < 1e-3 && std::abs(vel) < 1e-2) snap(tgt);
+}
@@ -0,0 +1,30 @@
+#include "RatioSeries.h"
+#include "TimePyramid.h"
+
+const HistoryRing& RatioSeries::sync(const HistoryRing& src, const Reference& btc, bool unit) {
+    if (!live || fed < src.firstIndex() || fed > src.endIndex()) { out.clear(); fed = src.firstIndex(); live = true; ++gen; }
+    if (out.capacity() != src.capacity()) out.setCapacity(src.capacity());
+    // Drop what the price history evicted (retention / capacity)
+    if (src.empty()) out.clear(); else out.popFront(out.lowerBound(src.frontTs()));
+    const size_t from = size_t(fed - src.firstIndex());
+    if (from < src.size()) {
+        const HistoryRing* raw = unit ? nullptr : btc.raw;
+        // Cursor into the BTC ring: both series are time-ordered, so the as-of lookup only moves forward
+        size_t k = (raw && !raw->empty()) ? raw->lowerBound(src.ts(from)) : 0; const size_t n = raw ? raw->size() : 0;
+        src.forEach(from, [&](double ts, double v){
+            double b = unit ? 1.0 : 0.0;
+            if (!unit) {
+                while (k < n && raw->ts(k) <= ts) ++k;
+                if (k > 0) b = raw->value(k - 1);
+                else if (btc.coarse) btc.coarse->closeAsOf(ts, b);
+            }
+            if (b > 0.0) out.push(ts, unit ? 1.0 : v / b, 0, HistoryRing::Tag{});
+        });
+    }
+    fed = src.endIndex();
+    return out;
+}
+
+void RatioSeries::release() {
+    out = HistoryRing(1); fed = 0; live = false; ++gen; // drops the arrays' memory (clear() keeps it)
+}
@@ -0,0 +1,48 @@
+#include "RollingVolatility.h"
+#include <algorithm>
+#include <cmath>
+
+void RollingVolatility::feed(const HistoryRing& h, quint64 i, double alpha) {
+    const quint64 first = h.firstIndex(); const double v = h.value(size_t(i - first));
+    switch (kind) {
+    case Kind::MeanAbsReturn:
+    case Kind::Ewma: {
+        if (i <= first || i <= validFrom) return; // needs the previous point inside the window
+        const double p = h.value(size_t(i - 1 - first)); const double r = p ? (v - p) / p : 0.0;
+        if (kind == Kind::MeanAbsReturn) { terms.push_back(Term{i - 1, std::abs(r)}); sum += std::abs(r); }
+        else { ewmaVar = ewmaN++ ? (1.0 - alpha) * ewmaVar + alpha * r * r : r * r; }
+        break; }
+    case Kind::Parkinson: {
+        double hi = v, lo = v;
+        auto r = std::lower_bound(ranges.begin(), ranges.end(), i, [](const Range& x, quint64 k){ return x.i < k; });
+        if (r != ranges.end() && r->i == i) { hi = std::max(hi, r->hi); lo = std::min(lo, r->lo); }
+        if (blockN == 0) { blockStart = i; blockHi = hi; blockLo = lo; }
+        else { blockHi = std::max(blockHi, hi); blockLo = std::min(blockLo, lo); }
+        if (++blockN == kBlock) {
+            const double lr = (blockLo > 0.0) ? std::log(blockHi / blockLo) : 0.0;
+            terms.push_back(Term{blockStart, lr * lr}); sum += lr * lr; blockN = 0;
+        }
+        break; }
+    }
+}
+
+double RollingVolatility::update(const HistoryRing& h, int window) {
+    if (h.size() < 2) { restart(); return 0.0; }
+    const quint64 hEnd = h.endIndex(), n = quint64(std::clamp<size_t>(size_t(std::max(2, window)), 2, h.size()));
+    const quint64 from = hEnd - n; const double alpha = 2.0 / (double(n) + 1.0);
+    while (!ranges.empty() && ranges.front().i < from) ranges.pop_front();
+    if (from < validFrom || end > hEnd) { restart(); validFrom = end = from; }
+    if (end < from) { end = from; validFrom = from; blockN = 0; }
+    if (validFrom < from) validFrom = from;
+    for (quint64 i = end; i < hEnd; ++i) feed(h, i, alpha);
+    end = hEnd;
+    while (!terms.empty() && terms.front().key < from) { sum -= terms.front().v; terms.pop_front(); ++evicted; }
+    // Re-sum now and then so add/subtract rounding cannot drift over long sessions
+    if (evicted >= 4096) { evicted = 0; sum = 0.0; for (const Term& t : terms) sum += t.v; }
+    switch (kind) {
+    case Kind::MeanAbsReturn: return terms.empty() ? 0.0 : sum / double(terms.size()) * 100.0;
+    case Kind::Ewma: return std::sqrt(ewmaVar) * 100.0;
+    case Kind::Parkinson: return terms.empty() ? 0.0 : std::sqrt(sum / (double(terms.size()) * 4.0 * std::log(2.0) * kBlock)) * 100.0;
+    }
+    return 0.0;
+}
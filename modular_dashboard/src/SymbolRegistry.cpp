@@ -0,0 +1,52 @@
+#include "SymbolRegistry.h"
+#include <algorithm>
+
+SymbolRegistry& SymbolRegistry::instance() { static SymbolRegistry r; return r; }
+
+SymbolId SymbolRegistry::intern(const QString& name) {
+    {
+        QReadLocker rl(&lock);
+        auto it = ids.constFind(name); if (it != ids.cend()) return it.value();
+    }
+    QWriteLocker wl(&lock);
+    auto it = ids.constFind(name); if (it != ids.cend()) return it.value();
+    const SymbolId id = SymbolId(names.size());
+    names.append(name); ids.insert(name, id);
+    return id;
+}
+
+SymbolId SymbolRegistry::find(const QString& name) const {
+    QReadLocker rl(&lock);
+    return ids.value(name, InvalidSymbol);
+}
+
+QString SymbolRegistry::name(SymbolId id) const {
+    QReadLocker rl(&lock);
+    return (id >= 0 && id < names.size()) ? names.at(id) : QString();
+}
+
+int SymbolRegistry::size() const {
+    QReadLocker rl(&lock);
+    return int(names.size());
+}
+
+void SymbolIndex::insert(const QString& raw, SymbolId id) {
+    const QByteArray key = raw.toLatin1().toUpper();
+    if (key.isEmpty() || key.size() >= qsizetype(sizeof(Slot::key))) return;
+    if (slots.empty() || size_t(used + 1) * 2 > slots.size()) rehash(std::max<size_t>(16, slots.size() * 2));
+    const size_t mask = slots.size() - 1;
+    for (size_t i = hash(key.constData(), int(key.size())) & mask; ; i = (i + 1) & mask) {
+        Slot& s = slots[i];
+        if (s.id == InvalidSymbol) { std::copy(key.cbegin(), key.cend(), s.key); s.len = int(key.size()); s.id = id; ++used; return; }
+        if (s.len == key.size() && equalsUpper(s.key, key.constData(), s.len)) { s.id = id; return; }
+    }
+}
+
+void SymbolIndex::rehash(size_t capacity) {
+    std::vector<Slot> old; old.swap(slots); slots.assign(capacity, Slot{}); used = 0;
+    const size_t mask = capacity - 1;
+    for (const Slot& o : old) {
+        if (o.id == InvalidSymbol) continue;
+        for (size_t i = hash(o.key, o.len) & mask; ; i = (i + 1) & mask) if (slots[i].id == InvalidSymbol) { slots[i] = o; ++used; break; }
+    }
+}
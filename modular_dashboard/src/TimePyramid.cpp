@@ -0,0 +1,76 @@
+#include "TimePyramid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double kSeconds[TimePyramid::kLevels] = { 1.0, 10.0, 60.0, 300.0 };
+constexpr int kCapacity[TimePyramid::kLevels] = { 3600, 2160, 2880, 2016 };
+}
+
+double TimePyramid::levelSeconds(int level) { return kSeconds[level]; }
+int TimePyramid::levelCapacity(int level) { return kCapacity[level]; }
+
+TimePyramid::Bucket* TimePyramid::find(int lvl, double ts) {
+    auto& l = levels[size_t(lvl)]; const double t0 = std::floor(ts / kSeconds[lvl]) * kSeconds[lvl];
+    if (!l.empty() && l.back().t0 == t0) return &l.back();
+    auto it = std::lower_bound(l.begin(), l.end(), t0, [](const Bucket& b, double t){ return b.t0 < t; });
+    return (it != l.end() && it->t0 == t0) ? &*it : nullptr;
+}
+
+void TimePyramid::add(double ts, const Ohlc& p) {
+    const double hi = std::max(p.high, p.close), lo = std::min(p.low, p.close);
+    for (int i=0; i<kLevels; ++i) {
+        auto& l = levels[size_t(i)]; const double t0 = std::floor(ts / kSeconds[i]) * kSeconds[i];
+        Bucket* b = (!l.empty() && l.back().t0 >= t0) ? find(i, ts) : nullptr;
+        if (!b) {
+            if (!l.empty() && l.back().t0 > t0) continue; // late tick for a bucket already dropped
+            Bucket nb; nb.t0 = t0; nb.open = p.open; nb.high = hi; nb.low = lo; l.push_back(nb); b = &l.back();
+            while (l.size() > size_t(kCapacity[i])) l.pop_front();
+        }
+        b->high = std::max(b->high, hi); b->low = std::min(b->low, lo); b->close = p.close; b->sum += p.close; ++b->count; b->trades += p.trades;
+    }
+}
+
+void TimePyramid::addVolume(double ts, double volume) {
+    if (volume <= 0.0) return;
+    for (int i=0; i<kLevels; ++i) if (Bucket* b = find(i, ts)) b->volume += volume;
+}
+
+int TimePyramid::pickLevel(double windowSec, int minPoints) {
+    for (int i=kLevels-1; i>=0; --i)
+        if (windowSec / kSeconds[i] >= minPoints && kCapacity[i] * kSeconds[i] >= windowSec) return i;
+    return -1;
+}
+
+void TimePyramid::sample(int lvl, double from, int group, int method, std::vector<double>& ts, std::vector<double>& out) const {
+    ts.clear(); out.clear();
+    const auto& l = levels[size_t(lvl)]; const double span = kSeconds[lvl] * std::max(1, group);
+    auto it = std::lower_bound(l.begin(), l.end(), std::floor(from / span) * span, [](const Bucket& b, double t){ return b.t0 < t; });
+    double g0 = 0.0, sum = 0.0, hi = 0.0, lo = 0.0, last = 0.0; quint64 n = 0; bool open = false;
+    auto flush = [&]{
+        if (!open) return;
+        if (method==3) { ts.push_back(g0); out.push_back(lo); ts.push_back(g0 + span / 2); out.push_back(hi); return; }
+        ts.push_back(g0); out.push_back(method==1 ? (n ? sum / double(n) : last) : method==2 ? hi : last);
+    };
+    for (; it != l.end(); ++it) {
+        const double g = std::floor(it->t0 / span) * span;
+        if (!open || g != g0) { flush(); open = true; g0 = g; sum = 0.0; n = 0; hi = it->high; lo = it->low; }
+        sum += it->sum; n += it->count; hi = std::max(hi, it->high); lo = std::min(lo, it->low); last = it->close;
+    }
+    flush();
+}
+
+bool TimePyramid::closeAsOf(double ts, double& close) const {
+    for (int i=0; i<kLevels; ++i) {
+        const auto& l = levels[size_t(i)]; const double end = ts - kSeconds[i]; // bucket ended by ts <=> t0 <= ts - seconds
+        if (l.empty() || l.front().t0 > end) continue;
+        auto it = std::upper_bound(l.begin(), l.end(), end, [](double t, const Bucket& b){ return t < b.t0; });
+        close = std::prev(it)->close; return true;
+    }
+    return false;
+}
+
+size_t TimePyramid::memoryBytes() const {
+    size_t n = 0; for (const auto& l : levels) n += l.size() * sizeof(Bucket);
+    return n;
+}
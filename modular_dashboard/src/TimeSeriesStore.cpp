@@ -0,0 +1,60 @@
+#include "TimeSeriesStore.h"
+
+TimeSeriesStore& TimeSeriesStore::instance() { static TimeSeriesStore s; return s; }
+
+const TimeSeriesStore::Series* TimeSeriesStore::find(SymbolId id) const {
+    return (id >= 0 && size_t(id) < slots.size() && slots[size_t(id)]) ? slots[size_t(id)].get() : nullptr;
+}
+
+TimeSeriesStore::Series* TimeSeriesStore::series(SymbolId id) {
+    if (id < 0) return nullptr;
+    if (const Series* s = find(id)) return const_cast<Series*>(s);
+    if (size_t(id) >= slots.size()) slots.resize(size_t(id) + 1);
+    if (!slots[size_t(id)]) slots[size_t(id)] = std::make_unique<Series>();
+    return slots[size_t(id)].get();
+}
+
+TimeSeriesStore::Reader TimeSeriesStore::read(SymbolId id) const {
+    const Series* s = find(id);
+    return Reader(s ? s : &none);
+}
+
+void TimeSeriesStore::append(SymbolId id, double ts, const TimePyramid::Ohlc& p, const HistoryRing::Tag& tag) {
+    Series* s = series(id); if (!s) return;
+    s->history.push(ts, p.close, ++s->seq, tag); // ring drops the oldest point beyond capacity
+    s->pyramid.add(ts, p);
+    s->history.popFront(s->history.lowerBound(ts - s->retentionSec));
+}
+
+void TimeSeriesStore::addVolume(SymbolId id, double ts, double volume) {
+    Series* s = series(id); if (!s) return;
+    s->pyramid.addVolume(ts, volume);
+}
+
+void TimeSeriesStore::replace(SymbolId id, const std::vector<Point>& pts) {
+    Series* s = series(id); if (!s) return;
+    s->history.clear(); s->pyramid.clear();
+    for (const Point& p : pts) { s->history.push(p.ts, p.value, p.seq, p.tag); s->pyramid.add(p.ts, p.value); s->seq = std::max(s->seq, p.seq); }
+}
+
+void TimeSeriesStore::setCapacity(SymbolId id, int points) {
+    Series* s = series(id); if (!s) return;
+    s->history.setCapacity(points);
+}
+
+void TimeSeriesStore::setRetention(SymbolId id, double seconds) {
+    Series* s = series(id); if (!s) return;
+    s->retentionSec = seconds;
+}
+
+QVector<SymbolId> TimeSeriesStore::symbols() const {
+    QVector<SymbolId> out;
+    for (size_t i=0; i<slots.size(); ++i) if (slots[i] && !slots[i]->history.empty()) out << SymbolId(i);
+    return out;
+}
+
+size_t TimeSeriesStore::memoryBytes() const {
+    size_t n = 0;
+    for (const auto& s : slots) if (s) n += s->history.memoryBytes() + s->pyramid.memoryBytes();
+    return n;
+}
@@ -0,0 +1,205 @@
+#include "SyntheticExchange.h"
+#include <QWebSocketServer>
+#include <QWebSocket>
+#include <QHostAddress>
+#include <QTimer>
+#include <QUrlQuery>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+static const QStringList WELL_KNOWN = {
+    "BTC","ETH","BNB","SOL","XRP","ADA","DOGE","TON","TRX","AVAX","SHIB","DOT","LINK","BCH","LTC","MATIC","NEAR","UNI","ETC","XLM",
+    "ATOM","HBAR","APT","ARB","OP","IMX","INJ","FIL","AAVE","SUI","LDO","RNDR","ICP","ALGO","VET","XTZ","FLOW","THETA","EGLD","MANA",
+    "SAND","AXS","GRT","FTM","KAS","TAO","LAYER","APTOS","PEPE","SEI","ONDO","ZRO","STRK"
+};
+
+SyntheticExchange::SyntheticExchange(const Config& c, QObject* parent) : QObject(parent), cfg(c), rng(c.seed) {
+    for (const QString& s : WELL_KNOWN) if (!indexOf.contains(s)) { indexOf.insert(s, int(names.size())); names << s; }
+    for (int i=0; names.size() < cfg.symbols; ++i) { const QString s = QString("SYN%1").arg(i, 4, 10, QChar('0')); indexOf.insert(s, int(names.size())); names << s; }
+    price.resize(names.size()); volume24h.resize(names.size()); turnover24h.resize(names.size());
+    for (int i=0; i<names.size(); ++i) { price[i] = 0.01 * std::pow(10.0, rng.bounded(6.0)); volume24h[i] = 1e5 + rng.bounded(1e7); turnover24h[i] = volume24h[i] * price[i]; }
+    server = new QWebSocketServer(QStringLiteral("synthetic_exchange"), QWebSocketServer::NonSecureMode, this);
+    connect(server, &QWebSocketServer::newConnection, this, &SyntheticExchange::onNewConnection);
+    tickTimer = new QTimer(this); tickTimer->setTimerType(Qt::PreciseTimer); tickTimer->setInterval(std::max(1, cfg.tickMs));
+    connect(tickTimer, &QTimer::timeout, this, &SyntheticExchange::step);
+    statsTimer = new QTimer(this); statsTimer->setInterval(5000);
+    connect(statsTimer, &QTimer::timeout, this, &SyntheticExchange::report);
+}
+
+SyntheticExchange::~SyntheticExchange() {
+    const QList<Client*> all = clients; clients.clear();
+    for (Client* c : all) { c->ws->disconnect(this); c->ws->abort(); delete c; } // sockets are children of the server
+}
+
+bool SyntheticExchange::listen() {
+    if (!server->listen(QHostAddress::Any, cfg.port)) return false;
+    clock.start(); statsClock.start(); lastStepNs = 0; tickTimer->start(); statsTimer->start();
+    qDebug() << "[SyntheticExchange] listening on ws://0.0.0.0:" << cfg.port << "," << names.size() << "symbols," << cfg.ratePerSymbol << "frames/s per topic";
+    return true;
+}
+
+QString SyntheticExchange::errorString() const { return server->errorString(); }
+
+void SyntheticExchange::onNewConnection() {
+    while (QWebSocket* ws = server->nextPendingConnection()) {
+        auto* c = new Client(); c->ws = ws; c->connId = QString("syn-%1").arg(++connSeq);
+        const QUrl url = ws->requestUrl(); const QString path = url.path();
+        if (path.startsWith("/v5/public/linear")) c->api = Api::BybitLinear;
+        else if (path.startsWith("/v5/public/spot")) c->api = Api::BybitSpot;
+        else if (path.startsWith("/stream") || path.startsWith("/ws")) c->api = Api::Binance;
+        else { qDebug() << "[SyntheticExchange] unknown path" << path << ", closing"; ws->close(QWebSocketProtocol::CloseCodePolicyViolated, "unknown path"); ws->deleteLater(); delete c; continue; }
+        if (c->api == Api::Binance) { const QString streams = QUrlQuery(url).queryItemValue("streams"); for (const QString& t : streams.split('/', Qt::SkipEmptyParts)) addTopic(c, t); }
+        clients << c;
+        connect(ws, &QWebSocket::textMessageReceived, this, [this,c](const QString& text){ onText(c, text); });
+        connect(ws, &QWebSocket::disconnected, this, [this,c](){ drop(c); });
+        qDebug() << "[SyntheticExchange] client" << c->connId << "connected:" << path << "," << c->topics.size() << "topics from URL";
+    }
+}
+
+void SyntheticExchange::drop(Client* c) {
+    if (!clients.removeOne(c)) return;
+    qDebug() << "[SyntheticExchange] client" << c->connId << "gone: sent" << c->sent << "dropped" << c->dropped;
+    c->ws->deleteLater(); delete c;
+}
+
+int SyntheticExchange::resolve(Api api, const QString& topic, bool* ticker) const {
+    QString sym;
+    if (api == Api::Binance) {
+        const int at = topic.indexOf('@'); if (at <= 0) return -1;
+        const QString kind = topic.mid(at + 1);
+        if (kind != "trade" && kind != "ticker") return -1;
+        *ticker = (kind == "ticker"); sym = topic.left(at).toUpper();
+    } else {
+        if (topic.startsWith("publicTrade.")) { *ticker = false; sym = topic.mid(12); }
+        else if (topic.startsWith("tickers.")) { *ticker = true; sym = topic.mid(8); }
+        else return -1;
+    }
+    if (!sym.endsWith("USDT")) return -1;
+    sym.chop(4);
+    if (cfg.rejected.contains(sym) || (api == Api::BybitLinear && cfg.spotOnly.contains(sym))) return -1;
+    return indexOf.value(sym, -1);
+}
+
+bool SyntheticExchange::addTopic(Client* c, const QString& topic) {
+    bool ticker = false; const int idx = resolve(c->api, topic, &ticker);
+    if (idx < 0) return false;
+    for (const Topic& t : std::as_const(c->topics)) if (t.name == topic) return true;
+    Topic t; t.name = topic; t.symbol = idx; t.ticker = ticker; t.due = rng.generateDouble(); // random phase: topics don't fire in lockstep
+    c->topics << t;
+    return true;
+}
+
+bool SyntheticExchange::removeTopic(Client* c, const QString& topic) {
+    const auto it = std::find_if(c->topics.begin(), c->topics.end(), [&](const Topic& t){ return t.name == topic; });
+    if (it == c->topics.end()) return false;
+    c->topics.erase(it);
+    return true;
+}
+
+void SyntheticExchange::onText(Client* c, const QString& text) {
+    QJsonParseError err; const QJsonDocument doc = QJsonDocument::fromJson(text.toUtf8(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (c->api == Api::Binance) c->ws->sendTextMessage(QStringLiteral(R"({"error":{"code":3,"msg":"Invalid JSON"}})"));
+        else c->ws->sendTextMessage(QString(R"({"success":false,"ret_msg":"Invalid JSON","conn_id":"%1","op":""})").arg(c->connId));
+        return;
+    }
+    if (c->api == Api::Binance) handleBinance(c, doc.object()); else handleBybit(c, doc.object());
+}
+
+// Binance accepts unknown stream names silently (they just never deliver), so only malformed requests get an error
+void SyntheticExchange::handleBinance(Client* c, const QJsonObject& o) {
+    const QString method = o.value("method").toString(); const qint64 id = o.value("id").toVariant().toLongLong();
+    QJsonObject reply; reply["id"] = id; reply["result"] = QJsonValue::Null;
+    if (method == "SUBSCRIBE" || method == "UNSUBSCRIBE") {
+        const bool sub = (method == "SUBSCRIBE");
+        for (const QJsonValue& v : o.value("params").toArray()) { if (sub) addTopic(c, v.toString()); else removeTopic(c, v.toString()); }
+    } else if (method == "LIST_SUBSCRIPTIONS") {
+        QJsonArray list; for (const Topic& t : std::as_const(c->topics)) list << t.name;
+        reply["result"] = list;
+    } else {
+        reply.remove("result"); reply["error"] = QJsonObject{{"code", 2}, {"msg", QString("Invalid request: unknown method '%1'").arg(method)}};
+    }
+    c->ws->sendTextMessage(QString::fromUtf8(QJsonDocument(reply).toJson(QJsonDocument::Compact)));
+}
+
+// Bybit: one failure ack per rejected topic (same text as the real feed), then one success ack if anything was accepted
+void SyntheticExchange::handleBybit(Client* c, const QJsonObject& o) {
+    const QString op = o.value("op").toString(); const QString reqId = o.value("req_id").toString();
+    auto ack = [&](bool ok, const QString& msg, const QString& ackOp){
+        QJsonObject a{{"success", ok}, {"ret_msg", msg}, {"conn_id", c->connId}, {"op", ackOp}}; if (!reqId.isEmpty()) a["req_id"] = reqId;
+        c->ws->sendTextMessage(QString::fromUtf8(QJsonDocument(a).toJson(QJsonDocument::Compact)));
+    };
+    if (op == "ping") { ack(true, "pong", "pong"); return; }
+    if (op == "subscribe" || op == "unsubscribe") {
+        const bool sub = (op == "subscribe"); int accepted = 0;
+        for (const QJsonValue& v : o.value("args").toArray()) {
+            const QString topic = v.toString();
+            if (sub ? addTopic(c, topic) : removeTopic(c, topic)) ++accepted;
+            else if (sub) ack(false, QString("Invalid symbol :[%1]").arg(topic), op);
+        }
+        if (accepted > 0 || !sub) ack(true, "", op);
+        return;
+    }
+    ack(false, QString("Invalid op: %1").arg(op), op);
+}
+
+void SyntheticExchange::emitFrame(Client* c, const Topic& t, qint64 nowMs) {
+    const int s = t.symbol;
+    price[s] *= 1.0 + (rng.generateDouble() - 0.5) * 1e-3;
+    const QString sym = names[s] + QStringLiteral("USDT"); const QString p = QString::number(price[s], 'f', price[s] < 1.0 ? 8 : 4);
+    QString text;
+    if (c->api == Api::Binance) {
+        if (t.ticker) {
+            volume24h[s] += rng.bounded(10.0); turnover24h[s] = volume24h[s] * price[s];
+            text = QString(R"({"stream":"%1","data":{"e":"24hrTicker","E":%2,"s":"%3","c":"%4","v":"%5","q":"%6"}})")
+                       .arg(t.name).arg(nowMs).arg(sym, p).arg(volume24h[s], 0, 'f', 2).arg(turnover24h[s], 0, 'f', 2);
+        } else {
+            text = QString(R"({"stream":"%1","data":{"e":"trade","E":%2,"s":"%3","t":%4,"p":"%5","q":"%6","T":%2,"m":%7,"M":true}})")
+                       .arg(t.name).arg(nowMs).arg(sym).arg(tradeId++).arg(p).arg(rng.bounded(5.0), 0, 'f', 4).arg(rng.bounded(2) ? QStringLiteral("true") : QStringLiteral("false"));
+        }
+    } else {
+        if (t.ticker) {
+            volume24h[s] += rng.bounded(10.0); turnover24h[s] = volume24h[s] * price[s];
+            text = QString(R"({"topic":"%1","type":"snapshot","data":{"symbol":"%2","lastPrice":"%3","volume24h":"%4","turnover24h":"%5"},"cs":%6,"ts":%7})")
+                       .arg(t.name, sym, p).arg(volume24h[s], 0, 'f', 2).arg(turnover24h[s], 0, 'f', 2).arg(tradeId++).arg(nowMs);
+        } else {
+            QStringList trades;
+            for (int i=0; i<std::max(1, cfg.tradesPerFrame); ++i) {
+                if (i > 0) price[s] *= 1.0 + (rng.generateDouble() - 0.5) * 2e-4;
+                trades << QString(R"({"T":%1,"s":"%2","S":"%3","v":"%4","p":"%5","L":"ZeroPlusTick","i":"%6","BT":false})")
+                              .arg(nowMs).arg(sym, rng.bounded(2) ? QStringLiteral("Buy") : QStringLiteral("Sell")).arg(rng.bounded(5.0), 0, 'f', 4)
+                              .arg(QString::number(price[s], 'f', price[s] < 1.0 ? 8 : 4)).arg(tradeId++);
+            }
+            text = QString(R"({"topic":"%1","type":"snapshot","ts":%2,"data":[%3]})").arg(t.name).arg(nowMs).arg(trades.join(','));
+        }
+    }
+    c->ws->sendTextMessage(text); ++c->sent; ++sentTotal; bytesTotal += quint64(text.size());
+}
+
+// Each topic accrues rate*dt frames per step; backlog is capped at one second so a stalled loop doesn't burst
+void SyntheticExchange::step() {
+    const qint64 ns = clock.nsecsElapsed(); const double dt = (ns - lastStepNs) / 1e9; lastStepNs = ns;
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    const double cap = std::max(1.0, cfg.ratePerSymbol);
+    for (Client* c : std::as_const(clients)) {
+        const bool lagging = c->ws->bytesToWrite() > cfg.maxPendingBytes;
+        for (Topic& t : c->topics) {
+            t.due = std::min(cap, t.due + cfg.ratePerSymbol * dt);
+            for (; t.due >= 1.0; t.due -= 1.0) { if (lagging) { ++c->dropped; ++droppedTotal; } else emitFrame(c, t, nowMs); }
+        }
+    }
+}
+
+void SyntheticExchange::report() {
+    const double secs = std::max(0.001, statsClock.restart() / 1000.0);
+    int topics = 0; qint64 pending = 0;
+    for (const Client* c : std::as_const(clients)) { topics += int(c->topics.size()); pending = std::max(pending, c->ws->bytesToWrite()); }
+    qDebug() << QString("[SyntheticExchange] %1 clients, %2 topics, %3 frames/s, %4 MB/s, max pending %5 KB, dropped %6")
+                    .arg(clients.size()).arg(topics).arg((sentTotal - sentAtReport) / secs, 0, 'f', 0)
+                    .arg((bytesTotal - bytesAtReport) / secs / 1e6, 0, 'f', 2).arg(pending / 1024).arg(droppedTotal);
+    sentAtReport = sentTotal; bytesAtReport = bytesTotal;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QRandomGenerator>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+class QWebSocketServer;
+class QWebSocket;
+class QTimer;
+
+// Local stand-in for the Binance combined-stream and Bybit v5 public WebSocket APIs, used to load-test the ingest path
+// (point the app at it with DataWorker::setBaseUrls / Tools menu). Plain ws:// only. Served paths:
+//   /stream[?streams=btcusdt@trade/...]  Binance: SUBSCRIBE / UNSUBSCRIBE / LIST_SUBSCRIPTIONS -> {"result":..,"id":N}
+//   /v5/public/linear, /v5/public/spot    Bybit: op subscribe / unsubscribe acks, op ping -> pong,
+//                                         unknown symbols -> {"success":false,"ret_msg":"Invalid symbol :[topic]"}
+// Every subscribed topic streams synthetic trades or tickers at ratePerSymbol; prices follow a seeded random walk.
+class SyntheticExchange : public QObject {
+    Q_OBJECT
+public:
+    struct Config {
+        quint16 port = 9443;
+        int symbols = 2000;          // universe: well-known tickers + SYN0000.. up to this many; anything else is invalid
+        double ratePerSymbol = 5.0;  // frames/s per subscribed topic
+        int tradesPerFrame = 1;      // Bybit publicTrade batch size (the real feed bundles bursts)
+        int tickMs = 5;              // generator cadence
+        QSet<QString> rejected;      // rejected on every market
+        QSet<QString> spotOnly;      // rejected on linear only (exercises the client's Spot fallback)
+        qint64 maxPendingBytes = 32ll << 20; // per connection; frames are dropped (and counted) while a client lags
+        quint32 seed = 42;
+    };
+    explicit SyntheticExchange(const Config& cfg, QObject* parent=nullptr);
+    ~SyntheticExchange() override;
+    bool listen();
+    QString errorString() const;
+private:
+    enum class Api { Binance, BybitLinear, BybitSpot };
+    struct Topic { QString name; int symbol = 0; bool ticker = false; double due = 0.0; };
+    struct Client { QWebSocket* ws = nullptr; Api api = Api::Binance; QString connId; QVector<Topic> topics; quint64 sent = 0, dropped = 0; };
+    void onNewConnection();
+    void onText(Client* c, const QString& text);
+    void handleBinance(Client* c, const QJsonObject& o);
+    void handleBybit(Client* c, const QJsonObject& o);
+    // Symbol index for a topic of the client's API, -1 when unknown / not listed on that market
+    int resolve(Api api, const QString& topic, bool* ticker) const;
+    bool addTopic(Client* c, const QString& topic);
+    bool removeTopic(Client* c, const QString& topic);
+    void step();
+    void report();
+    void emitFrame(Client* c, const Topic& t, qint64 nowMs);
+    void drop(Client* c);
+    Config cfg;
+    QWebSocketServer* server = nullptr; QTimer* tickTimer = nullptr; QTimer* statsTimer = nullptr;
+    QList<Client*> clients;
+    QStringList names; QHash<QString,int> indexOf; QVector<double> price, volume24h, turnover24h;
+    QRandomGenerator rng; QElapsedTimer clock, statsClock; qint64 lastStepNs = 0;
+    quint64 tradeId = 1, connSeq = 0, sentTotal = 0, bytesTotal = 0, droppedTotal = 0, sentAtReport = 0, bytesAtReport = 0;
+};
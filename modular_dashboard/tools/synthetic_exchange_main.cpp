@@ -0,0 +1,34 @@
+#include "SyntheticExchange.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <algorithm>
+
+// Usage: synthetic_exchange [--port 9443] [--symbols 2000] [--rate 5] [--trades-per-frame 1] [--reject A,B] [--spot-only TAO]
+// Then in the app: Tools → "Адрес биржи (тест)..." → ws://127.0.0.1:9443 (serves both providers)
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("synthetic_exchange");
+    QCommandLineParser p; p.setApplicationDescription("Synthetic Binance/Bybit public WebSocket feed for load tests"); p.addHelpOption();
+    const QCommandLineOption port("port", "Listen port", "port", "9443");
+    const QCommandLineOption symbols("symbols", "Symbol universe size (known tickers + SYN0000..)", "n", "2000");
+    const QCommandLineOption rate("rate", "Frames per second per subscribed topic", "hz", "5");
+    const QCommandLineOption batch("trades-per-frame", "Trades per Bybit publicTrade frame", "n", "1");
+    const QCommandLineOption tick("tick-ms", "Generator cadence", "ms", "5");
+    const QCommandLineOption reject("reject", "Comma-separated symbols rejected on every market", "list");
+    const QCommandLineOption spotOnly("spot-only", "Comma-separated symbols rejected on Bybit linear only", "list");
+    const QCommandLineOption seed("seed", "Random seed", "n", "42");
+    p.addOptions({port, symbols, rate, batch, tick, reject, spotOnly, seed});
+    p.process(app);
+
+    auto toSet = [](const QString& s){ QSet<QString> out; for (const QString& x : s.split(',', Qt::SkipEmptyParts)) out.insert(x.trimmed().toUpper()); return out; };
+    SyntheticExchange::Config cfg;
+    cfg.port = quint16(p.value(port).toUInt()); cfg.symbols = std::max(1, p.value(symbols).toInt());
+    cfg.ratePerSymbol = std::max(0.0, p.value(rate).toDouble()); cfg.tradesPerFrame = std::max(1, p.value(batch).toInt());
+    cfg.tickMs = std::max(1, p.value(tick).toInt()); cfg.seed = p.value(seed).toUInt();
+    cfg.rejected = toSet(p.value(reject)); cfg.spotOnly = toSet(p.value(spotOnly));
+
+    SyntheticExchange ex(cfg);
+    if (!ex.listen()) { qCritical() << "[synthetic_exchange] cannot listen on port" << cfg.port << ":" << ex.errorString(); return 1; }
+    return app.exec();
+}